@@ -7,6 +7,9 @@ pacman -S $@ --needed \
   glfw      \
   file      \
   mbedtls   \
+  zlib      \
+  xz        \
+  zstd      \
   python3   \
   freetype2 \
   dbus      \
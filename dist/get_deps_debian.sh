@@ -19,6 +19,9 @@ apt install -y \
   libglm-dev            \
   libmagic-dev          \
   libmbedtls-dev        \
+  zlib1g-dev            \
+  liblzma-dev           \
+  libzstd-dev           \
   python3-dev           \
   libfreetype-dev       \
   libdbus-1-dev         \
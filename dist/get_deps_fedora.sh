@@ -11,4 +11,7 @@ dnf install -y      \
   glfw-devel        \
   lld               \
   mbedtls-devel     \
+  zlib-devel        \
+  xz-devel          \
+  libzstd-devel     \
   python3-devel
@@ -9,6 +9,9 @@ pacman -S --needed --noconfirm  \
   mingw-w64-x86_64-glfw         \
   mingw-w64-x86_64-file         \
   mingw-w64-x86_64-mbedtls      \
+  mingw-w64-x86_64-zlib         \
+  mingw-w64-x86_64-xz           \
+  mingw-w64-x86_64-zstd         \
   mingw-w64-x86_64-python       \
   mingw-w64-x86_64-freetype     \
   mingw-w64-x86_64-dlfcn
@@ -22,6 +22,9 @@ BuildRequires:  json-devel
 BuildRequires:  libcurl-devel
 BuildRequires:  llvm-devel
 BuildRequires:  mbedtls-devel
+BuildRequires:  zlib-devel
+BuildRequires:  xz-devel
+BuildRequires:  libzstd-devel
 BuildRequires:  python3-devel
 %if 0%{?fedora} >= 37
 BuildRequires:  yara-devel
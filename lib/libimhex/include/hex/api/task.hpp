@@ -27,6 +27,7 @@ namespace hex {
         ~Task();
 
         void update(u64 value = 0);
+        void increment(u64 value = 1);
         void setMaxValue(u64 value);
 
         [[nodiscard]] bool isBackgroundTask() const;
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <hex/helpers/byte_class.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <vector>
+
+namespace hex {
+
+    // Aho-Corasick automaton that finds any number of byte sequences in a single pass over the data.
+    // States close to the root get a full transition table, deeper ones of large sets fall back to following failure links
+    class AhoCorasick {
+    public:
+        using State = u32;
+        constexpr static State Root = 0;
+
+        AhoCorasick() : AhoCorasick(std::vector<std::vector<u8>> { }) { }
+        explicit AhoCorasick(const std::vector<std::vector<u8>> &needles);
+
+        [[nodiscard]] size_t getNeedleCount() const { return this->m_needleLengths.size(); }
+        [[nodiscard]] size_t getNeedleLength(u32 needle) const { return this->m_needleLengths[needle]; }
+        [[nodiscard]] size_t getMaxNeedleLength() const { return this->m_maxNeedleLength; }
+        [[nodiscard]] size_t getStateCount() const { return this->m_failureLinks.size(); }
+
+        // Feeds data through the automaton and returns the state to continue with in the next call.
+        // callback(needle, offset) is called for every needle that ends at data[offset]. Empty needles are never reported,
+        // identical needles are only reported under the index of the first one
+        template<typename Callback>
+        State search(State state, const u8 *data, size_t size, Callback &&callback) const {
+            size_t offset = 0;
+            while (offset < size) {
+                // Skip ahead to the next byte that can start a needle
+                if (state == Root && this->m_prefilter) {
+                    const size_t blockSize = std::min<size_t>(ByteClass::BlockSize, size - offset);
+
+                    u64 starts, zeros;
+                    this->m_firstBytes.classify(data + offset, blockSize, starts, zeros);
+                    if (starts == 0) {
+                        offset += blockSize;
+                        continue;
+                    }
+
+                    offset += std::countr_zero(starts);
+                }
+
+                state = this->step(state, data[offset]);
+
+                for (State match = this->m_matches[state]; match != NoState; match = this->m_dictionaryLinks[match])
+                    callback(this->m_needles[match], offset);
+
+                offset++;
+            }
+
+            return state;
+        }
+
+    private:
+        constexpr static State NoState = std::numeric_limits<State>::max();
+        constexpr static u32 NoNeedle  = std::numeric_limits<u32>::max();
+
+        [[nodiscard]] State step(State state, u8 byte) const {
+            while (true) {
+                if (state < this->m_tableStateCount)
+                    return this->m_transitions[size_t(state) * this->m_alphabetSize + this->m_alphabet[byte]];
+
+                const auto begin = this->m_edgeBytes.begin() + this->m_edgeOffsets[state];
+                const auto end   = this->m_edgeBytes.begin() + this->m_edgeOffsets[state + 1];
+
+                const auto edge = std::lower_bound(begin, end, byte);
+                if (edge != end && *edge == byte)
+                    return this->m_edgeTargets[edge - this->m_edgeBytes.begin()];
+
+                state = this->m_failureLinks[state];
+            }
+        }
+
+        std::vector<size_t> m_needleLengths;
+        size_t m_maxNeedleLength = 0;
+
+        // Children of every state, sorted by their byte
+        std::vector<u32> m_edgeOffsets;
+        std::vector<u8> m_edgeBytes;
+        std::vector<State> m_edgeTargets;
+
+        std::vector<State> m_failureLinks;
+
+        // Needle that ends in a state, the closest state on its failure chain where a needle ends, and the first state to report
+        std::vector<u32> m_needles;
+        std::vector<State> m_dictionaryLinks, m_matches;
+
+        // Transition table of the first states. Bytes that don't appear in any needle all share the same column
+        std::array<u8, 256> m_alphabet = { };
+        size_t m_alphabetSize = 1;
+        size_t m_tableStateCount = 0;
+        std::vector<State> m_transitions;
+
+        ByteClass m_firstBytes;
+        bool m_prefilter = false;
+    };
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <array>
+
+namespace hex {
+
+    // Set of byte values that's compiled into a vectorized classifier. Sets made up of a few contiguous ranges,
+    // like the characters that may appear in a string, are checked with SIMD range compares instead of table lookups
+    class ByteClass {
+    public:
+        constexpr static size_t BlockSize = 64;
+
+        ByteClass() : ByteClass(std::array<bool, 256> { }) { }
+        explicit ByteClass(const std::array<bool, 256> &table);
+
+        [[nodiscard]] bool contains(u8 byte) const { return this->m_table[byte]; }
+        [[nodiscard]] const std::array<bool, 256> &getTable() const { return this->m_table; }
+
+        // False if the set is made up of too many ranges to be checked with vector instructions
+        [[nodiscard]] bool isVectorized() const { return this->m_vectorizable; }
+
+        // Classifies up to BlockSize bytes. Bit i of members is set if data[i] is part of the class and bit i of zeros if data[i] is 0x00.
+        // Bits past the end of the data are cleared
+        void classify(const u8 *data, size_t size, u64 &members, u64 &zeros) const;
+
+    private:
+        constexpr static size_t MaxRanges = 8;
+
+        std::array<bool, 256> m_table;
+
+        // Ranges are stored as their first byte and their number of bytes minus one
+        std::array<u8, MaxRanges> m_rangeStarts = { }, m_rangeLengths = { };
+        size_t m_rangeCount = 0;
+        bool m_vectorizable = false;
+    };
+
+}
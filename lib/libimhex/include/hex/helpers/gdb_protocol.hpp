@@ -0,0 +1,33 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hex::gdb {
+
+    // Format of the replies to memory reads
+    enum class BinaryRead {
+        Unsupported,    // Reply to an 'm' packet holding the data as hex characters
+        Raw,            // Reply only contains the escaped data
+        Prefixed        // Reply is prefixed with a 'b' as sent by gdbserver
+    };
+
+    [[nodiscard]] u8 calculateChecksum(std::string_view data);
+    [[nodiscard]] std::string createPacket(const std::string &data);
+
+    [[nodiscard]] bool needsEscaping(u8 byte);
+
+    // Expands run-length encoded characters and removes the escaping of binary data
+    [[nodiscard]] std::string decodePayload(std::string_view payload);
+
+    [[nodiscard]] bool isErrorReply(const std::string &reply);
+
+    // Returns at most size bytes of data, or nothing if the reply is empty or an error. Raw replies that look like an
+    // error are reported as errors as well, even though they might be data. Those need to be read again using an 'm' packet
+    [[nodiscard]] std::optional<std::vector<u8>> parseReadReply(BinaryRead format, const std::string &reply, size_t size);
+
+}
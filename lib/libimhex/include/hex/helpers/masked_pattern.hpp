@@ -0,0 +1,84 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <bit>
+#include <vector>
+
+namespace hex {
+
+    // Byte pattern where every byte only has to match under a mask, like the wildcard signatures "48 8B ?? ?? 89" or "6? 00".
+    // Positions are found by comparing a few selected bytes of 64 positions at once with vector instructions
+    class MaskedPattern {
+    public:
+        constexpr static size_t BlockSize = 64;
+
+        struct Byte {
+            u8 mask, value;
+        };
+
+        MaskedPattern() : MaskedPattern(std::vector<Byte> { }) { }
+        explicit MaskedPattern(const std::vector<Byte> &pattern);
+
+        [[nodiscard]] size_t getSize() const { return this->m_pattern.size(); }
+
+        // Longest run of bytes without any wildcard bits. Its size is zero if there is none
+        [[nodiscard]] size_t getAnchorOffset() const { return this->m_anchorOffset; }
+        [[nodiscard]] size_t getAnchorSize() const { return this->m_anchorSize; }
+
+        // Checks getSize() bytes starting at data against the pattern
+        [[nodiscard]] bool matches(const u8 *data) const {
+            for (size_t i = 0; i < this->m_pattern.size(); i++) {
+                if ((data[i] & this->m_pattern[i].mask) != this->m_pattern[i].value)
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Calls callback(offset) in ascending order for every offset the pattern matches at and that lies fully inside the data
+        template<typename Callback>
+        void search(const u8 *data, size_t size, Callback &&callback) const {
+            if (this->m_pattern.empty() || size < this->m_pattern.size())
+                return;
+
+            const size_t positions = size - this->m_pattern.size() + 1;
+
+            size_t position = 0;
+            for (; position + BlockSize <= positions; position += BlockSize) {
+                u64 candidates = this->filter(data + position);
+
+                while (candidates != 0) {
+                    const auto offset = position + std::countr_zero(candidates);
+                    candidates &= candidates - 1;
+
+                    if (!this->m_verify || this->matches(data + offset))
+                        callback(offset);
+                }
+            }
+
+            for (; position < positions; position++) {
+                if (this->matches(data + position))
+                    callback(position);
+            }
+        }
+
+    private:
+        struct Filter {
+            u32 offset;
+            u8 mask, value;
+        };
+
+        // Bit i of the result is set if the bytes selected by the filters match for the position at data[i]
+        [[nodiscard]] u64 filter(const u8 *data) const;
+
+        std::vector<Byte> m_pattern;
+        std::vector<Filter> m_filters;
+
+        size_t m_anchorOffset = 0, m_anchorSize = 0;
+
+        // False if the filters already cover every byte of the pattern that isn't a full wildcard
+        bool m_verify = false;
+    };
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <span>
+
+namespace hex::process {
+
+    // A range of another process' memory and where to copy it to
+    struct Transfer {
+        u64 address;
+        u8 *buffer;
+        size_t size;
+    };
+
+    // Reads all transfers with as few system calls as possible. Transfers that can't be read in one go, e.g. because some of
+    // their pages are unmapped or guard pages, are read again page by page. Bytes that can't be read at all are left untouched
+    void readMemory(u32 processId, std::span<const Transfer> transfers);
+
+    // Reads a single transfer page by page, starting at the given offset into it
+    void readMemoryPages(u32 processId, const Transfer &transfer, u64 start = 0);
+
+}
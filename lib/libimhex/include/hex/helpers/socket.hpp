@@ -2,6 +2,7 @@
 
 #include <hex.hpp>
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,10 @@ namespace hex {
         void connect(const std::string &address, u16 port);
         void disconnect();
 
+        // Stops all communication and wakes up threads that are blocked on the socket, but keeps the descriptor open until disconnect is called.
+        // Unlike disconnect this is safe to call while other threads are still using the socket
+        void shutdown();
+
         [[nodiscard]] bool isConnected() const;
 
         [[nodiscard]] std::string readString(size_t size = 0x1000) const;
@@ -44,7 +49,7 @@ namespace hex {
         void writeBytes(const std::vector<u8> &bytes) const;
 
     private:
-        bool m_connected = false;
+        std::atomic<bool> m_connected = false;
 #if defined(OS_WINDOWS)
         SOCKET m_socket = SOCKET_NONE;
 #else
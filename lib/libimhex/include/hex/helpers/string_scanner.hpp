@@ -0,0 +1,250 @@
+#pragma once
+
+#include <hex.hpp>
+#include <hex/helpers/byte_class.hpp>
+
+#include <bit>
+
+namespace hex {
+
+    // Finds strings made up of fixed width units that hold the character in one byte and zeros in all others.
+    // ASCII, UTF-16 and UTF-32 only differ in the width of a unit and in which of its bytes holds the character.
+    // Two valid units can never partially overlap, so every string is a chain of valid units that directly follow each other
+    class UnitStringScanner {
+    public:
+        UnitStringScanner(size_t width, size_t characterByte, size_t minLength, bool nullTermination)
+            : m_width(width), m_characterByte(characterByte), m_minLength(minLength), m_nullTermination(nullTermination) { }
+
+        // Blocks are processed one block late so units that continue into the next block can be checked as a whole
+        template<typename Callback>
+        void feed(u64 blockAddress, size_t blockSize, u64 members, u64 zeros, Callback &&found) {
+            if (this->m_pendingSize > 0)
+                this->process(members, zeros, found);
+
+            this->m_pendingAddress = blockAddress;
+            this->m_pendingSize    = blockSize;
+            this->m_pendingMembers = members;
+            this->m_pendingZeros   = zeros;
+        }
+
+        template<typename Callback>
+        void flush(Callback &&found) {
+            if (this->m_pendingSize > 0)
+                this->process(0, 0, found);
+
+            this->m_pendingSize = 0;
+            this->report(!this->m_nullTermination, found);
+        }
+
+        // Whether a string that starts inside of the given region could still be found
+        [[nodiscard]] bool hasOpenString(Region region) const {
+            return (this->m_unitCount > 0 && region.overlaps({ this->m_startAddress, 1 })) ||
+                   (this->m_pendingSize > 0 && this->m_pendingAddress <= region.getEndAddress());
+        }
+
+    private:
+        // Selects every byte of a block whose offset modulo the unit width equals the given remainder
+        constexpr static u64 unitMask(size_t width, size_t remainder) {
+            switch (width) {
+                case 1:  return ~u64(0);
+                case 2:  return u64(0x5555'5555'5555'5555) << remainder;
+                default: return u64(0x1111'1111'1111'1111) << remainder;
+            }
+        }
+
+        template<typename Callback>
+        void process(u64 nextMembers, u64 nextZeros, Callback &&found) {
+            const u64 blockAddress = this->m_pendingAddress;
+            const size_t blockSize = this->m_pendingSize;
+
+            // Only full blocks are directly followed by the next one
+            if (blockSize < ByteClass::BlockSize) {
+                nextMembers = 0;
+                nextZeros   = 0;
+            }
+
+            // Moves the bits of the following block in from the top
+            auto shift = [](u64 current, u64 next, size_t count) {
+                return count == 0 ? current : (current >> count) | (next << (64 - count));
+            };
+
+            // Bit i of units is set if a valid unit starts at byte i, bit i of nullUnits if a unit made up of zeros does
+            u64 units = ~u64(0), nullUnits = ~u64(0);
+            for (size_t i = 0; i < this->m_width; i++) {
+                if (i == this->m_characterByte)
+                    units &= shift(this->m_pendingMembers, nextMembers, i);
+                else
+                    units &= shift(this->m_pendingZeros, nextZeros, i);
+
+                nullUnits &= shift(this->m_pendingZeros, nextZeros, i);
+            }
+
+            size_t position = this->m_unitCount > 0 ? this->m_chainOffset : 0;
+            while (position < blockSize) {
+                if (this->m_unitCount == 0) {
+                    const u64 nextStart = units & (~u64(0) << position);
+                    if (nextStart == 0)
+                        break;
+
+                    position = std::countr_zero(nextStart);
+                    this->m_startAddress = blockAddress + position;
+                }
+
+                const u64 chain = unitMask(this->m_width, position % this->m_width) & (~u64(0) << position);
+                const u64 invalidUnits = chain & ~units;
+                if (invalidUnits == 0) {
+                    // The chain continues in the next block at the same offset within a unit
+                    this->m_unitCount  += (ByteClass::BlockSize - position + this->m_width - 1) / this->m_width;
+                    this->m_chainOffset = position % this->m_width;
+                    break;
+                }
+
+                const size_t end = std::countr_zero(invalidUnits);
+                this->m_unitCount += (end - position) / this->m_width;
+                this->report(!this->m_nullTermination || (nullUnits & (u64(1) << end)) != 0, found);
+
+                position = end;
+            }
+        }
+
+        template<typename Callback>
+        void report(bool terminated, Callback &&found) {
+            if (terminated && this->m_unitCount > 0 && this->m_unitCount >= this->m_minLength)
+                found(Region { this->m_startAddress, this->m_unitCount * this->m_width });
+
+            this->m_unitCount = 0;
+        }
+
+        size_t m_width, m_characterByte;
+        size_t m_minLength;
+        bool m_nullTermination;
+
+        u64 m_pendingAddress = 0;
+        size_t m_pendingSize = 0;
+        u64 m_pendingMembers = 0, m_pendingZeros = 0;
+
+        u64 m_startAddress = 0;
+        size_t m_unitCount = 0, m_chainOffset = 0;
+    };
+
+    // Finds runs of valid UTF-8. Single byte characters are limited to the selected ones, multibyte sequences are
+    // validated byte by byte and rejected if they are overlong, encode a surrogate or lie past U+10FFFF
+    class UTF8StringScanner {
+    public:
+        UTF8StringScanner(size_t minLength, bool nullTermination) : m_minLength(minLength), m_nullTermination(nullTermination) { }
+
+        template<typename Callback>
+        void feed(const u8 *data, u64 blockAddress, size_t blockSize, u64 members, u64 zeros, u64 leads, Callback &&found) {
+            size_t position = 0;
+            while (position < blockSize) {
+                // Continuation bytes of a multibyte sequence, which might have started in an earlier block
+                if (this->m_pendingBytes > 0) {
+                    const u8 byte = data[position];
+                    if (byte < this->m_lowerBound || byte > this->m_upperBound) {
+                        // Broken sequences end the string right before their lead byte
+                        this->m_byteCount = this->m_sequenceStart;
+                        this->m_pendingBytes = 0;
+                        this->report(!this->m_nullTermination, found);
+                        continue;
+                    }
+
+                    this->m_lowerBound = 0x80;
+                    this->m_upperBound = 0xBF;
+                    this->m_byteCount++;
+                    this->m_pendingBytes--;
+                    if (this->m_pendingBytes == 0) {
+                        this->m_characterCount++;
+                        this->m_multibyte = true;
+                    }
+
+                    position++;
+                    continue;
+                }
+
+                if (this->m_byteCount == 0) {
+                    const u64 nextStart = (members | leads) & (~u64(0) << position);
+                    if (nextStart == 0)
+                        break;
+
+                    position = std::countr_zero(nextStart);
+                    this->m_startAddress = blockAddress + position;
+                }
+
+                // Single byte characters are consumed a whole run at a time
+                const u64 nonMembers = ~members & (~u64(0) << position);
+                const size_t end = nonMembers == 0 ? ByteClass::BlockSize : std::countr_zero(nonMembers);
+                if (end >= blockSize) {
+                    this->m_byteCount      += blockSize - position;
+                    this->m_characterCount += blockSize - position;
+                    break;
+                }
+
+                this->m_byteCount      += end - position;
+                this->m_characterCount += end - position;
+                position = end;
+
+                if ((leads & (u64(1) << position)) != 0) {
+                    this->beginSequence(data[position]);
+                    position++;
+                } else {
+                    this->report(!this->m_nullTermination || (zeros & (u64(1) << position)) != 0, found);
+                }
+            }
+        }
+
+        template<typename Callback>
+        void flush(Callback &&found) {
+            if (this->m_pendingBytes > 0) {
+                this->m_byteCount = this->m_sequenceStart;
+                this->m_pendingBytes = 0;
+            }
+
+            this->report(!this->m_nullTermination, found);
+        }
+
+        // Whether a string that starts inside of the given region could still be found
+        [[nodiscard]] bool hasOpenString(Region region) const {
+            return this->m_byteCount > 0 && region.overlaps({ this->m_startAddress, 1 });
+        }
+
+    private:
+        void beginSequence(u8 lead) {
+            this->m_sequenceStart = this->m_byteCount;
+            this->m_byteCount++;
+
+            this->m_pendingBytes = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : 1;
+
+            // Only the first continuation byte is restricted any further than 0x80 - 0xBF
+            this->m_lowerBound = 0x80;
+            this->m_upperBound = 0xBF;
+            switch (lead) {
+                case 0xE0: this->m_lowerBound = 0xA0; break;
+                case 0xED: this->m_upperBound = 0x9F; break;
+                case 0xF0: this->m_lowerBound = 0x90; break;
+                case 0xF4: this->m_upperBound = 0x8F; break;
+                default: break;
+            }
+        }
+
+        template<typename Callback>
+        void report(bool terminated, Callback &&found) {
+            if (terminated && this->m_characterCount > 0 && this->m_characterCount >= this->m_minLength)
+                found(Region { this->m_startAddress, this->m_byteCount }, this->m_multibyte);
+
+            this->m_byteCount      = 0;
+            this->m_characterCount = 0;
+            this->m_multibyte      = false;
+        }
+
+        size_t m_minLength;
+        bool m_nullTermination;
+
+        u64 m_startAddress = 0;
+        size_t m_byteCount = 0, m_characterCount = 0;
+        bool m_multibyte = false;
+
+        size_t m_sequenceStart = 0, m_pendingBytes = 0;
+        u8 m_lowerBound = 0x80, m_upperBound = 0xBF;
+    };
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <hex/helpers/literals.hpp>
+#include <hex/providers/io_statistics.hpp>
+
+namespace hex::prv {
+
+    using namespace hex::literals;
+
+    class BlockCache {
+    public:
+        // Returns the ranges that couldn't be read. They read as zeros and the blocks overlapping them don't get cached, so they're fetched again next time
+        using ReadFunction = std::function<std::vector<Region>(u64 offset, void *buffer, size_t size)>;
+
+        constexpr static size_t DefaultBlockSize    = 64_KiB;
+        constexpr static size_t DefaultCapacity     = 16_MiB;
+        constexpr static size_t DefaultShardCount   = 8;
+        constexpr static size_t DefaultMaxReadAhead = 16;
+
+        explicit BlockCache(ReadFunction readFunction, size_t blockSize = DefaultBlockSize, size_t capacity = DefaultCapacity, size_t shardCount = DefaultShardCount);
+
+        BlockCache(const BlockCache &) = delete;
+        BlockCache &operator=(const BlockCache &) = delete;
+
+        void read(u64 offset, void *buffer, size_t size);
+
+        void invalidate(u64 offset, size_t size);
+        void clear();
+
+        // Returns up to maxCount cached blocks, starting with the most recently used ones of each shard
+        [[nodiscard]] std::vector<u64> getCachedBlocks(size_t maxCount) const;
+
+        // Replaces the data of a block that's still cached. Fails if anything got invalidated since the generation was queried,
+        // so data that was fetched without holding any locks can't overwrite newer data
+        bool refreshBlock(u64 block, const void *data, size_t size, u64 generation);
+        [[nodiscard]] u64 getGeneration() const { return this->m_generation; }
+
+        void setDataSize(u64 size);
+        [[nodiscard]] u64 getDataSize() const { return this->m_dataSize; }
+
+        void setCapacity(size_t capacity);
+        [[nodiscard]] size_t getCapacity() const { return this->m_capacity; }
+
+        void setMaxReadAhead(size_t blockCount) { this->m_maxReadAhead = blockCount; }
+        [[nodiscard]] size_t getMaxReadAhead() const { return this->m_maxReadAhead; }
+
+        [[nodiscard]] size_t getBlockSize() const { return this->m_blockSize; }
+
+        void setStatistics(IOStatistics *statistics) { this->m_statistics = statistics; }
+
+        [[nodiscard]] u64 getHitCount() const { return this->m_hits; }
+        [[nodiscard]] u64 getMissCount() const { return this->m_misses; }
+        [[nodiscard]] u64 getReadAheadCount() const { return this->m_readAheads; }
+
+    private:
+        struct Shard {
+            std::mutex mutex;
+            std::list<std::pair<u64, std::vector<u8>>> blocks;
+            std::unordered_map<u64, decltype(blocks)::iterator> index;
+        };
+
+        [[nodiscard]] Shard &getShard(u64 block) const;
+        [[nodiscard]] size_t getBlockDataSize(u64 block) const;
+
+        bool copyFromBlock(u64 block, u64 offset, u8 *buffer, size_t size) const;
+        [[nodiscard]] bool isCached(u64 block) const;
+        void storeBlock(u64 block, const u8 *data, size_t size, u64 generation);
+
+        [[nodiscard]] size_t getReadAheadWindow(u64 offset, u64 endOffset);
+        u64 fetchBlocks(u64 block, u64 fetchLimit, std::vector<u8> &fetchBuffer, const std::function<void(u64 block, const u8 *data)> &onFetched);
+
+        ReadFunction m_readFunction;
+
+        size_t m_blockSize;
+        size_t m_capacity;
+        std::atomic<size_t> m_blocksPerShard = 1;
+        std::atomic<size_t> m_maxReadAhead = DefaultMaxReadAhead;
+        std::atomic<u64> m_dataSize = 0;
+        std::atomic<u64> m_generation = 0;
+
+        std::unique_ptr<Shard[]> m_shards;
+        size_t m_shardCount;
+
+        // Byte range of the last read, used to tell if reads keep continuing where the previous one stopped
+        std::mutex m_sequentialMutex;
+        u64 m_lastReadOffset = 0, m_lastReadEnd = 0;
+        u32 m_sequentialReads = 0;
+
+        std::atomic<u64> m_hits = 0, m_misses = 0, m_readAheads = 0;
+        IOStatistics *m_statistics = nullptr;
+    };
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -19,13 +21,21 @@ namespace hex::prv {
 
         }
 
+        // Reads through the snapshot so edits made while reading don't show up halfway through
+        explicit BufferedReader(const ProviderSnapshot &snapshot, size_t bufferSize = 16_MiB)
+        : m_provider(snapshot.getProvider()), m_snapshot(snapshot), m_bufferAddress(snapshot.getBaseAddress()), m_maxBufferSize(bufferSize),
+          m_startAddress(0x00), m_endAddress(snapshot.getActualSize() - 1),
+          m_buffer(bufferSize) {
+
+        }
+
         void seek(u64 address) {
             this->m_startAddress = address;
         }
 
         void setEndAddress(u64 address) {
-            if (address >= this->m_provider->getActualSize())
-                address = this->m_provider->getActualSize() - 1;
+            if (address >= this->getActualSize())
+                address = this->getActualSize() - 1;
 
             this->m_endAddress = address;
         }
@@ -35,7 +45,7 @@ namespace hex::prv {
                 std::vector<u8> result;
                 result.resize(size);
 
-                this->m_provider->read(address, result.data(), result.size());
+                this->readData(address, result.data(), result.size(), false);
 
                 return result;
             }
@@ -52,7 +62,7 @@ namespace hex::prv {
                 std::vector<u8> result;
                 result.resize(size);
 
-                this->m_provider->read(address, result.data(), result.size());
+                this->readData(address, result.data(), result.size(), false);
 
                 return result;
             }
@@ -64,6 +74,92 @@ namespace hex::prv {
             return { result, result + std::min(size, this->m_buffer.size()) };
         }
 
+        [[nodiscard]] std::span<const u8> readChunk(u64 address, size_t size) {
+            if (address > this->m_endAddress || size == 0)
+                return { };
+
+            size = std::min<u64>(size, (this->m_endAddress - address) + 1);
+            size = std::min(size, this->m_maxBufferSize);
+
+            this->updateBuffer(address, size, true);
+
+            const auto bufferOffset = address - this->m_bufferAddress;
+            if (bufferOffset >= this->m_buffer.size())
+                return { };
+
+            return { this->m_buffer.data() + bufferOffset, std::min<size_t>(size, this->m_buffer.size() - bufferOffset) };
+        }
+
+        struct Chunk {
+            u64 address;
+            std::span<const u8> data;
+        };
+
+        class ChunkIterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = Chunk;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+
+            ChunkIterator(BufferedReader *reader, u64 address, size_t chunkSize) : m_reader(reader), m_address(address), m_chunkSize(chunkSize) {}
+
+            ChunkIterator& operator++() {
+                this->m_address += this->m_chunkSize;
+
+                return *this;
+            }
+
+            ChunkIterator operator++(int) {
+                auto copy = *this;
+                this->m_address += this->m_chunkSize;
+
+                return copy;
+            }
+
+            value_type operator*() const {
+                return { this->m_address, this->m_reader->readChunk(this->m_address, this->m_chunkSize) };
+            }
+
+            [[nodiscard]] u64 getAddress() const {
+                return this->m_address;
+            }
+
+            friend bool operator== (const ChunkIterator& left, const ChunkIterator& right) { return left.m_address >= right.m_address; };
+            friend bool operator!= (const ChunkIterator& left, const ChunkIterator& right) { return left.m_address <  right.m_address; };
+
+        private:
+            BufferedReader *m_reader;
+            u64 m_address;
+            size_t m_chunkSize;
+        };
+
+        class Chunks {
+        public:
+            Chunks(BufferedReader *reader, size_t chunkSize) : m_reader(reader), m_chunkSize(chunkSize) {}
+
+            ChunkIterator begin() const {
+                return { this->m_reader, this->m_reader->m_startAddress, this->m_chunkSize };
+            }
+
+            ChunkIterator end() const {
+                return { this->m_reader, this->m_reader->m_endAddress + 1, this->m_chunkSize };
+            }
+
+        private:
+            BufferedReader *m_reader;
+            size_t m_chunkSize;
+        };
+
+        // The returned spans point into the internal buffer and are only valid until the next read
+        [[nodiscard]] Chunks chunks(size_t chunkSize = 0) {
+            if (chunkSize == 0 || chunkSize > this->m_maxBufferSize)
+                chunkSize = this->m_maxBufferSize;
+
+            return { this, chunkSize };
+        }
+
         class Iterator {
         public:
             using iterator_category = std::forward_iterator_tag;
@@ -133,11 +229,7 @@ namespace hex::prv {
             }
 
             value_type operator[](i64 offset) const {
-                auto result = this->m_reader->read(this->m_address + offset, 1);
-                if (result.empty())
-                    return 0x00;
-
-                return result[0];
+                return this->m_reader->readByte(this->m_address + offset);
             }
 
             friend bool operator== (const Iterator& left, const Iterator& right) { return left.m_address == right.m_address; };
@@ -221,11 +313,7 @@ namespace hex::prv {
             }
 
             value_type operator[](i64 offset) const {
-                auto result = this->m_reader->readReverse(this->m_address - offset, 1);
-                if (result.empty())
-                    return 0x00;
-
-                return result[0];
+                return this->m_reader->readByteReverse(this->m_address - offset);
             }
 
             friend bool operator== (const ReverseIterator& left, const ReverseIterator& right) { return left.m_address == right.m_address; };
@@ -257,22 +345,64 @@ namespace hex::prv {
         }
 
     private:
-        void updateBuffer(u64 address, size_t size) {
+        u8 readByte(u64 address) {
+            if (!this->m_bufferValid || address < this->m_bufferAddress || address >= (this->m_bufferAddress + this->m_buffer.size())) [[unlikely]] {
+                this->updateBuffer(address, 1, true);
+
+                if (address < this->m_bufferAddress || address >= (this->m_bufferAddress + this->m_buffer.size()))
+                    return 0x00;
+            }
+
+            return this->m_buffer[address - this->m_bufferAddress];
+        }
+
+        u8 readByteReverse(u64 address) {
+            if (!this->m_bufferValid || address < this->m_bufferAddress || address >= (this->m_bufferAddress + this->m_buffer.size())) [[unlikely]] {
+                this->updateBuffer(address - std::min<u64>(address, this->m_maxBufferSize - 1), 1);
+
+                if (address < this->m_bufferAddress || address >= (this->m_bufferAddress + this->m_buffer.size()))
+                    return 0x00;
+            }
+
+            return this->m_buffer[address - this->m_bufferAddress];
+        }
+
+        // Forward scans let the provider know that the data is read sequentially so it can stream it instead of faulting it in
+        void updateBuffer(u64 address, size_t size, bool sequential = false) {
             if (!this->m_bufferValid || address < this->m_bufferAddress || address + size > (this->m_bufferAddress + this->m_buffer.size())) {
-                const auto remainingBytes = (this->m_endAddress - address) + 1;
+                const auto remainingBytes = address <= this->m_endAddress ? (this->m_endAddress - address) + 1 : size;
                 if (remainingBytes < this->m_maxBufferSize)
                     this->m_buffer.resize(remainingBytes);
                 else
                     this->m_buffer.resize(this->m_maxBufferSize);
 
-                this->m_provider->read(address, this->m_buffer.data(), this->m_buffer.size());
+                this->readData(address, this->m_buffer.data(), this->m_buffer.size(), sequential);
                 this->m_bufferAddress = address;
                 this->m_bufferValid = true;
             }
         }
 
+        [[nodiscard]] size_t getActualSize() const {
+            return this->m_snapshot.has_value() ? this->m_snapshot->getActualSize() : this->m_provider->getActualSize();
+        }
+
+        void readData(u64 address, void *buffer, size_t size, bool sequential) {
+            if (this->m_snapshot.has_value()) {
+                if (sequential)
+                    this->m_snapshot->readSequential(address, buffer, size);
+                else
+                    this->m_snapshot->read(address, buffer, size);
+            } else {
+                if (sequential)
+                    this->m_provider->readSequential(address, buffer, size);
+                else
+                    this->m_provider->read(address, buffer, size);
+            }
+        }
+
     private:
         Provider *m_provider;
+        std::optional<ProviderSnapshot> m_snapshot;
 
         u64 m_bufferAddress = 0x00;
         size_t m_maxBufferSize;
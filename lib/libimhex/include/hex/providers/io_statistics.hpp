@@ -0,0 +1,92 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace hex::prv {
+
+    enum class IOSubsystem : u8 {
+        Other,
+        HexEditor,
+        DataInspector,
+        Find,
+        Hashes,
+        Information,
+        PatternLanguage,
+        Yara,
+
+        Count
+    };
+
+    class IOStatistics {
+    public:
+        // Bucket 0 counts operations that took less than a microsecond, bucket N the ones that took [2^(N-1), 2^N) microseconds
+        constexpr static size_t LatencyBucketCount = 24;
+
+        enum class Operation { Read, Write };
+
+        struct Counters {
+            u64 readCalls, writeCalls;
+            u64 bytesRead, bytesWritten;
+            std::chrono::nanoseconds readTime, writeTime;
+        };
+
+        class ScopedSubsystem {
+        public:
+            explicit ScopedSubsystem(IOSubsystem subsystem);
+            ~ScopedSubsystem();
+
+            ScopedSubsystem(const ScopedSubsystem &) = delete;
+            ScopedSubsystem &operator=(const ScopedSubsystem &) = delete;
+
+        private:
+            IOSubsystem m_previousSubsystem;
+        };
+
+        class ScopedOperation {
+        public:
+            ScopedOperation(IOStatistics &statistics, Operation operation, size_t size);
+            ~ScopedOperation();
+
+            ScopedOperation(const ScopedOperation &) = delete;
+            ScopedOperation &operator=(const ScopedOperation &) = delete;
+
+        private:
+            IOStatistics &m_statistics;
+            Operation m_operation;
+            size_t m_size;
+            std::chrono::steady_clock::time_point m_startTime;
+        };
+
+        IOStatistics() = default;
+
+        [[nodiscard]] static IOSubsystem getCurrentSubsystem();
+
+        void record(Operation operation, size_t size, std::chrono::nanoseconds duration);
+        void recordCacheHits(u64 count = 1) { this->m_cacheHits += count; }
+        void recordCacheMisses(u64 count = 1) { this->m_cacheMisses += count; }
+
+        [[nodiscard]] Counters getCounters(IOSubsystem subsystem) const;
+        [[nodiscard]] Counters getTotalCounters() const;
+        [[nodiscard]] std::array<u64, LatencyBucketCount> getLatencyHistogram() const;
+        [[nodiscard]] u64 getCacheHits() const { return this->m_cacheHits; }
+        [[nodiscard]] u64 getCacheMisses() const { return this->m_cacheMisses; }
+
+        void reset();
+
+    private:
+        struct AtomicCounters {
+            std::atomic<u64> readCalls = 0, writeCalls = 0;
+            std::atomic<u64> bytesRead = 0, bytesWritten = 0;
+            std::atomic<u64> readTime = 0, writeTime = 0;
+        };
+
+        std::array<AtomicCounters, size_t(IOSubsystem::Count)> m_counters;
+        std::array<std::atomic<u64>, LatencyBucketCount> m_latencyHistogram = { };
+        std::atomic<u64> m_cacheHits = 0, m_cacheMisses = 0;
+    };
+
+}
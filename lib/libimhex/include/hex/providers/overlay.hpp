@@ -2,6 +2,7 @@
 
 #include <hex.hpp>
 
+#include <functional>
 #include <vector>
 
 namespace hex::prv {
@@ -10,15 +11,31 @@ namespace hex::prv {
     public:
         Overlay() = default;
 
-        void setAddress(u64 address) { this->m_address = address; }
+        void setAddress(u64 address) {
+            this->m_address = address;
+            this->notifyChanged();
+        }
         [[nodiscard]] u64 getAddress() const { return this->m_address; }
 
+        void setData(std::vector<u8> data) {
+            this->m_data = std::move(data);
+            this->notifyChanged();
+        }
         [[nodiscard]] u64 getSize() const { return this->m_data.size(); }
-        [[nodiscard]] std::vector<u8> &getData() { return this->m_data; }
+        [[nodiscard]] const std::vector<u8> &getData() const { return this->m_data; }
+
+        void setChangeCallback(std::function<void()> callback) { this->m_changeCallback = std::move(callback); }
 
     private:
+        void notifyChanged() {
+            if (this->m_changeCallback)
+                this->m_changeCallback();
+        }
+
         u64 m_address = 0;
         std::vector<u8> m_data;
+
+        std::function<void()> m_changeCallback;
     };
 
-}
\ No newline at end of file
+}
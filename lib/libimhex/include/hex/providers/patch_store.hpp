@@ -0,0 +1,62 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace hex::prv {
+
+    // Copies share their runs until one of them gets modified, so frozen copies can be handed to other threads cheaply
+    class PatchStore {
+    public:
+        using Runs = std::map<u64, std::vector<u8>>;
+        using RunList = std::vector<std::pair<u64, std::vector<u8>>>;
+
+        PatchStore() = default;
+        PatchStore(const PatchStore &other);
+        PatchStore &operator=(const PatchStore &other);
+
+        void write(u64 address, const void *buffer, size_t size);
+        void erase(u64 address, size_t size);
+        void clear();
+
+        void insert(u64 address, size_t size);
+        void remove(u64 address, size_t size);
+
+        void apply(u64 address, void *buffer, size_t size) const;
+
+        [[nodiscard]] std::optional<u8> get(u64 address) const;
+        [[nodiscard]] bool contains(u64 address) const;
+        [[nodiscard]] std::optional<u64> getNextPatchAddress(u64 address) const;
+        [[nodiscard]] RunList getRuns(u64 address, size_t size) const;
+
+        [[nodiscard]] bool empty() const { return this->m_runs->empty(); }
+        [[nodiscard]] size_t getPatchedByteCount() const { return this->m_patchedBytes; }
+        [[nodiscard]] const Runs &getRuns() const { return *this->m_runs; }
+
+        // Incremented on every modification
+        [[nodiscard]] u64 getGeneration() const { return this->m_generation; }
+
+    private:
+        // Makes sure the runs aren't shared with any copy before they get modified. Must be called with m_mutex held
+        Runs &detach();
+
+        void eraseRuns(u64 address, size_t size);
+
+        [[nodiscard]] Runs::iterator findFirstRun(u64 address, bool includeAdjacent);
+        [[nodiscard]] Runs::const_iterator findFirstRun(u64 address) const;
+
+        std::shared_ptr<Runs> m_runs = std::make_shared<Runs>();
+        size_t m_patchedBytes = 0;
+        std::atomic<u64> m_generation = 0;
+
+        // Serializes modifications with copies being made from other threads
+        mutable std::mutex m_mutex;
+    };
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <hex/providers/piece_table.hpp>
+#include <hex/providers/snapshot.hpp>
+
+namespace hex::prv {
+
+    // Data a PieceLayout starts out with, e.g. a mapped file. Has to be safe to read from multiple threads at once
+    class OriginalData {
+    public:
+        virtual ~OriginalData() = default;
+
+        virtual void read(u64 offset, void *buffer, size_t size, bool sequential) const = 0;
+        [[nodiscard]] virtual std::vector<Region> getDataRegions(u64 offset, size_t size) const { return { Region { offset, size } }; }
+    };
+
+    // Original data with bytes inserted and removed. Layouts are never modified once created, edits return an updated copy instead.
+    // Readers that still hold on to an older layout therefore keep seeing the data exactly as it was
+    class PieceLayout : public RawDataState {
+    public:
+        PieceLayout(std::shared_ptr<const OriginalData> original, u64 originalSize);
+
+        void read(u64 offset, void *buffer, size_t size, bool sequential) const override;
+        [[nodiscard]] std::vector<Region> getDataRegions(u64 offset, size_t size) const override;
+        [[nodiscard]] u64 getSize() const override { return this->m_pieces.getSize(); }
+
+        [[nodiscard]] const PieceTable &getPieces() const { return this->m_pieces; }
+        [[nodiscard]] const std::shared_ptr<const OriginalData> &getOriginal() const { return this->m_original; }
+        [[nodiscard]] bool isIdentity() const { return this->m_pieces.isIdentity(); }
+
+        // Inserted bytes start out as zeros
+        [[nodiscard]] std::shared_ptr<const PieceLayout> insert(u64 offset, u64 size) const;
+        [[nodiscard]] std::shared_ptr<const PieceLayout> remove(u64 offset, u64 size) const;
+        [[nodiscard]] std::shared_ptr<const PieceLayout> appendOriginal(u64 size) const;
+
+        // Overwrites inserted bytes at the given offset into the added data. Original bytes have to be written to the original data directly
+        [[nodiscard]] std::shared_ptr<const PieceLayout> writeAdded(u64 addedOffset, const void *buffer, size_t size) const;
+
+        void readAdded(u64 addedOffset, void *buffer, size_t size) const;
+
+        // The same layout on top of different original data, e.g. after the file it was created for got reopened
+        [[nodiscard]] std::shared_ptr<const PieceLayout> withOriginal(std::shared_ptr<const OriginalData> original) const;
+
+    private:
+        // Inserted bytes are stored in fixed size chunks, found through a tree with a fixed number of children per node. Like the
+        // piece table, writes only copy the touched chunks and the nodes above them. Chunks that were never written to don't exist and read as zeros
+        constexpr static u64 AddedChunkSize = 0x1000;
+        constexpr static u64 AddedFanOut    = 64;
+
+        struct AddedNode {
+            std::vector<std::shared_ptr<const AddedNode>> children;
+            std::vector<u8> data;
+        };
+
+        [[nodiscard]] const AddedNode *findAddedChunk(u64 chunk) const;
+        [[nodiscard]] static std::shared_ptr<const AddedNode> writeAddedChunk(const AddedNode *node, u32 depth, u64 chunk, u64 chunkOffset, const u8 *bytes, size_t size);
+
+        std::shared_ptr<const OriginalData> m_original;
+        PieceTable m_pieces;
+
+        std::shared_ptr<const AddedNode> m_addedRoot;
+        u32 m_addedDepth = 0;
+        u64 m_addedSize = 0;
+    };
+
+}
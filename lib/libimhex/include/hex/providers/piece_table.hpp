@@ -0,0 +1,82 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace hex::prv {
+
+    // Nodes are never modified once created. Edits only recreate the nodes on the path to the change and share all others,
+    // so copying a table is cheap and copies don't affect each other
+    class PieceTable {
+    public:
+        enum class Source : u8 {
+            Original,
+            Added
+        };
+
+        struct Piece {
+            Source source;
+            u64 offset;
+            u64 size;
+        };
+
+        using PieceCallback = std::function<void(u64 offset, const Piece &piece)>;
+
+        PieceTable() = default;
+
+        void reset(u64 originalSize);
+
+        void insert(u64 offset, Source source, u64 sourceOffset, u64 size);
+        void remove(u64 offset, u64 size);
+
+        // Makes additional original data available at the end
+        void appendOriginal(u64 size);
+
+        // Calls the callback for every piece overlapping the given range, clipped to that range and in ascending order
+        void forEachPiece(u64 offset, u64 size, const PieceCallback &callback) const;
+
+        [[nodiscard]] u64 getSize() const;
+        [[nodiscard]] size_t getPieceCount() const;
+
+        // True as long as the table still maps every offset to the same offset in the original data
+        [[nodiscard]] bool isIdentity() const;
+
+    private:
+        struct Node;
+        using NodePtr = std::shared_ptr<const Node>;
+
+        struct Node {
+            Piece piece;
+            u32 priority;
+            NodePtr left, right;
+
+            u64 subtreeSize;
+            size_t subtreePieces;
+        };
+
+        [[nodiscard]] static NodePtr createNode(const Piece &piece, u32 priority, NodePtr left, NodePtr right);
+        [[nodiscard]] NodePtr createNode(const Piece &piece);
+
+        [[nodiscard]] static u64 getSubtreeSize(const NodePtr &node);
+        [[nodiscard]] static size_t getSubtreePieces(const NodePtr &node);
+
+        [[nodiscard]] std::pair<NodePtr, NodePtr> split(const NodePtr &node, u64 offset);
+        [[nodiscard]] static NodePtr merge(const NodePtr &left, const NodePtr &right);
+
+        // Same as merge but joins the pieces on both sides of the seam if they're contiguous in the same source
+        [[nodiscard]] NodePtr mergeCoalescing(const NodePtr &left, NodePtr right);
+        [[nodiscard]] static NodePtr growLastPiece(const NodePtr &node, u64 size);
+
+        static void visit(const NodePtr &node, u64 nodeOffset, u64 offset, u64 endOffset, const PieceCallback &callback);
+
+        NodePtr m_root;
+        u64 m_originalSize = 0;
+
+        std::minstd_rand m_random;
+    };
+
+}
@@ -2,20 +2,36 @@
 
 #include <hex.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <future>
 #include <list>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 #include <hex/api/imhex_api.hpp>
+#include <hex/providers/io_statistics.hpp>
 #include <hex/providers/overlay.hpp>
+#include <hex/providers/patch_store.hpp>
+#include <hex/providers/snapshot.hpp>
+#include <hex/providers/undo_journal.hpp>
 #include <hex/helpers/fs.hpp>
 
 #include <nlohmann/json.hpp>
+#include <IntervalTree.h>
 
 namespace hex::prv {
 
+    struct ReadRequest {
+        u64 offset;
+        void *buffer;
+        size_t size;
+    };
+
     class Provider {
     public:
         constexpr static size_t PageSize = 0x1000'0000;
@@ -30,6 +46,12 @@ namespace hex::prv {
         [[nodiscard]] virtual bool isSavable() const   = 0;
 
         virtual void read(u64 offset, void *buffer, size_t size, bool overlays = true);
+        virtual void readMany(std::span<const ReadRequest> requests, bool overlays = true);
+        virtual void readSequential(u64 offset, void *buffer, size_t size, bool overlays = true);
+        [[nodiscard]] std::future<std::vector<u8>> readAsync(u64 offset, size_t size, bool overlays = true);
+
+        // Blocks until all reads started with readAsync are done. The provider must not be closed before that
+        void waitForAsyncReads();
         virtual void write(u64 offset, const void *buffer, size_t size);
 
         virtual void resize(size_t newSize);
@@ -43,16 +65,25 @@ namespace hex::prv {
         virtual void writeRaw(u64 offset, const void *buffer, size_t size) = 0;
         [[nodiscard]] virtual size_t getActualSize() const                 = 0;
 
+        // Same as readRaw but hints that the data is going to be scanned front to back
+        virtual void readRawSequential(u64 offset, void *buffer, size_t size);
+
         void applyOverlays(u64 offset, void *buffer, size_t size);
 
-        [[nodiscard]] std::map<u64, u8> &getPatches();
-        [[nodiscard]] const std::map<u64, u8> &getPatches() const;
+        [[nodiscard]] PatchStore &getPatches();
+        [[nodiscard]] const PatchStore &getPatches() const;
         void applyPatches();
 
         [[nodiscard]] Overlay *newOverlay();
         void deleteOverlay(Overlay *overlay);
         [[nodiscard]] const std::list<Overlay *> &getOverlays();
 
+        // Freezes the current patches, overlays and raw data state. Patches are shared with the snapshot until the next edit copies them
+        [[nodiscard]] ProviderSnapshot snapshot();
+
+        // Changes whenever the patches or overlays get modified
+        [[nodiscard]] u64 getGeneration() const;
+
         [[nodiscard]] u32 getPageCount() const;
         [[nodiscard]] u32 getCurrentPage() const;
         void setCurrentPage(u32 page);
@@ -78,6 +109,8 @@ namespace hex::prv {
         [[nodiscard]] bool canUndo() const;
         [[nodiscard]] bool canRedo() const;
 
+        void setUndoHistoryLimit(size_t limit);
+
         [[nodiscard]] virtual bool hasFilePicker() const;
         virtual bool handleFilePicker();
 
@@ -99,23 +132,59 @@ namespace hex::prv {
 
         [[nodiscard]] virtual std::pair<Region, bool> getRegionValidity(u64 address) const;
 
+        // Sorted regions within [address, address + size) that may contain non-zero bytes. Everything in between is guaranteed to read as zeros
+        [[nodiscard]] std::vector<Region> getDataRegions(u64 address, size_t size) const;
+
+        [[nodiscard]] IOStatistics &getIOStatistics() { return this->m_ioStatistics; }
+        [[nodiscard]] const IOStatistics &getIOStatistics() const { return this->m_ioStatistics; }
+
         void skipLoadInterface() { this->m_skipLoadInterface = true; }
         [[nodiscard]] bool shouldSkipLoadInterface() const { return this->m_skipLoadInterface; }
 
     protected:
+        // Same as getDataRegions but works on offsets into the unmodified data, without taking patches and overlays into account
+        [[nodiscard]] virtual std::vector<Region> getRawDataRegions(u64 offset, size_t size) const;
+
+        // Frozen copy of the raw data for snapshots. Providers whose data can't change layout underneath a reader don't need one
+        [[nodiscard]] virtual std::shared_ptr<const RawDataState> getRawDataState() const { return nullptr; }
+
         u32 m_currPage    = 0;
         u64 m_baseAddress = 0;
 
-        u32 m_patchTreeOffset = 0;
-        std::list<std::map<u64, u8>> m_patches;
+        PatchStore m_patches;
+        UndoJournal m_undoJournal;
         std::list<Overlay *> m_overlays;
 
+        IOStatistics m_ioStatistics;
+
         u32 m_id;
 
         bool m_dirty = false;
         bool m_skipLoadInterface = false;
 
     private:
+        friend class ProviderSnapshot;
+
+        void rebuildOverlayIndex() const;
+        void invalidateOverlays();
+
+        // Overlays are indexed lazily by their address range. Values are positions in m_indexedOverlays so hits can be applied in creation order
+        mutable std::mutex m_overlayIndexMutex;
+        mutable bool m_overlayIndexValid = true;
+        mutable interval_tree::IntervalTree<u64, u64> m_overlayIndex;
+        mutable std::vector<Overlay *> m_indexedOverlays;
+        mutable std::vector<u64> m_overlayStartAddresses;
+
+        // Frozen copy of the overlays that's shared by all snapshots taken until they change again
+        std::atomic<u64> m_overlayGeneration = 0;
+        std::shared_ptr<const OverlayState> m_overlayState;
+        u64 m_overlayStateGeneration = 0;
+
+        // Number of readAsync calls that are still running
+        std::mutex m_asyncReadMutex;
+        std::condition_variable m_asyncReadsDone;
+        u32 m_asyncReads = 0;
+
         static u32 s_idCounter;
     };
 
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <hex/providers/patch_store.hpp>
+
+#include <IntervalTree.h>
+
+namespace hex::prv {
+
+    class Provider;
+
+    // Immutable copy of the overlays of a provider. Overlays are applied in the order they were created in
+    struct OverlayState {
+        std::vector<std::pair<u64, std::vector<u8>>> overlays;
+        interval_tree::IntervalTree<u64, u64> index;
+    };
+
+    // Immutable copy of the raw data of a provider whose layout can change while it's being read, e.g. through inserts or remapping.
+    // Snapshots read from it instead of from the provider so they keep seeing the data as it was when they were taken
+    class RawDataState {
+    public:
+        virtual ~RawDataState() = default;
+
+        virtual void read(u64 offset, void *buffer, size_t size, bool sequential) const = 0;
+        [[nodiscard]] virtual std::vector<Region> getDataRegions(u64 offset, size_t size) const = 0;
+        [[nodiscard]] virtual u64 getSize() const = 0;
+    };
+
+    // Read-only view of a provider with the patches, overlays and, if the provider supports it, the raw data frozen at the time it was taken.
+    // Reads don't take any locks on the provider so background tasks can use it while the data keeps getting edited
+    class ProviderSnapshot {
+    public:
+        void read(u64 address, void *buffer, size_t size, bool overlays = true) const;
+        void readSequential(u64 address, void *buffer, size_t size, bool overlays = true) const;
+
+        // Same as Provider::getDataRegions but using the frozen patches and overlays
+        [[nodiscard]] std::vector<Region> getDataRegions(u64 address, size_t size) const;
+
+        [[nodiscard]] Provider *getProvider() const { return this->m_provider; }
+        [[nodiscard]] u64 getGeneration() const { return this->m_generation; }
+        [[nodiscard]] u64 getBaseAddress() const { return this->m_baseAddress; }
+        [[nodiscard]] size_t getActualSize() const { return this->m_actualSize; }
+        [[nodiscard]] const PatchStore &getPatches() const { return *this->m_patches; }
+
+        // True as long as nothing got edited since the snapshot was taken
+        [[nodiscard]] bool isCurrent() const;
+
+    private:
+        friend class Provider;
+
+        ProviderSnapshot(Provider *provider, u64 generation, u64 baseAddress, size_t actualSize, std::shared_ptr<const PatchStore> patches, std::shared_ptr<const OverlayState> overlays, std::shared_ptr<const RawDataState> rawData);
+
+        void readData(u64 address, void *buffer, size_t size, bool sequential) const;
+        void applyChanges(u64 address, void *buffer, size_t size, bool overlays) const;
+
+        // Adds the ranges covered by patches and overlays to the regions of the raw data, then sorts and merges them
+        [[nodiscard]] static std::vector<Region> mergeDataRegions(std::vector<Region> regions, u64 address, size_t size, const PatchStore &patches, const interval_tree::IntervalTree<u64, u64> &overlayIndex);
+
+        Provider *m_provider;
+        u64 m_generation;
+        u64 m_baseAddress;
+        size_t m_actualSize;
+
+        std::shared_ptr<const PatchStore> m_patches;
+        std::shared_ptr<const OverlayState> m_overlays;
+
+        // Null if the provider doesn't freeze its raw data, in which case it's read from the provider directly
+        std::shared_ptr<const RawDataState> m_rawData;
+    };
+
+}
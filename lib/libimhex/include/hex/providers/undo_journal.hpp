@@ -0,0 +1,59 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <deque>
+#include <vector>
+
+#include <hex/providers/patch_store.hpp>
+#include <hex/helpers/literals.hpp>
+
+namespace hex::prv {
+
+    using namespace hex::literals;
+
+    class UndoJournal {
+    public:
+        constexpr static size_t DefaultMemoryLimit = 256_MiB;
+
+        UndoJournal() = default;
+
+        void beginTransaction();
+        void record(u64 address, size_t size, PatchStore::RunList before, PatchStore::RunList after);
+
+        void undo(PatchStore &patches);
+        void redo(PatchStore &patches);
+
+        [[nodiscard]] bool canUndo() const;
+        [[nodiscard]] bool canRedo() const;
+
+        void clear();
+
+        void setMemoryLimit(size_t limit);
+        [[nodiscard]] size_t getMemoryLimit() const { return this->m_memoryLimit; }
+        [[nodiscard]] size_t getMemoryUsage() const { return this->m_memoryUsage; }
+
+    private:
+        struct Delta {
+            u64 address;
+            size_t size;
+            PatchStore::RunList before, after;
+        };
+
+        struct Transaction {
+            std::vector<Delta> deltas;
+            size_t memoryUsage = 0;
+        };
+
+        void dropRedoHistory();
+        void enforceMemoryLimit();
+
+        std::deque<Transaction> m_transactions;
+        size_t m_position = 0;
+        bool m_transactionOpen = false;
+
+        size_t m_memoryUsage = 0;
+        size_t m_memoryLimit = DefaultMemoryLimit;
+    };
+
+}
@@ -313,6 +313,7 @@ namespace hex {
             else if (it - s_providers.begin() == s_currentProvider)
                 setCurrentProvider(0);
 
+            provider->waitForAsyncReads();
             provider->close();
             EventManager::post<EventProviderClosed>(provider);
 
@@ -50,6 +50,14 @@ namespace hex {
             throw TaskInterruptor();
     }
 
+    // Can be called from multiple threads that work on the same task at once
+    void Task::increment(u64 value) {
+        this->m_currValue += value;
+
+        if (this->m_shouldInterrupt)
+            throw TaskInterruptor();
+    }
+
     void Task::setMaxValue(u64 value) {
         this->m_maxValue = value;
     }
@@ -0,0 +1,123 @@
+#include <hex/helpers/aho_corasick.hpp>
+
+#include <algorithm>
+
+namespace hex {
+
+    namespace {
+
+        // Limits the transition table to 16 MiB. Larger tables are slow to build and don't fit into any cache anyway
+        constexpr size_t MaxTransitionTableEntries = 4 * 1024 * 1024;
+
+    }
+
+    AhoCorasick::AhoCorasick(const std::vector<std::vector<u8>> &needles) {
+        // Build the trie
+        std::vector<std::vector<std::pair<u8, State>>> children(1);
+        std::vector<u32> stateNeedles = { NoNeedle };
+        std::array<bool, 256> usedBytes = { }, firstBytes = { };
+
+        for (u32 needle = 0; needle < needles.size(); needle++) {
+            const auto &bytes = needles[needle];
+            this->m_needleLengths.push_back(bytes.size());
+            this->m_maxNeedleLength = std::max(this->m_maxNeedleLength, bytes.size());
+
+            if (bytes.empty())
+                continue;
+
+            firstBytes[bytes.front()] = true;
+
+            State state = Root;
+            for (u8 byte : bytes) {
+                usedBytes[byte] = true;
+
+                auto &edges = children[state];
+                auto edge = std::find_if(edges.begin(), edges.end(), [byte](const auto &edge) { return edge.first == byte; });
+                if (edge != edges.end()) {
+                    state = edge->second;
+                } else {
+                    const State child = children.size();
+                    edges.emplace_back(byte, child);
+                    children.emplace_back();
+                    stateNeedles.push_back(NoNeedle);
+                    state = child;
+                }
+            }
+
+            if (stateNeedles[state] == NoNeedle)
+                stateNeedles[state] = needle;
+        }
+
+        // Number the states in breadth-first order. Failure links always point to states that come earlier then,
+        // and the states close to the root which get visited the most end up next to each other
+        const size_t stateCount = children.size();
+
+        std::vector<State> order = { Root }, renumbered(stateCount);
+        for (size_t i = 0; i < order.size(); i++) {
+            auto &edges = children[order[i]];
+            std::sort(edges.begin(), edges.end());
+
+            renumbered[order[i]] = i;
+            for (const auto &[byte, child] : edges)
+                order.push_back(child);
+        }
+
+        this->m_needles.resize(stateCount);
+        this->m_edgeOffsets.reserve(stateCount + 1);
+        for (State state = 0; state < stateCount; state++) {
+            this->m_needles[state] = stateNeedles[order[state]];
+
+            this->m_edgeOffsets.push_back(this->m_edgeBytes.size());
+            for (const auto &[byte, child] : children[order[state]]) {
+                this->m_edgeBytes.push_back(byte);
+                this->m_edgeTargets.push_back(renumbered[child]);
+            }
+        }
+        this->m_edgeOffsets.push_back(this->m_edgeBytes.size());
+
+        // Compress the alphabet down to the bytes that actually appear in the needles
+        for (u32 byte = 0; byte < 256; byte++) {
+            if (usedBytes[byte])
+                this->m_alphabet[byte] = this->m_alphabetSize++;
+        }
+
+        // The first states get a full transition table, the remaining ones only store their children
+        this->m_tableStateCount = std::min(stateCount, MaxTransitionTableEntries / this->m_alphabetSize);
+        this->m_transitions.resize(this->m_tableStateCount * this->m_alphabetSize, Root);
+
+        // Link every state to the longest proper suffix of it that's also in the trie
+        this->m_failureLinks.resize(stateCount, Root);
+        this->m_dictionaryLinks.resize(stateCount, NoState);
+        this->m_matches.resize(stateCount, NoState);
+
+        for (State state = 0; state < stateCount; state++) {
+            const State failure = this->m_failureLinks[state];
+            const bool hasTable = state < this->m_tableStateCount;
+
+            if (state != Root) {
+                this->m_dictionaryLinks[state] = this->m_needles[failure] != NoNeedle ? failure : this->m_dictionaryLinks[failure];
+
+                // Bytes without a child of their own continue like they would from the failure state
+                if (hasTable)
+                    std::copy_n(this->m_transitions.begin() + failure * this->m_alphabetSize, this->m_alphabetSize, this->m_transitions.begin() + state * this->m_alphabetSize);
+            }
+
+            this->m_matches[state] = this->m_needles[state] != NoNeedle ? state : this->m_dictionaryLinks[state];
+
+            for (u32 edge = this->m_edgeOffsets[state]; edge < this->m_edgeOffsets[state + 1]; edge++) {
+                const u8 byte     = this->m_edgeBytes[edge];
+                const State child = this->m_edgeTargets[edge];
+
+                this->m_failureLinks[child] = state == Root ? Root : this->step(failure, byte);
+
+                if (hasTable)
+                    this->m_transitions[state * this->m_alphabetSize + this->m_alphabet[byte]] = child;
+            }
+        }
+
+        // Looking for the first byte of a needle with vector instructions is only worth it if the set of first bytes can be vectorized
+        this->m_firstBytes = ByteClass(firstBytes);
+        this->m_prefilter  = this->m_firstBytes.isVectorized();
+    }
+
+}
@@ -0,0 +1,151 @@
+#include <hex/helpers/byte_class.hpp>
+
+#include <cstring>
+
+#include "simd.hpp"
+
+namespace hex {
+
+    namespace {
+
+        // Fallback for classes that consist of too many ranges and for CPUs without a vector unit
+        void classifyScalar(const u8 *data, const std::array<bool, 256> &table, u64 &members, u64 &zeros) {
+            members = 0;
+            zeros   = 0;
+
+            for (size_t i = 0; i < ByteClass::BlockSize; i++) {
+                members |= u64(table[data[i]]) << i;
+                zeros   |= u64(data[i] == 0x00) << i;
+            }
+        }
+
+        #if defined(IMHEX_SIMD_X86)
+
+            // A byte is within [start, start + length] if (byte - start) doesn't wrap around past length
+            void classifySSE2(const u8 *data, const u8 *starts, const u8 *lengths, size_t rangeCount, u64 &members, u64 &zeros) {
+                members = 0;
+                zeros   = 0;
+
+                const auto zero = _mm_setzero_si128();
+                for (size_t i = 0; i < ByteClass::BlockSize; i += 16) {
+                    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+                    auto matches = _mm_setzero_si128();
+                    for (size_t range = 0; range < rangeCount; range++) {
+                        const auto offset = _mm_sub_epi8(bytes, _mm_set1_epi8(char(starts[range])));
+                        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(char(lengths[range]))), offset));
+                    }
+
+                    members |= u64(u16(_mm_movemask_epi8(matches))) << i;
+                    zeros   |= u64(u16(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)))) << i;
+                }
+            }
+
+            __attribute__((target("avx2")))
+            void classifyAVX2(const u8 *data, const u8 *starts, const u8 *lengths, size_t rangeCount, u64 &members, u64 &zeros) {
+                members = 0;
+                zeros   = 0;
+
+                const auto zero = _mm256_setzero_si256();
+                for (size_t i = 0; i < ByteClass::BlockSize; i += 32) {
+                    const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+
+                    auto matches = _mm256_setzero_si256();
+                    for (size_t range = 0; range < rangeCount; range++) {
+                        const auto offset = _mm256_sub_epi8(bytes, _mm256_set1_epi8(char(starts[range])));
+                        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(char(lengths[range]))), offset));
+                    }
+
+                    members |= u64(u32(_mm256_movemask_epi8(matches))) << i;
+                    zeros   |= u64(u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, zero)))) << i;
+                }
+            }
+
+        #elif defined(IMHEX_SIMD_NEON)
+
+            void classifyNEON(const u8 *data, const u8 *starts, const u8 *lengths, size_t rangeCount, u64 &members, u64 &zeros) {
+                members = 0;
+                zeros   = 0;
+
+                for (size_t i = 0; i < ByteClass::BlockSize; i += 16) {
+                    const auto bytes = vld1q_u8(data + i);
+
+                    auto matches = vdupq_n_u8(0x00);
+                    for (size_t range = 0; range < rangeCount; range++)
+                        matches = vorrq_u8(matches, vcleq_u8(vsubq_u8(bytes, vdupq_n_u8(starts[range])), vdupq_n_u8(lengths[range])));
+
+                    members |= u64(simd::toBitMask(matches)) << i;
+                    zeros   |= u64(simd::toBitMask(vceqzq_u8(bytes))) << i;
+                }
+            }
+
+        #endif
+
+    }
+
+    ByteClass::ByteClass(const std::array<bool, 256> &table) : m_table(table) {
+        // Split the set into contiguous ranges. Only sets with a handful of them are worth comparing against directly
+        this->m_vectorizable = true;
+        for (u32 byte = 0; byte < 256;) {
+            if (!table[byte]) {
+                byte++;
+                continue;
+            }
+
+            u32 end = byte;
+            while (end + 1 < 256 && table[end + 1])
+                end++;
+
+            if (this->m_rangeCount == MaxRanges) {
+                this->m_vectorizable = false;
+                break;
+            }
+
+            this->m_rangeStarts[this->m_rangeCount]  = byte;
+            this->m_rangeLengths[this->m_rangeCount] = end - byte;
+            this->m_rangeCount++;
+            byte = end + 1;
+        }
+    }
+
+    void ByteClass::classify(const u8 *data, size_t size, u64 &members, u64 &zeros) const {
+        if (size == 0) {
+            members = 0;
+            zeros   = 0;
+            return;
+        }
+
+        // Partial blocks are padded so the kernels can always work on full blocks
+        u8 padded[BlockSize];
+        if (size < BlockSize) {
+            std::memcpy(padded, data, size);
+            std::memset(padded + size, 0x00, BlockSize - size);
+            data = padded;
+        }
+
+        [[maybe_unused]] const auto starts  = this->m_rangeStarts.data();
+        [[maybe_unused]] const auto lengths = this->m_rangeLengths.data();
+
+        if (!this->m_vectorizable) {
+            classifyScalar(data, this->m_table, members, zeros);
+        } else {
+            #if defined(IMHEX_SIMD_X86)
+                if (simd::hasAVX2())
+                    classifyAVX2(data, starts, lengths, this->m_rangeCount, members, zeros);
+                else
+                    classifySSE2(data, starts, lengths, this->m_rangeCount, members, zeros);
+            #elif defined(IMHEX_SIMD_NEON)
+                classifyNEON(data, starts, lengths, this->m_rangeCount, members, zeros);
+            #else
+                classifyScalar(data, this->m_table, members, zeros);
+            #endif
+        }
+
+        if (size < BlockSize) {
+            const auto mask = (u64(1) << size) - 1;
+            members &= mask;
+            zeros   &= mask;
+        }
+    }
+
+}
@@ -3,6 +3,7 @@
 #include <hex/providers/provider.hpp>
 #include <hex/helpers/utils.hpp>
 #include <hex/helpers/concepts.hpp>
+#include <hex/helpers/literals.hpp>
 
 #include <mbedtls/version.h>
 #include <mbedtls/base64.h>
@@ -21,6 +22,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <bit>
+#include <vector>
 
 #if MBEDTLS_VERSION_MAJOR <= 2
 
@@ -44,15 +46,33 @@
 
 namespace hex::crypt {
     using namespace std::placeholders;
+    using namespace hex::literals;
 
     template<std::invocable<unsigned char *, size_t> Func>
     void processDataByChunks(prv::Provider *data, u64 offset, size_t size, Func func) {
-        std::array<u8, 512> buffer = { 0 };
-        for (size_t bufferOffset = 0; bufferOffset < size; bufferOffset += buffer.size()) {
-            const auto readSize = std::min(buffer.size(), size - bufferOffset);
-            data->read(offset + bufferOffset, buffer.data(), readSize);
-            func(buffer.data(), readSize);
+        constexpr static size_t ChunkSize = 1_MiB;
+
+        // Holes in sparse data are fed from a block of zeros instead of being read
+        static std::vector<u8> zeros(ChunkSize);
+        auto processZeros = [&](u64 zeroCount) {
+            for (u64 processed = 0; processed < zeroCount; processed += ChunkSize)
+                func(zeros.data(), std::min<u64>(ChunkSize, zeroCount - processed));
+        };
+
+        std::vector<u8> buffer(std::min<size_t>(size, ChunkSize));
+        u64 address = offset;
+        for (const auto &region : data->getDataRegions(offset, size)) {
+            processZeros(region.getStartAddress() - address);
+
+            for (size_t bufferOffset = 0; bufferOffset < region.getSize(); bufferOffset += buffer.size()) {
+                const auto readSize = std::min<size_t>(buffer.size(), region.getSize() - bufferOffset);
+                data->readSequential(region.getStartAddress() + bufferOffset, buffer.data(), readSize);
+                func(buffer.data(), readSize);
+            }
+
+            address = region.getStartAddress() + region.getSize();
         }
+        processZeros(offset + size - address);
     }
 
     template<typename T>
@@ -63,7 +63,7 @@ namespace hex::fs {
     size_t File::readBuffer(u8 *buffer, size_t size) {
         if (!isValid()) return 0;
 
-        return fread(buffer, size, 1, this->m_file);
+        return fread(buffer, 1, size, this->m_file);
     }
 
     std::vector<u8> File::readBytes(size_t numBytes) {
@@ -0,0 +1,85 @@
+#include <hex/helpers/gdb_protocol.hpp>
+
+#include <hex/helpers/crypto.hpp>
+#include <hex/helpers/fmt.hpp>
+
+#include <algorithm>
+#include <cctype>
+
+namespace hex::gdb {
+
+    u8 calculateChecksum(std::string_view data) {
+        u64 checksum = 0;
+
+        for (const auto &c : data)
+            checksum += u8(c);
+
+        return checksum & 0xFF;
+    }
+
+    std::string createPacket(const std::string &data) {
+        return hex::format("${}#{:02x}", data, calculateChecksum(data));
+    }
+
+    bool needsEscaping(u8 byte) {
+        return byte == '#' || byte == '$' || byte == '}' || byte == '*';
+    }
+
+    std::string decodePayload(std::string_view payload) {
+        std::string expanded;
+        expanded.reserve(payload.size());
+
+        for (size_t i = 0; i < payload.size(); i++) {
+            if (payload[i] == '*' && !expanded.empty() && i + 1 < payload.size()) {
+                expanded.append(u8(payload[i + 1]) - 29, expanded.back());
+                i++;
+            } else {
+                expanded.push_back(payload[i]);
+            }
+        }
+
+        std::string result;
+        result.reserve(expanded.size());
+
+        for (size_t i = 0; i < expanded.size(); i++) {
+            if (expanded[i] == '}' && i + 1 < expanded.size()) {
+                result.push_back(expanded[i + 1] ^ 0x20);
+                i++;
+            } else {
+                result.push_back(expanded[i]);
+            }
+        }
+
+        return result;
+    }
+
+    bool isErrorReply(const std::string &reply) {
+        return reply.size() == 3 && reply.starts_with('E') && std::isxdigit(u8(reply[1])) && std::isxdigit(u8(reply[2]));
+    }
+
+    std::optional<std::vector<u8>> parseReadReply(BinaryRead format, const std::string &reply, size_t size) {
+        switch (format) {
+            case BinaryRead::Prefixed:
+                if (!reply.starts_with('b'))
+                    return std::nullopt;
+
+                return std::vector<u8>(reply.begin() + 1, reply.begin() + std::min<size_t>(reply.size(), size + 1));
+            case BinaryRead::Raw:
+                if (reply.empty() || isErrorReply(reply))
+                    return std::nullopt;
+
+                return std::vector<u8>(reply.begin(), reply.begin() + std::min<size_t>(reply.size(), size));
+            default: {
+                if (reply.empty() || isErrorReply(reply))
+                    return std::nullopt;
+
+                auto data = crypt::decode16(reply);
+                if (data.size() > size)
+                    data.resize(size);
+
+                return data;
+            }
+        }
+    }
+
+}
@@ -0,0 +1,184 @@
+#include <hex/helpers/masked_pattern.hpp>
+
+#include <algorithm>
+#include <optional>
+
+#include "simd.hpp"
+
+namespace hex {
+
+    namespace {
+
+        template<typename Filter>
+        u64 filterScalar(const u8 *data, const std::vector<Filter> &filters) {
+            u64 result = ~u64(0);
+
+            for (const auto &filter : filters) {
+                u64 matches = 0;
+                for (size_t i = 0; i < MaskedPattern::BlockSize; i++)
+                    matches |= u64((data[filter.offset + i] & filter.mask) == filter.value) << i;
+
+                result &= matches;
+                if (result == 0)
+                    break;
+            }
+
+            return result;
+        }
+
+        #if defined(IMHEX_SIMD_X86)
+
+            template<typename Filter>
+            u64 filterSSE2(const u8 *data, const std::vector<Filter> &filters) {
+                u64 result = ~u64(0);
+
+                for (const auto &filter : filters) {
+                    const auto mask  = _mm_set1_epi8(char(filter.mask));
+                    const auto value = _mm_set1_epi8(char(filter.value));
+
+                    u64 matches = 0;
+                    for (size_t i = 0; i < MaskedPattern::BlockSize; i += 16) {
+                        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + filter.offset + i));
+                        matches |= u64(u16(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(bytes, mask), value)))) << i;
+                    }
+
+                    result &= matches;
+                    if (result == 0)
+                        break;
+                }
+
+                return result;
+            }
+
+            template<typename Filter>
+            __attribute__((target("avx2")))
+            u64 filterAVX2(const u8 *data, const std::vector<Filter> &filters) {
+                u64 result = ~u64(0);
+
+                for (const auto &filter : filters) {
+                    const auto mask  = _mm256_set1_epi8(char(filter.mask));
+                    const auto value = _mm256_set1_epi8(char(filter.value));
+
+                    u64 matches = 0;
+                    for (size_t i = 0; i < MaskedPattern::BlockSize; i += 32) {
+                        const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + filter.offset + i));
+                        matches |= u64(u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(bytes, mask), value)))) << i;
+                    }
+
+                    result &= matches;
+                    if (result == 0)
+                        break;
+                }
+
+                return result;
+            }
+
+        #elif defined(IMHEX_SIMD_NEON)
+
+            template<typename Filter>
+            u64 filterNEON(const u8 *data, const std::vector<Filter> &filters) {
+                u64 result = ~u64(0);
+
+                for (const auto &filter : filters) {
+                    const auto mask  = vdupq_n_u8(filter.mask);
+                    const auto value = vdupq_n_u8(filter.value);
+
+                    u64 matches = 0;
+                    for (size_t i = 0; i < MaskedPattern::BlockSize; i += 16)
+                        matches |= u64(simd::toBitMask(vceqq_u8(vandq_u8(vld1q_u8(data + filter.offset + i), mask), value))) << i;
+
+                    result &= matches;
+                    if (result == 0)
+                        break;
+                }
+
+                return result;
+            }
+
+        #endif
+
+    }
+
+    MaskedPattern::MaskedPattern(const std::vector<Byte> &pattern) {
+        for (const auto &byte : pattern)
+            this->m_pattern.push_back({ byte.mask, u8(byte.value & byte.mask) });
+
+        const auto size = this->m_pattern.size();
+        auto isLiteral = [this](size_t offset) { return this->m_pattern[offset].mask == 0xFF; };
+
+        for (size_t offset = 0; offset < size;) {
+            if (!isLiteral(offset)) {
+                offset++;
+                continue;
+            }
+
+            size_t end = offset;
+            while (end < size && isLiteral(end))
+                end++;
+
+            if (end - offset > this->m_anchorSize) {
+                this->m_anchorOffset = offset;
+                this->m_anchorSize   = end - offset;
+            }
+
+            offset = end;
+        }
+
+        auto addFilter = [this](size_t offset) {
+            this->m_filters.push_back({ u32(offset), this->m_pattern[offset].mask, this->m_pattern[offset].value });
+        };
+
+        if (this->m_anchorSize > 0) {
+            // Candidates are the positions where the first and the last byte of the anchor match, like in a SIMD memmem.
+            // Adjacent bytes tend to be correlated, so the literal byte furthest away from the anchor is checked as well
+            const auto anchorEnd = this->m_anchorOffset + this->m_anchorSize - 1;
+
+            addFilter(this->m_anchorOffset);
+            if (this->m_anchorSize > 1)
+                addFilter(anchorEnd);
+
+            std::optional<size_t> before, after;
+            for (size_t offset = 0; offset < this->m_anchorOffset && !before.has_value(); offset++) {
+                if (isLiteral(offset))
+                    before = offset;
+            }
+            for (size_t offset = size; offset > anchorEnd + 1 && !after.has_value(); offset--) {
+                if (isLiteral(offset - 1))
+                    after = offset - 1;
+            }
+
+            if (before.has_value() && (!after.has_value() || this->m_anchorOffset - *before >= *after - anchorEnd))
+                addFilter(*before);
+            else if (after.has_value())
+                addFilter(*after);
+        } else {
+            // Without an anchor every byte that isn't a full wildcard is compared, which makes this a shift-and over whole blocks.
+            // The bytes with the most fixed bits go first as they rule out the most positions
+            for (size_t offset = 0; offset < size; offset++) {
+                if (this->m_pattern[offset].mask != 0x00)
+                    addFilter(offset);
+            }
+
+            std::stable_sort(this->m_filters.begin(), this->m_filters.end(), [](const auto &a, const auto &b) {
+                return std::popcount(a.mask) > std::popcount(b.mask);
+            });
+        }
+
+        const auto fixedBytes = std::count_if(this->m_pattern.begin(), this->m_pattern.end(), [](const auto &byte) { return byte.mask != 0x00; });
+        this->m_verify = size_t(fixedBytes) != this->m_filters.size();
+    }
+
+    u64 MaskedPattern::filter(const u8 *data) const {
+        #if defined(IMHEX_SIMD_X86)
+            if (simd::hasAVX2())
+                return filterAVX2(data, this->m_filters);
+            else
+                return filterSSE2(data, this->m_filters);
+        #elif defined(IMHEX_SIMD_NEON)
+            return filterNEON(data, this->m_filters);
+        #else
+            return filterScalar(data, this->m_filters);
+        #endif
+    }
+
+}
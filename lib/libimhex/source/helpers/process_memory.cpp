@@ -0,0 +1,78 @@
+#include <hex/helpers/process_memory.hpp>
+
+#include <hex/helpers/utils.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+
+#if defined(OS_LINUX)
+    #include <climits>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+namespace hex::process {
+
+    void readMemoryPages(u32 processId, const Transfer &transfer, u64 start) {
+        #if defined(OS_LINUX)
+
+            static const u64 PageSize = std::max<long>(sysconf(_SC_PAGESIZE), 1);
+
+            for (u64 offset = start; offset < transfer.size;) {
+                const u64 address = transfer.address + offset;
+                const u64 size    = std::min<u64>(transfer.size - offset, PageSize - (address % PageSize));
+
+                iovec local  = { transfer.buffer + offset, size };
+                iovec remote = { reinterpret_cast<void *>(address), size };
+                if (process_vm_readv(processId, &local, 1, &remote, 1, 0) < 0 && errno != EFAULT)
+                    return;
+
+                offset += size;
+            }
+
+        #else
+
+            hex::unused(processId, transfer, start);
+
+        #endif
+    }
+
+    void readMemory(u32 processId, std::span<const Transfer> transfers) {
+        #if defined(OS_LINUX)
+
+            std::vector<iovec> localVectors, remoteVectors;
+            for (size_t index = 0; index < transfers.size();) {
+                localVectors.clear();
+                remoteVectors.clear();
+
+                for (size_t i = index; i < transfers.size() && localVectors.size() < IOV_MAX; i++) {
+                    localVectors.push_back({ transfers[i].buffer, transfers[i].size });
+                    remoteVectors.push_back({ reinterpret_cast<void *>(transfers[i].address), transfers[i].size });
+                }
+
+                const auto result = process_vm_readv(processId, localVectors.data(), localVectors.size(), remoteVectors.data(), remoteVectors.size(), 0);
+                if (result < 0 && errno != EFAULT)
+                    return;
+
+                // The transfer stops at the first remote range that can't be read completely. Skip the ones that were read and read the failed one page by page
+                u64 transferred = std::max<ssize_t>(result, 0);
+                while (index < transfers.size() && transferred >= transfers[index].size) {
+                    transferred -= transfers[index].size;
+                    index++;
+                }
+
+                if (index < transfers.size()) {
+                    readMemoryPages(processId, transfers[index], transferred);
+                    index++;
+                }
+            }
+
+        #else
+
+            hex::unused(processId, transfers);
+
+        #endif
+    }
+
+}
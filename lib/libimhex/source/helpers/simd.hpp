@@ -0,0 +1,37 @@
+#pragma once
+
+#include <hex.hpp>
+
+// Vector units the block based byte matchers have implementations for
+#if defined(__x86_64__) || defined(_M_X64)
+    #define IMHEX_SIMD_X86
+    #include <immintrin.h>
+#elif defined(__aarch64__)
+    #define IMHEX_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace hex::simd {
+
+    #if defined(IMHEX_SIMD_X86)
+
+        // SSE2 is part of x86_64, AVX2 has to be checked for at runtime
+        inline bool hasAVX2() {
+            static const bool supported = __builtin_cpu_supports("avx2");
+
+            return supported;
+        }
+
+    #elif defined(IMHEX_SIMD_NEON)
+
+        // NEON has no movemask instruction. Weight the bytes of a comparison result by their bit and add them up per half instead
+        inline u16 toBitMask(uint8x16_t mask) {
+            constexpr static u8 Bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+
+            const auto bits = vandq_u8(mask, vld1q_u8(Bits));
+            return u16(vaddv_u8(vget_low_u8(bits))) | (u16(vaddv_u8(vget_high_u8(bits))) << 8);
+        }
+
+    #endif
+
+}
@@ -22,7 +22,7 @@ namespace hex {
 
     Socket::Socket(Socket &&other) noexcept {
         this->m_socket    = other.m_socket;
-        this->m_connected = other.m_connected;
+        this->m_connected = other.m_connected.load();
 
         other.m_socket = SOCKET_NONE;
     }
@@ -31,16 +31,28 @@ namespace hex {
         this->disconnect();
     }
 
+    static void sendAll(auto socket, const char *data, size_t size) {
+        // send() may only accept part of the data if the socket buffer is full
+        while (size > 0) {
+            auto sentSize = ::send(socket, data, size, 0);
+            if (sentSize <= 0)
+                break;
+
+            data += sentSize;
+            size -= sentSize;
+        }
+    }
+
     void Socket::writeBytes(const std::vector<u8> &bytes) const {
         if (!this->isConnected()) return;
 
-        ::send(this->m_socket, reinterpret_cast<const char *>(bytes.data()), bytes.size(), 0);
+        sendAll(this->m_socket, reinterpret_cast<const char *>(bytes.data()), bytes.size());
     }
 
     void Socket::writeString(const std::string &string) const {
         if (!this->isConnected()) return;
 
-        ::send(this->m_socket, string.c_str(), string.length(), 0);
+        sendAll(this->m_socket, string.c_str(), string.length());
     }
 
     std::vector<u8> Socket::readBytes(size_t size) const {
@@ -89,15 +101,31 @@ namespace hex {
         this->m_connected = ::connect(this->m_socket, reinterpret_cast<sockaddr *>(&client), sizeof(client)) == 0;
     }
 
+    void Socket::shutdown() {
+        if (this->m_socket != SOCKET_NONE) {
+#if defined(OS_WINDOWS)
+            ::shutdown(this->m_socket, SD_BOTH);
+#else
+            ::shutdown(this->m_socket, SHUT_RDWR);
+#endif
+        }
+
+        this->m_connected = false;
+    }
+
     void Socket::disconnect() {
         if (this->m_socket != SOCKET_NONE) {
+            // Shutting the socket down first wakes up other threads that are blocked receiving from it
 #if defined(OS_WINDOWS)
+            ::shutdown(this->m_socket, SD_BOTH);
             closesocket(this->m_socket);
 #else
+            ::shutdown(this->m_socket, SHUT_RDWR);
             close(this->m_socket);
 #endif
         }
 
+        this->m_socket    = SOCKET_NONE;
         this->m_connected = false;
     }
 
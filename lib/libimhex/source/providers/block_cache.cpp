@@ -0,0 +1,314 @@
+#include <hex/providers/block_cache.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace hex::prv {
+
+    BlockCache::BlockCache(ReadFunction readFunction, size_t blockSize, size_t capacity, size_t shardCount)
+        : m_readFunction(std::move(readFunction)), m_blockSize(std::max<size_t>(blockSize, 1)), m_capacity(capacity), m_shards(new Shard[std::max<size_t>(shardCount, 1)]), m_shardCount(std::max<size_t>(shardCount, 1)) {
+        this->setCapacity(capacity);
+    }
+
+    BlockCache::Shard &BlockCache::getShard(u64 block) const {
+        return this->m_shards[block % this->m_shardCount];
+    }
+
+    size_t BlockCache::getBlockDataSize(u64 block) const {
+        const u64 blockStart = block * this->m_blockSize;
+        const u64 dataSize   = this->m_dataSize;
+
+        if (blockStart >= dataSize)
+            return 0;
+
+        return std::min<u64>(this->m_blockSize, dataSize - blockStart);
+    }
+
+    bool BlockCache::copyFromBlock(u64 block, u64 offset, u8 *buffer, size_t size) const {
+        auto &shard = this->getShard(block);
+        std::scoped_lock lock(shard.mutex);
+
+        auto it = shard.index.find(block);
+        if (it == shard.index.end())
+            return false;
+
+        const auto &data = it->second->second;
+        if (offset + size > data.size())
+            return false;
+
+        std::memcpy(buffer, data.data() + offset, size);
+        shard.blocks.splice(shard.blocks.begin(), shard.blocks, it->second);
+
+        return true;
+    }
+
+    bool BlockCache::isCached(u64 block) const {
+        auto &shard = this->getShard(block);
+        std::scoped_lock lock(shard.mutex);
+
+        return shard.index.contains(block);
+    }
+
+    void BlockCache::storeBlock(u64 block, const u8 *data, size_t size, u64 generation) {
+        auto &shard = this->getShard(block);
+        std::scoped_lock lock(shard.mutex);
+
+        // The data was fetched before something got invalidated and might be outdated already
+        if (generation != this->m_generation)
+            return;
+
+        if (auto it = shard.index.find(block); it != shard.index.end()) {
+            it->second->second.assign(data, data + size);
+            shard.blocks.splice(shard.blocks.begin(), shard.blocks, it->second);
+            return;
+        }
+
+        if (shard.blocks.size() >= this->m_blocksPerShard) {
+            // Recycle the least recently used block instead of allocating a new one
+            auto last = std::prev(shard.blocks.end());
+            shard.index.erase(last->first);
+
+            last->first = block;
+            last->second.assign(data, data + size);
+            shard.blocks.splice(shard.blocks.begin(), shard.blocks, last);
+        } else {
+            shard.blocks.emplace_front(block, std::vector<u8>(data, data + size));
+        }
+
+        shard.index[block] = shard.blocks.begin();
+    }
+
+    size_t BlockCache::getReadAheadWindow(u64 offset, u64 endOffset) {
+        const auto maxReadAhead = this->m_maxReadAhead.load();
+
+        std::scoped_lock lock(this->m_sequentialMutex);
+
+        // A read is sequential if it starts anywhere within the previous one or right after it. Reads inside a block and
+        // reads that are served from the read-ahead count as well, so the window keeps growing during a scan
+        const bool sequential = offset >= this->m_lastReadOffset && offset <= this->m_lastReadEnd;
+        const bool enteredNewBlock = this->m_lastReadEnd == 0 || (endOffset - 1) / this->m_blockSize > (this->m_lastReadEnd - 1) / this->m_blockSize;
+
+        this->m_lastReadOffset = offset;
+        this->m_lastReadEnd    = std::max(endOffset, sequential ? this->m_lastReadEnd : 0);
+
+        if (maxReadAhead == 0 || !sequential) {
+            this->m_sequentialReads = 0;
+            return 0;
+        }
+
+        // Grow the read-ahead window exponentially, but only once per block so many small reads don't grow it immediately
+        if (enteredNewBlock)
+            this->m_sequentialReads = std::min<u32>(this->m_sequentialReads + 1, 31);
+
+        // Sequential reads that haven't left the block they started in yet don't read ahead
+        if (this->m_sequentialReads == 0)
+            return 0;
+
+        return std::min<size_t>(maxReadAhead, size_t(1) << (this->m_sequentialReads - 1));
+    }
+
+    u64 BlockCache::fetchBlocks(u64 block, u64 fetchLimit, std::vector<u8> &fetchBuffer, const std::function<void(u64 block, const u8 *data)> &onFetched) {
+        // Fetch all consecutive missing blocks, including the read-ahead, with a single backing read
+        u64 fetchEnd = block + 1;
+        while (fetchEnd <= fetchLimit && !this->isCached(fetchEnd))
+            fetchEnd++;
+
+        const u64 fetchStart = block * this->m_blockSize;
+        const u64 fetchSize  = std::min<u64>(fetchEnd * this->m_blockSize, this->m_dataSize) - fetchStart;
+
+        const u64 generation = this->m_generation;
+        fetchBuffer.resize(fetchSize);
+        const auto failedRegions = this->m_readFunction(fetchStart, fetchBuffer.data(), fetchBuffer.size());
+
+        std::vector<bool> failedBlocks(fetchEnd - block, false);
+        for (const auto &region : failedRegions) {
+            const u64 start = std::max<u64>(region.getStartAddress(), fetchStart);
+            const u64 end   = std::min<u64>(region.getStartAddress() + region.getSize(), fetchStart + fetchSize);
+            if (start >= end)
+                continue;
+
+            std::memset(fetchBuffer.data() + (start - fetchStart), 0x00, end - start);
+            for (u64 failedBlock = start / this->m_blockSize; failedBlock <= (end - 1) / this->m_blockSize; failedBlock++)
+                failedBlocks[failedBlock - block] = true;
+        }
+
+        for (u64 fetchedBlock = block; fetchedBlock < fetchEnd; fetchedBlock++) {
+            const auto blockData = fetchBuffer.data() + (fetchedBlock - block) * this->m_blockSize;
+            if (!failedBlocks[fetchedBlock - block])
+                this->storeBlock(fetchedBlock, blockData, this->getBlockDataSize(fetchedBlock), generation);
+
+            onFetched(fetchedBlock, blockData);
+        }
+
+        return fetchEnd;
+    }
+
+    void BlockCache::read(u64 offset, void *buffer, size_t size) {
+        const u64 dataSize = this->m_dataSize;
+        if (size == 0 || offset >= dataSize)
+            return;
+
+        size = std::min<u64>(size, dataSize - offset);
+
+        auto bytes = static_cast<u8 *>(buffer);
+        const u64 endOffset  = offset + size;
+        const u64 firstBlock = offset / this->m_blockSize;
+        const u64 lastBlock  = (endOffset - 1) / this->m_blockSize;
+        const u64 lastDataBlock = (dataSize - 1) / this->m_blockSize;
+        const u64 fetchLimit = std::min<u64>(lastBlock + this->getReadAheadWindow(offset, endOffset), lastDataBlock);
+
+        auto getCopyRange = [&](u64 block) {
+            const u64 blockStart = block * this->m_blockSize;
+
+            return std::pair { std::max(blockStart, offset) - blockStart, std::min<u64>(blockStart + this->m_blockSize, endOffset) - blockStart };
+        };
+
+        auto onFetched = [&](u64 fetchedBlock, const u8 *blockData) {
+            if (fetchedBlock <= lastBlock) {
+                auto [copyStart, copyEnd] = getCopyRange(fetchedBlock);
+                std::memcpy(bytes + (fetchedBlock * this->m_blockSize + copyStart - offset), blockData + copyStart, copyEnd - copyStart);
+                this->m_misses++;
+                if (this->m_statistics != nullptr)
+                    this->m_statistics->recordCacheMisses();
+            } else {
+                this->m_readAheads++;
+            }
+        };
+
+        std::vector<u8> fetchBuffer;
+        u64 block = firstBlock;
+        while (block <= lastBlock) {
+            if (auto [copyStart, copyEnd] = getCopyRange(block); this->copyFromBlock(block, copyStart, bytes + (block * this->m_blockSize + copyStart - offset), copyEnd - copyStart)) {
+                this->m_hits++;
+                if (this->m_statistics != nullptr)
+                    this->m_statistics->recordCacheHits();
+
+                block++;
+                continue;
+            }
+
+            block = this->fetchBlocks(block, fetchLimit, fetchBuffer, onFetched);
+        }
+
+        // A scan that's entirely served by the read-ahead tops it up once it reaches its end instead of stalling on the next miss
+        if (block <= fetchLimit && !this->isCached(block))
+            this->fetchBlocks(block, fetchLimit, fetchBuffer, onFetched);
+    }
+
+    void BlockCache::invalidate(u64 offset, size_t size) {
+        if (size == 0)
+            return;
+
+        const u64 firstBlock = offset / this->m_blockSize;
+        const u64 lastBlock  = (offset + size - 1) / this->m_blockSize;
+
+        this->m_generation++;
+
+        if (lastBlock - firstBlock >= this->m_blocksPerShard * this->m_shardCount) {
+            this->clear();
+            return;
+        }
+
+        for (u64 block = firstBlock; block <= lastBlock; block++) {
+            auto &shard = this->getShard(block);
+            std::scoped_lock lock(shard.mutex);
+
+            if (auto it = shard.index.find(block); it != shard.index.end()) {
+                shard.blocks.erase(it->second);
+                shard.index.erase(it);
+            }
+        }
+    }
+
+    void BlockCache::clear() {
+        this->m_generation++;
+
+        for (size_t i = 0; i < this->m_shardCount; i++) {
+            auto &shard = this->m_shards[i];
+            std::scoped_lock lock(shard.mutex);
+
+            shard.blocks.clear();
+            shard.index.clear();
+        }
+
+        std::scoped_lock lock(this->m_sequentialMutex);
+        this->m_lastReadOffset  = 0;
+        this->m_lastReadEnd     = 0;
+        this->m_sequentialReads = 0;
+    }
+
+    std::vector<u64> BlockCache::getCachedBlocks(size_t maxCount) const {
+        std::vector<std::vector<u64>> shardBlocks(this->m_shardCount);
+        for (size_t i = 0; i < this->m_shardCount; i++) {
+            auto &shard = this->m_shards[i];
+            std::scoped_lock lock(shard.mutex);
+
+            for (auto it = shard.blocks.begin(); it != shard.blocks.end() && shardBlocks[i].size() < maxCount; ++it)
+                shardBlocks[i].push_back(it->first);
+        }
+
+        // Consecutive blocks are spread over all shards, so taking them round robin keeps the most recently used ones together
+        std::vector<u64> result;
+        for (size_t index = 0; result.size() < maxCount; index++) {
+            bool found = false;
+            for (size_t i = 0; i < this->m_shardCount && result.size() < maxCount; i++) {
+                if (index < shardBlocks[i].size()) {
+                    result.push_back(shardBlocks[i][index]);
+                    found = true;
+                }
+            }
+
+            if (!found)
+                break;
+        }
+
+        return result;
+    }
+
+    bool BlockCache::refreshBlock(u64 block, const void *data, size_t size, u64 generation) {
+        auto &shard = this->getShard(block);
+        std::scoped_lock lock(shard.mutex);
+
+        if (generation != this->m_generation)
+            return false;
+
+        auto it = shard.index.find(block);
+        if (it == shard.index.end())
+            return false;
+
+        auto bytes = static_cast<const u8 *>(data);
+        it->second->second.assign(bytes, bytes + std::min(size, this->getBlockDataSize(block)));
+
+        return true;
+    }
+
+    void BlockCache::setDataSize(u64 size) {
+        const u64 oldSize = this->m_dataSize.exchange(size);
+
+        if (size > oldSize) {
+            // Growing only affects the previously last block, which may have been stored partially
+            if (oldSize % this->m_blockSize != 0)
+                this->invalidate(oldSize, 1);
+        } else if (size < oldSize) {
+            this->clear();
+        }
+    }
+
+    void BlockCache::setCapacity(size_t capacity) {
+        this->m_capacity = capacity;
+
+        const auto blocksPerShard = std::max<size_t>(capacity / this->m_blockSize / this->m_shardCount, 1);
+        for (size_t i = 0; i < this->m_shardCount; i++) {
+            auto &shard = this->m_shards[i];
+            std::scoped_lock lock(shard.mutex);
+
+            while (shard.blocks.size() > blocksPerShard) {
+                shard.index.erase(shard.blocks.back().first);
+                shard.blocks.pop_back();
+            }
+        }
+
+        this->m_blocksPerShard = blocksPerShard;
+    }
+
+}
@@ -0,0 +1,104 @@
+#include <hex/providers/io_statistics.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace hex::prv {
+
+    static thread_local IOSubsystem s_currentSubsystem = IOSubsystem::Other;
+
+    IOStatistics::ScopedSubsystem::ScopedSubsystem(IOSubsystem subsystem) : m_previousSubsystem(s_currentSubsystem) {
+        s_currentSubsystem = subsystem;
+    }
+
+    IOStatistics::ScopedSubsystem::~ScopedSubsystem() {
+        s_currentSubsystem = this->m_previousSubsystem;
+    }
+
+    IOStatistics::ScopedOperation::ScopedOperation(IOStatistics &statistics, Operation operation, size_t size)
+        : m_statistics(statistics), m_operation(operation), m_size(size), m_startTime(std::chrono::steady_clock::now()) {
+    }
+
+    IOStatistics::ScopedOperation::~ScopedOperation() {
+        this->m_statistics.record(this->m_operation, this->m_size, std::chrono::steady_clock::now() - this->m_startTime);
+    }
+
+
+    IOSubsystem IOStatistics::getCurrentSubsystem() {
+        return s_currentSubsystem;
+    }
+
+    void IOStatistics::record(Operation operation, size_t size, std::chrono::nanoseconds duration) {
+        auto &counters = this->m_counters[size_t(getCurrentSubsystem())];
+        const auto nanoseconds = u64(std::max<i64>(duration.count(), 0));
+
+        switch (operation) {
+            case Operation::Read:
+                counters.readCalls++;
+                counters.bytesRead += size;
+                counters.readTime += nanoseconds;
+                break;
+            case Operation::Write:
+                counters.writeCalls++;
+                counters.bytesWritten += size;
+                counters.writeTime += nanoseconds;
+                break;
+        }
+
+        const auto bucket = std::min<size_t>(std::bit_width(nanoseconds / 1000), LatencyBucketCount - 1);
+        this->m_latencyHistogram[bucket]++;
+    }
+
+    IOStatistics::Counters IOStatistics::getCounters(IOSubsystem subsystem) const {
+        const auto &counters = this->m_counters[size_t(subsystem)];
+
+        return {
+            counters.readCalls, counters.writeCalls,
+            counters.bytesRead, counters.bytesWritten,
+            std::chrono::nanoseconds(counters.readTime), std::chrono::nanoseconds(counters.writeTime)
+        };
+    }
+
+    IOStatistics::Counters IOStatistics::getTotalCounters() const {
+        Counters result = { };
+
+        for (size_t i = 0; i < size_t(IOSubsystem::Count); i++) {
+            auto counters = this->getCounters(IOSubsystem(i));
+
+            result.readCalls    += counters.readCalls;
+            result.writeCalls   += counters.writeCalls;
+            result.bytesRead    += counters.bytesRead;
+            result.bytesWritten += counters.bytesWritten;
+            result.readTime     += counters.readTime;
+            result.writeTime    += counters.writeTime;
+        }
+
+        return result;
+    }
+
+    std::array<u64, IOStatistics::LatencyBucketCount> IOStatistics::getLatencyHistogram() const {
+        std::array<u64, LatencyBucketCount> result = { };
+        for (size_t i = 0; i < LatencyBucketCount; i++)
+            result[i] = this->m_latencyHistogram[i];
+
+        return result;
+    }
+
+    void IOStatistics::reset() {
+        for (auto &counters : this->m_counters) {
+            counters.readCalls  = 0;
+            counters.writeCalls = 0;
+            counters.bytesRead  = 0;
+            counters.bytesWritten = 0;
+            counters.readTime   = 0;
+            counters.writeTime  = 0;
+        }
+
+        for (auto &bucket : this->m_latencyHistogram)
+            bucket = 0;
+
+        this->m_cacheHits   = 0;
+        this->m_cacheMisses = 0;
+    }
+
+}
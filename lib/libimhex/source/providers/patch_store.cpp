@@ -0,0 +1,273 @@
+#include <hex/providers/patch_store.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace hex::prv {
+
+    PatchStore::PatchStore(const PatchStore &other) {
+        std::scoped_lock lock(other.m_mutex);
+
+        this->m_runs         = other.m_runs;
+        this->m_patchedBytes = other.m_patchedBytes;
+        this->m_generation   = other.m_generation.load();
+    }
+
+    PatchStore &PatchStore::operator=(const PatchStore &other) {
+        if (this == &other)
+            return *this;
+
+        std::scoped_lock lock(this->m_mutex, other.m_mutex);
+
+        this->m_runs         = other.m_runs;
+        this->m_patchedBytes = other.m_patchedBytes;
+        this->m_generation   = std::max(this->m_generation.load(), other.m_generation.load()) + 1;
+
+        return *this;
+    }
+
+    PatchStore::Runs &PatchStore::detach() {
+        if (this->m_runs.use_count() > 1)
+            this->m_runs = std::make_shared<Runs>(*this->m_runs);
+
+        this->m_generation++;
+
+        return *this->m_runs;
+    }
+
+    PatchStore::Runs::iterator PatchStore::findFirstRun(u64 address, bool includeAdjacent) {
+        auto it = this->m_runs->upper_bound(address);
+
+        if (it != this->m_runs->begin()) {
+            auto prev = std::prev(it);
+            const auto prevEnd = prev->first + prev->second.size();
+
+            if (prevEnd > address || (includeAdjacent && prevEnd == address))
+                it = prev;
+        }
+
+        return it;
+    }
+
+    PatchStore::Runs::const_iterator PatchStore::findFirstRun(u64 address) const {
+        const auto &runs = *this->m_runs;
+        auto it = runs.upper_bound(address);
+
+        if (it != runs.begin()) {
+            auto prev = std::prev(it);
+            if (prev->first + prev->second.size() > address)
+                it = prev;
+        }
+
+        return it;
+    }
+
+    void PatchStore::write(u64 address, const void *buffer, size_t size) {
+        if (size == 0)
+            return;
+
+        std::scoped_lock lock(this->m_mutex);
+        auto &runs = this->detach();
+
+        const auto bytes = static_cast<const u8 *>(buffer);
+        const u64 endAddress = address + size;
+
+        // Find all runs that overlap or touch the new run
+        auto first = this->findFirstRun(address, true);
+        auto last  = first;
+        while (last != runs.end() && last->first <= endAddress)
+            ++last;
+
+        if (first == last) {
+            runs.emplace_hint(last, address, std::vector<u8>(bytes, bytes + size));
+            this->m_patchedBytes += size;
+
+            return;
+        }
+
+        const auto &lastRun = *std::prev(last);
+        const u64 runStart  = std::min(address, first->first);
+        const u64 runEnd    = std::max<u64>(endAddress, lastRun.first + lastRun.second.size());
+
+        for (auto it = first; it != last; ++it)
+            this->m_patchedBytes -= it->second.size();
+        this->m_patchedBytes += runEnd - runStart;
+
+        if (first->first == runStart) {
+            // Grow the first run in place and merge all following runs into it
+            auto &data = first->second;
+            data.resize(runEnd - runStart);
+
+            for (auto it = std::next(first); it != last; ++it)
+                std::memcpy(data.data() + (it->first - runStart), it->second.data(), it->second.size());
+            std::memcpy(data.data() + (address - runStart), bytes, size);
+
+            runs.erase(std::next(first), last);
+        } else {
+            std::vector<u8> data(runEnd - runStart);
+
+            for (auto it = first; it != last; ++it)
+                std::memcpy(data.data() + (it->first - runStart), it->second.data(), it->second.size());
+            std::memcpy(data.data(), bytes, size);
+
+            runs.emplace_hint(runs.erase(first, last), runStart, std::move(data));
+        }
+    }
+
+    void PatchStore::erase(u64 address, size_t size) {
+        if (size == 0)
+            return;
+
+        std::scoped_lock lock(this->m_mutex);
+        this->detach();
+
+        this->eraseRuns(address, size);
+    }
+
+    void PatchStore::eraseRuns(u64 address, size_t size) {
+        auto &runs = *this->m_runs;
+        const u64 endAddress = address + size;
+
+        auto it = this->findFirstRun(address, false);
+        while (it != runs.end() && it->first < endAddress) {
+            const u64 runStart = it->first;
+            const u64 runEnd   = runStart + it->second.size();
+
+            this->m_patchedBytes -= std::min(runEnd, endAddress) - std::max(runStart, address);
+
+            std::vector<u8> tail;
+            if (runEnd > endAddress)
+                tail.assign(it->second.begin() + (endAddress - runStart), it->second.end());
+
+            if (runStart < address) {
+                it->second.resize(address - runStart);
+                ++it;
+            } else {
+                it = runs.erase(it);
+            }
+
+            if (!tail.empty()) {
+                runs.emplace_hint(it, endAddress, std::move(tail));
+                break;
+            }
+        }
+    }
+
+    void PatchStore::clear() {
+        std::scoped_lock lock(this->m_mutex);
+
+        // Copies keep referring to the old runs so there's no need to copy them first
+        this->m_runs = std::make_shared<Runs>();
+        this->m_patchedBytes = 0;
+        this->m_generation++;
+    }
+
+    void PatchStore::insert(u64 address, size_t size) {
+        if (size == 0)
+            return;
+
+        std::scoped_lock lock(this->m_mutex);
+        auto &runs = this->detach();
+
+        // Split a run that spans the insertion point so its tail can be moved
+        if (auto it = this->findFirstRun(address, false); it != runs.end() && it->first < address) {
+            std::vector<u8> tail(it->second.begin() + (address - it->first), it->second.end());
+            it->second.resize(address - it->first);
+            runs.emplace(address, std::move(tail));
+        }
+
+        Runs movedRuns;
+        for (auto it = runs.lower_bound(address); it != runs.end();) {
+            auto node = runs.extract(it++);
+            node.key() += size;
+            movedRuns.insert(movedRuns.end(), std::move(node));
+        }
+
+        runs.merge(movedRuns);
+    }
+
+    void PatchStore::remove(u64 address, size_t size) {
+        if (size == 0)
+            return;
+
+        std::scoped_lock lock(this->m_mutex);
+        auto &runs = this->detach();
+
+        this->eraseRuns(address, size);
+
+        Runs movedRuns;
+        for (auto it = runs.lower_bound(address + size); it != runs.end();) {
+            auto node = runs.extract(it++);
+            node.key() -= size;
+            movedRuns.insert(movedRuns.end(), std::move(node));
+        }
+
+        runs.merge(movedRuns);
+
+        // Merge the two runs that became adjacent at the removal point
+        auto right = runs.find(address);
+        if (right != runs.end() && right != runs.begin()) {
+            auto left = std::prev(right);
+            if (left->first + left->second.size() == address) {
+                left->second.insert(left->second.end(), right->second.begin(), right->second.end());
+                runs.erase(right);
+            }
+        }
+    }
+
+    void PatchStore::apply(u64 address, void *buffer, size_t size) const {
+        const auto &runs = *this->m_runs;
+        if (size == 0 || runs.empty())
+            return;
+
+        const u64 endAddress = address + size;
+        auto bytes = static_cast<u8 *>(buffer);
+
+        for (auto it = this->findFirstRun(address); it != runs.end() && it->first < endAddress; ++it) {
+            const u64 overlapStart = std::max(it->first, address);
+            const u64 overlapEnd   = std::min<u64>(it->first + it->second.size(), endAddress);
+
+            std::memcpy(bytes + (overlapStart - address), it->second.data() + (overlapStart - it->first), overlapEnd - overlapStart);
+        }
+    }
+
+    std::optional<u8> PatchStore::get(u64 address) const {
+        const auto &runs = *this->m_runs;
+        auto it = this->findFirstRun(address);
+        if (it == runs.end() || it->first > address)
+            return std::nullopt;
+
+        return it->second[address - it->first];
+    }
+
+    bool PatchStore::contains(u64 address) const {
+        return this->get(address).has_value();
+    }
+
+    std::optional<u64> PatchStore::getNextPatchAddress(u64 address) const {
+        const auto &runs = *this->m_runs;
+        auto it = this->findFirstRun(address);
+        if (it == runs.end())
+            return std::nullopt;
+
+        return std::max(it->first, address);
+    }
+
+    PatchStore::RunList PatchStore::getRuns(u64 address, size_t size) const {
+        const auto &runs = *this->m_runs;
+        RunList result;
+
+        const u64 endAddress = address + size;
+        for (auto it = this->findFirstRun(address); it != runs.end() && it->first < endAddress; ++it) {
+            const u64 overlapStart = std::max(it->first, address);
+            const u64 overlapEnd   = std::min<u64>(it->first + it->second.size(), endAddress);
+
+            const auto begin = it->second.begin() + (overlapStart - it->first);
+            result.emplace_back(overlapStart, std::vector<u8>(begin, begin + (overlapEnd - overlapStart)));
+        }
+
+        return result;
+    }
+
+}
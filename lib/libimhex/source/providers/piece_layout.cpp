@@ -0,0 +1,185 @@
+#include <hex/providers/piece_layout.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace hex::prv {
+
+    PieceLayout::PieceLayout(std::shared_ptr<const OriginalData> original, u64 originalSize) : m_original(std::move(original)) {
+        this->m_pieces.reset(originalSize);
+    }
+
+    void PieceLayout::read(u64 offset, void *buffer, size_t size, bool sequential) const {
+        if (buffer == nullptr || size == 0)
+            return;
+
+        // Anything past the end reads as zeros, so readers that checked the size against a newer layout still get defined data
+        if (offset >= this->getSize()) {
+            std::memset(buffer, 0x00, size);
+            return;
+        }
+
+        if (offset + size > this->getSize()) {
+            const auto readSize = this->getSize() - offset;
+            std::memset(static_cast<u8 *>(buffer) + readSize, 0x00, size - readSize);
+            size = readSize;
+        }
+
+        if (this->m_pieces.isIdentity()) {
+            this->m_original->read(offset, buffer, size, sequential);
+            return;
+        }
+
+        auto bytes = static_cast<u8 *>(buffer);
+        this->m_pieces.forEachPiece(offset, size, [&](u64 pieceOffset, const auto &piece) {
+            if (piece.source == PieceTable::Source::Original)
+                this->m_original->read(piece.offset, bytes + (pieceOffset - offset), piece.size, sequential);
+            else
+                this->readAdded(piece.offset, bytes + (pieceOffset - offset), piece.size);
+        });
+    }
+
+    std::vector<Region> PieceLayout::getDataRegions(u64 offset, size_t size) const {
+        if (this->m_pieces.isIdentity())
+            return this->m_original->getDataRegions(offset, size);
+
+        std::vector<Region> regions;
+        this->m_pieces.forEachPiece(offset, size, [&](u64 pieceOffset, const auto &piece) {
+            if (piece.source == PieceTable::Source::Added) {
+                regions.push_back({ pieceOffset, piece.size });
+                return;
+            }
+
+            for (const auto &region : this->m_original->getDataRegions(piece.offset, piece.size))
+                regions.push_back({ pieceOffset + (region.address - piece.offset), region.size });
+        });
+
+        return regions;
+    }
+
+    // Number of chunks below each child of a node at the given depth
+    static u64 getChildSpan(u64 fanOut, u32 depth) {
+        u64 span = 1;
+        for (u32 i = 1; i < depth; i++)
+            span *= fanOut;
+
+        return span;
+    }
+
+    std::shared_ptr<const PieceLayout> PieceLayout::insert(u64 offset, u64 size) const {
+        auto layout = std::make_shared<PieceLayout>(*this);
+        if (size == 0)
+            return layout;
+
+        layout->m_pieces.insert(offset, PieceTable::Source::Added, this->m_addedSize, size);
+        layout->m_addedSize += size;
+
+        // Add levels on top of the chunk tree until it can address all added bytes. The existing tree becomes the first child
+        while (getChildSpan(AddedFanOut, layout->m_addedDepth + 1) * AddedChunkSize < layout->m_addedSize) {
+            if (layout->m_addedRoot != nullptr) {
+                auto root = std::make_shared<AddedNode>();
+                root->children.resize(AddedFanOut);
+                root->children[0] = std::move(layout->m_addedRoot);
+
+                layout->m_addedRoot = std::move(root);
+            }
+
+            layout->m_addedDepth++;
+        }
+
+        return layout;
+    }
+
+    std::shared_ptr<const PieceLayout> PieceLayout::remove(u64 offset, u64 size) const {
+        auto layout = std::make_shared<PieceLayout>(*this);
+        layout->m_pieces.remove(offset, size);
+
+        return layout;
+    }
+
+    std::shared_ptr<const PieceLayout> PieceLayout::appendOriginal(u64 size) const {
+        auto layout = std::make_shared<PieceLayout>(*this);
+        layout->m_pieces.appendOriginal(size);
+
+        return layout;
+    }
+
+    std::shared_ptr<const PieceLayout::AddedNode> PieceLayout::writeAddedChunk(const AddedNode *node, u32 depth, u64 chunk, u64 chunkOffset, const u8 *bytes, size_t size) {
+        auto copy = std::make_shared<AddedNode>();
+
+        if (depth == 0) {
+            if (node != nullptr)
+                copy->data = node->data;
+            else
+                copy->data.resize(AddedChunkSize, 0x00);
+
+            std::memcpy(copy->data.data() + chunkOffset, bytes, size);
+        } else {
+            if (node != nullptr)
+                copy->children = node->children;
+            else
+                copy->children.resize(AddedFanOut);
+
+            const auto span = getChildSpan(AddedFanOut, depth);
+            auto &child = copy->children[chunk / span];
+            child = writeAddedChunk(child.get(), depth - 1, chunk % span, chunkOffset, bytes, size);
+        }
+
+        return copy;
+    }
+
+    const PieceLayout::AddedNode *PieceLayout::findAddedChunk(u64 chunk) const {
+        const AddedNode *node = this->m_addedRoot.get();
+        for (u32 depth = this->m_addedDepth; depth > 0 && node != nullptr; depth--) {
+            const auto span = getChildSpan(AddedFanOut, depth);
+
+            node = node->children[chunk / span].get();
+            chunk %= span;
+        }
+
+        return node;
+    }
+
+    std::shared_ptr<const PieceLayout> PieceLayout::writeAdded(u64 addedOffset, const void *buffer, size_t size) const {
+        auto layout = std::make_shared<PieceLayout>(*this);
+
+        auto bytes = static_cast<const u8 *>(buffer);
+        const u64 endOffset = std::min<u64>(addedOffset + size, this->m_addedSize);
+
+        // Layouts that still share the touched chunks keep their data
+        for (u64 offset = addedOffset; offset < endOffset;) {
+            const u64 chunkOffset = offset % AddedChunkSize;
+            const u64 chunkSize   = std::min<u64>(AddedChunkSize - chunkOffset, endOffset - offset);
+
+            layout->m_addedRoot = writeAddedChunk(layout->m_addedRoot.get(), layout->m_addedDepth, offset / AddedChunkSize, chunkOffset, bytes + (offset - addedOffset), chunkSize);
+            offset += chunkSize;
+        }
+
+        return layout;
+    }
+
+    void PieceLayout::readAdded(u64 addedOffset, void *buffer, size_t size) const {
+        auto bytes = static_cast<u8 *>(buffer);
+
+        for (u64 offset = addedOffset; offset < addedOffset + size;) {
+            const u64 chunkOffset = offset % AddedChunkSize;
+            const u64 chunkSize   = std::min<u64>(AddedChunkSize - chunkOffset, addedOffset + size - offset);
+
+            auto chunk = offset < this->m_addedSize ? this->findAddedChunk(offset / AddedChunkSize) : nullptr;
+            if (chunk != nullptr)
+                std::memcpy(bytes + (offset - addedOffset), chunk->data.data() + chunkOffset, chunkSize);
+            else
+                std::memset(bytes + (offset - addedOffset), 0x00, chunkSize);
+
+            offset += chunkSize;
+        }
+    }
+
+    std::shared_ptr<const PieceLayout> PieceLayout::withOriginal(std::shared_ptr<const OriginalData> original) const {
+        auto layout = std::make_shared<PieceLayout>(*this);
+        layout->m_original = std::move(original);
+
+        return layout;
+    }
+
+}
@@ -0,0 +1,188 @@
+#include <hex/providers/piece_table.hpp>
+
+#include <algorithm>
+
+namespace hex::prv {
+
+    void PieceTable::reset(u64 originalSize) {
+        this->m_root = nullptr;
+        this->m_originalSize = originalSize;
+
+        if (originalSize > 0)
+            this->m_root = this->createNode({ Source::Original, 0, originalSize });
+    }
+
+    PieceTable::NodePtr PieceTable::createNode(const Piece &piece, u32 priority, NodePtr left, NodePtr right) {
+        const auto subtreeSize   = getSubtreeSize(left) + piece.size + getSubtreeSize(right);
+        const auto subtreePieces = getSubtreePieces(left) + 1 + getSubtreePieces(right);
+
+        return std::make_shared<const Node>(Node { piece, priority, std::move(left), std::move(right), subtreeSize, subtreePieces });
+    }
+
+    PieceTable::NodePtr PieceTable::createNode(const Piece &piece) {
+        return createNode(piece, u32(this->m_random()), nullptr, nullptr);
+    }
+
+    u64 PieceTable::getSubtreeSize(const NodePtr &node) {
+        return node == nullptr ? 0 : node->subtreeSize;
+    }
+
+    size_t PieceTable::getSubtreePieces(const NodePtr &node) {
+        return node == nullptr ? 0 : node->subtreePieces;
+    }
+
+    std::pair<PieceTable::NodePtr, PieceTable::NodePtr> PieceTable::split(const NodePtr &node, u64 offset) {
+        if (node == nullptr)
+            return { nullptr, nullptr };
+
+        const auto leftSize  = getSubtreeSize(node->left);
+        const auto pieceSize = node->piece.size;
+
+        if (offset == 0)
+            return { nullptr, node };
+        if (offset >= node->subtreeSize)
+            return { node, nullptr };
+
+        if (offset <= leftSize) {
+            auto [left, right] = this->split(node->left, offset);
+            return { left, createNode(node->piece, node->priority, right, node->right) };
+        } else if (offset >= leftSize + pieceSize) {
+            auto [left, right] = this->split(node->right, offset - leftSize - pieceSize);
+            return { createNode(node->piece, node->priority, node->left, left), right };
+        } else {
+            // The split point lies inside of this node's piece, cut it in two
+            const auto cut = offset - leftSize;
+            const auto &piece = node->piece;
+
+            auto head = createNode({ piece.source, piece.offset, cut }, node->priority, node->left, nullptr);
+            auto tail = this->createNode({ piece.source, piece.offset + cut, piece.size - cut });
+
+            return { head, merge(tail, node->right) };
+        }
+    }
+
+    PieceTable::NodePtr PieceTable::merge(const NodePtr &left, const NodePtr &right) {
+        if (left == nullptr)
+            return right;
+        if (right == nullptr)
+            return left;
+
+        if (left->priority > right->priority)
+            return createNode(left->piece, left->priority, left->left, merge(left->right, right));
+        else
+            return createNode(right->piece, right->priority, merge(left, right->left), right->right);
+    }
+
+    PieceTable::NodePtr PieceTable::growLastPiece(const NodePtr &node, u64 size) {
+        if (node->right != nullptr)
+            return createNode(node->piece, node->priority, node->left, growLastPiece(node->right, size));
+
+        auto piece = node->piece;
+        piece.size += size;
+
+        return createNode(piece, node->priority, node->left, nullptr);
+    }
+
+    PieceTable::NodePtr PieceTable::mergeCoalescing(const NodePtr &left, NodePtr right) {
+        if (left == nullptr || right == nullptr)
+            return merge(left, right);
+
+        const Node *last = left.get();
+        while (last->right != nullptr)
+            last = last->right.get();
+
+        const Node *first = right.get();
+        while (first->left != nullptr)
+            first = first->left.get();
+
+        const auto firstPiece = first->piece;
+        const auto &lastPiece = last->piece;
+
+        if (lastPiece.source == firstPiece.source && lastPiece.offset + lastPiece.size == firstPiece.offset) {
+            right = this->split(right, firstPiece.size).second;
+
+            return merge(growLastPiece(left, firstPiece.size), right);
+        }
+
+        return merge(left, right);
+    }
+
+    void PieceTable::insert(u64 offset, Source source, u64 sourceOffset, u64 size) {
+        if (size == 0)
+            return;
+
+        offset = std::min(offset, this->getSize());
+
+        auto [left, right] = this->split(this->m_root, offset);
+        auto node = this->createNode({ source, sourceOffset, size });
+
+        this->m_root = this->mergeCoalescing(this->mergeCoalescing(left, node), right);
+    }
+
+    void PieceTable::remove(u64 offset, u64 size) {
+        if (size == 0 || offset >= this->getSize())
+            return;
+
+        auto [left, rest] = this->split(this->m_root, offset);
+        auto right = this->split(rest, size).second;
+
+        // Removing what was inserted before leaves the original pieces around it contiguous again
+        this->m_root = this->mergeCoalescing(left, right);
+    }
+
+    void PieceTable::appendOriginal(u64 size) {
+        if (size == 0)
+            return;
+
+        // Joins the last piece if that one ends where the original data used to end
+        this->insert(this->getSize(), Source::Original, this->m_originalSize, size);
+
+        this->m_originalSize += size;
+    }
+
+    void PieceTable::visit(const NodePtr &node, u64 nodeOffset, u64 offset, u64 endOffset, const PieceCallback &callback) {
+        if (node == nullptr)
+            return;
+
+        if (nodeOffset >= endOffset || nodeOffset + node->subtreeSize <= offset)
+            return;
+
+        visit(node->left, nodeOffset, offset, endOffset, callback);
+
+        const auto pieceStart = nodeOffset + getSubtreeSize(node->left);
+        const auto pieceEnd   = pieceStart + node->piece.size;
+        const auto start = std::max(pieceStart, offset);
+        const auto end   = std::min(pieceEnd, endOffset);
+        if (start < end)
+            callback(start, { node->piece.source, node->piece.offset + (start - pieceStart), end - start });
+
+        visit(node->right, pieceEnd, offset, endOffset, callback);
+    }
+
+    void PieceTable::forEachPiece(u64 offset, u64 size, const PieceCallback &callback) const {
+        if (size == 0)
+            return;
+
+        visit(this->m_root, 0, offset, offset + size, callback);
+    }
+
+    u64 PieceTable::getSize() const {
+        return getSubtreeSize(this->m_root);
+    }
+
+    size_t PieceTable::getPieceCount() const {
+        return getSubtreePieces(this->m_root);
+    }
+
+    bool PieceTable::isIdentity() const {
+        if (this->m_root == nullptr)
+            return this->m_originalSize == 0;
+
+        if (this->m_root->subtreePieces != 1)
+            return false;
+
+        const auto &piece = this->m_root->piece;
+        return piece.source == Source::Original && piece.offset == 0 && piece.size == this->m_originalSize;
+    }
+
+}
@@ -2,7 +2,10 @@
 
 #include <hex.hpp>
 #include <hex/api/event.hpp>
+#include <hex/helpers/literals.hpp>
+#include <hex/helpers/utils.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <map>
@@ -10,24 +13,102 @@
 
 namespace hex::prv {
 
+    using namespace hex::literals;
+
     u32 Provider::s_idCounter = 0;
 
     Provider::Provider() : m_id(s_idCounter++) {
-        this->m_patches.emplace_back();
     }
 
     Provider::~Provider() {
-        for (auto &overlay : this->m_overlays)
-            this->deleteOverlay(overlay);
+        this->waitForAsyncReads();
+
+        for (auto overlay : this->m_overlays)
+            delete overlay;
     }
 
     void Provider::read(u64 offset, void *buffer, size_t size, bool overlays) {
         hex::unused(overlays);
 
+        IOStatistics::ScopedOperation operation(this->m_ioStatistics, IOStatistics::Operation::Read, size);
         this->readRaw(offset - this->getBaseAddress(), buffer, size);
     }
 
+    void Provider::readMany(std::span<const ReadRequest> requests, bool overlays) {
+        constexpr static size_t MaxGap = 4_KiB;
+        constexpr static size_t MaxCoalescedSize = 16_MiB;
+
+        std::vector<const ReadRequest *> sortedRequests;
+        sortedRequests.reserve(requests.size());
+        for (const auto &request : requests) {
+            if (request.size > 0 && request.buffer != nullptr)
+                sortedRequests.push_back(&request);
+        }
+
+        std::sort(sortedRequests.begin(), sortedRequests.end(), [](auto a, auto b) { return a->offset < b->offset; });
+
+        // Requests that are close to each other are served with a single read so slow providers only pay the latency once
+        std::vector<u8> buffer;
+        for (auto it = sortedRequests.begin(); it != sortedRequests.end();) {
+            const u64 runStart = (*it)->offset;
+            u64 runEnd = runStart + (*it)->size;
+
+            auto runEndIt = std::next(it);
+            while (runEndIt != sortedRequests.end() && (*runEndIt)->offset <= runEnd + MaxGap && std::max<u64>(runEnd, (*runEndIt)->offset + (*runEndIt)->size) - runStart <= MaxCoalescedSize) {
+                runEnd = std::max<u64>(runEnd, (*runEndIt)->offset + (*runEndIt)->size);
+                ++runEndIt;
+            }
+
+            if (std::next(it) == runEndIt) {
+                this->read((*it)->offset, (*it)->buffer, (*it)->size, overlays);
+            } else {
+                buffer.resize(runEnd - runStart);
+                this->read(runStart, buffer.data(), buffer.size(), overlays);
+
+                for (auto request = it; request != runEndIt; ++request)
+                    std::memcpy((*request)->buffer, buffer.data() + ((*request)->offset - runStart), (*request)->size);
+            }
+
+            it = runEndIt;
+        }
+    }
+
+    void Provider::readSequential(u64 offset, void *buffer, size_t size, bool overlays) {
+        this->read(offset, buffer, size, overlays);
+    }
+
+    void Provider::readRawSequential(u64 offset, void *buffer, size_t size) {
+        this->readRaw(offset, buffer, size);
+    }
+
+    std::future<std::vector<u8>> Provider::readAsync(u64 offset, size_t size, bool overlays) {
+        {
+            std::scoped_lock lock(this->m_asyncReadMutex);
+            this->m_asyncReads++;
+        }
+
+        return std::async(std::launch::async, [this, offset, size, overlays] {
+            // The provider waits for this before it gets closed, so nothing may touch it after the counter went down
+            ON_SCOPE_EXIT {
+                std::scoped_lock lock(this->m_asyncReadMutex);
+                this->m_asyncReads--;
+                this->m_asyncReadsDone.notify_all();
+            };
+
+            std::vector<u8> buffer(size);
+            this->read(offset, buffer.data(), buffer.size(), overlays);
+
+            return buffer;
+        });
+    }
+
+    void Provider::waitForAsyncReads() {
+        std::unique_lock lock(this->m_asyncReadMutex);
+        this->m_asyncReadsDone.wait(lock, [this] { return this->m_asyncReads == 0; });
+    }
+
     void Provider::write(u64 offset, const void *buffer, size_t size) {
+        IOStatistics::ScopedOperation operation(this->m_ioStatistics, IOStatistics::Operation::Write, size);
         this->writeRaw(offset - this->getBaseAddress(), buffer, size);
         this->markDirty();
     }
@@ -44,43 +125,37 @@ namespace hex::prv {
     }
 
     void Provider::insert(u64 offset, size_t size) {
-        auto &patches = getPatches();
-
-        std::vector<std::pair<u64, u8>> patchesToMove;
-
-        for (auto &[address, value] : patches) {
-            if (address > offset)
-                patchesToMove.emplace_back(address, value);
-        }
-
-        for (const auto &[address, value] : patchesToMove)
-            patches.erase(address);
-        for (const auto &[address, value] : patchesToMove)
-            patches.insert({ address + size, value });
+        // Recorded deltas refer to addresses before the shift and can't be replayed anymore
+        this->m_patches.insert(offset, size);
+        this->m_undoJournal.clear();
 
         this->markDirty();
     }
 
     void Provider::remove(u64 offset, size_t size) {
-        auto &patches = getPatches();
-
-        std::vector<std::pair<u64, u8>> patchesToMove;
-
-        for (auto &[address, value] : patches) {
-            if (address > offset)
-                patchesToMove.emplace_back(address, value);
-        }
-
-        for (const auto &[address, value] : patchesToMove)
-            patches.erase(address);
-        for (const auto &[address, value] : patchesToMove)
-            patches.insert({ address - size, value });
+        this->m_patches.remove(offset, size);
+        this->m_undoJournal.clear();
 
         this->markDirty();
     }
 
     void Provider::applyOverlays(u64 offset, void *buffer, size_t size) {
-        for (auto &overlay : this->m_overlays) {
+        if (size == 0)
+            return;
+
+        std::scoped_lock lock(this->m_overlayIndexMutex);
+        this->rebuildOverlayIndex();
+
+        std::vector<u64> hits;
+        this->m_overlayIndex.visit_overlapping(offset, offset + size - 1, [&hits](const auto &interval) {
+            hits.push_back(interval.value);
+        });
+
+        // Later overlays take precedence over earlier ones
+        std::sort(hits.begin(), hits.end());
+
+        for (auto index : hits) {
+            auto overlay = this->m_indexedOverlays[index];
             auto overlayOffset = overlay->getAddress();
             auto overlaySize   = overlay->getSize();
 
@@ -91,46 +166,121 @@ namespace hex::prv {
         }
     }
 
+    void Provider::rebuildOverlayIndex() const {
+        if (this->m_overlayIndexValid)
+            return;
+
+        decltype(this->m_overlayIndex)::interval_vector intervals;
+        this->m_indexedOverlays.clear();
+        this->m_overlayStartAddresses.clear();
+
+        for (auto overlay : this->m_overlays) {
+            if (overlay->getSize() == 0)
+                continue;
+
+            intervals.emplace_back(overlay->getAddress(), overlay->getAddress() + overlay->getSize() - 1, this->m_indexedOverlays.size());
+            this->m_indexedOverlays.push_back(overlay);
+            this->m_overlayStartAddresses.push_back(overlay->getAddress());
+        }
 
-    std::map<u64, u8> &Provider::getPatches() {
-        auto iter = this->m_patches.end();
-        for (u32 i = 0; i < this->m_patchTreeOffset + 1; i++)
-            iter--;
+        std::sort(this->m_overlayStartAddresses.begin(), this->m_overlayStartAddresses.end());
 
-        return *(iter);
+        this->m_overlayIndex = decltype(this->m_overlayIndex)(std::move(intervals));
+        this->m_overlayIndexValid = true;
     }
 
-    const std::map<u64, u8> &Provider::getPatches() const {
-        auto iter = this->m_patches.end();
-        for (u32 i = 0; i < this->m_patchTreeOffset + 1; i++)
-            iter--;
 
-        return *(iter);
+    PatchStore &Provider::getPatches() {
+        return this->m_patches;
+    }
+
+    const PatchStore &Provider::getPatches() const {
+        return this->m_patches;
     }
 
     void Provider::applyPatches() {
-        for (auto &[patchAddress, patch] : getPatches()) {
-            this->writeRaw(patchAddress - this->getBaseAddress(), &patch, 1);
+        for (auto &[patchAddress, patch] : this->m_patches.getRuns()) {
+            this->writeRaw(patchAddress - this->getBaseAddress(), patch.data(), patch.size());
         }
         this->markDirty();
 
-        this->m_patches.emplace_back();
+        this->m_patches.clear();
+        this->m_undoJournal.clear();
     }
 
 
     Overlay *Provider::newOverlay() {
-        return this->m_overlays.emplace_back(new Overlay());
+        std::scoped_lock lock(this->m_overlayIndexMutex);
+
+        auto overlay = this->m_overlays.emplace_back(new Overlay());
+        overlay->setChangeCallback([this] {
+            std::scoped_lock lock(this->m_overlayIndexMutex);
+            this->invalidateOverlays();
+        });
+
+        this->invalidateOverlays();
+
+        return overlay;
     }
 
     void Provider::deleteOverlay(Overlay *overlay) {
+        std::scoped_lock lock(this->m_overlayIndexMutex);
+
         this->m_overlays.erase(std::find(this->m_overlays.begin(), this->m_overlays.end(), overlay));
         delete overlay;
+
+        this->invalidateOverlays();
     }
 
     const std::list<Overlay *> &Provider::getOverlays() {
         return this->m_overlays;
     }
 
+    void Provider::invalidateOverlays() {
+        this->m_overlayIndexValid = false;
+        this->m_overlayGeneration++;
+    }
+
+    ProviderSnapshot Provider::snapshot() {
+        std::shared_ptr<const OverlayState> overlays;
+        u64 overlayGeneration;
+        {
+            std::scoped_lock lock(this->m_overlayIndexMutex);
+
+            if (this->m_overlayState == nullptr || this->m_overlayStateGeneration != this->m_overlayGeneration) {
+                auto state = std::make_shared<OverlayState>();
+
+                decltype(state->index)::interval_vector intervals;
+                for (auto overlay : this->m_overlays) {
+                    if (overlay->getSize() == 0)
+                        continue;
+
+                    intervals.emplace_back(overlay->getAddress(), overlay->getAddress() + overlay->getSize() - 1, state->overlays.size());
+                    state->overlays.emplace_back(overlay->getAddress(), overlay->getData());
+                }
+                state->index = decltype(state->index)(std::move(intervals));
+
+                this->m_overlayState = std::move(state);
+                this->m_overlayStateGeneration = this->m_overlayGeneration;
+            }
+
+            overlays = this->m_overlayState;
+            overlayGeneration = this->m_overlayStateGeneration;
+        }
+
+        auto patches = std::make_shared<const PatchStore>(this->m_patches);
+        const auto generation = patches->getGeneration() + overlayGeneration;
+
+        auto rawData = this->getRawDataState();
+        const auto actualSize = rawData != nullptr ? rawData->getSize() : this->getActualSize();
+
+        return { this, generation, this->getBaseAddress(), actualSize, std::move(patches), std::move(overlays), std::move(rawData) };
+    }
+
+    u64 Provider::getGeneration() const {
+        return this->m_patches.getGeneration() + this->m_overlayGeneration;
+    }
+
 
     u32 Provider::getPageCount() const {
         return std::max(1.0, std::ceil(this->getActualSize() / double(PageSize)));
@@ -173,52 +323,67 @@ namespace hex::prv {
     }
 
     void Provider::addPatch(u64 offset, const void *buffer, size_t size, bool createUndo) {
-        if (this->m_patchTreeOffset > 0) {
-            auto iter = this->m_patches.end();
-            for (u32 i = 0; i < this->m_patchTreeOffset; i++)
-                iter--;
-
-            this->m_patches.erase(iter, this->m_patches.end());
-            this->m_patchTreeOffset = 0;
-        }
+        if (size == 0)
+            return;
 
         if (createUndo)
             createUndoPoint();
 
-        for (u64 i = 0; i < size; i++) {
-            u8 patch         = reinterpret_cast<const u8 *>(buffer)[i];
-            u8 originalValue = 0x00;
-            this->readRaw(offset + i, &originalValue, sizeof(u8));
+        auto &patches = this->m_patches;
+        auto before   = patches.getRuns(offset, size);
+        auto patchData = reinterpret_cast<const u8 *>(buffer);
+
+        std::vector<u8> originalData(std::min<size_t>(size, 1_MiB));
+        for (u64 chunkOffset = 0; chunkOffset < size; chunkOffset += originalData.size()) {
+            const auto chunkSize = std::min<size_t>(originalData.size(), size - chunkOffset);
+            const auto chunkAddress = offset + chunkOffset;
+
+            this->readRaw(chunkAddress - this->getBaseAddress(), originalData.data(), chunkSize);
+
+            // Store bytes that differ from the original data as patch runs and drop the ones that don't
+            size_t index = 0;
+            while (index < chunkSize) {
+                const auto runStart = index;
+                const bool differs  = patchData[chunkOffset + index] != originalData[index];
 
-            if (patch == originalValue)
-                getPatches().erase(offset + i);
-            else
-                getPatches()[offset + i] = patch;
+                while (index < chunkSize && (patchData[chunkOffset + index] != originalData[index]) == differs)
+                    index++;
+
+                if (differs)
+                    patches.write(chunkAddress + runStart, patchData + chunkOffset + runStart, index - runStart);
+                else
+                    patches.erase(chunkAddress + runStart, index - runStart);
+            }
         }
 
+        // Only the touched range is journaled so undo memory scales with the size of the edit
+        this->m_undoJournal.record(offset, size, std::move(before), patches.getRuns(offset, size));
+
         this->markDirty();
     }
 
     void Provider::createUndoPoint() {
-        this->m_patches.push_back(getPatches());
+        this->m_undoJournal.beginTransaction();
     }
 
     void Provider::undo() {
-        if (canUndo())
-            this->m_patchTreeOffset++;
+        this->m_undoJournal.undo(this->m_patches);
     }
 
     void Provider::redo() {
-        if (canRedo())
-            this->m_patchTreeOffset--;
+        this->m_undoJournal.redo(this->m_patches);
     }
 
     bool Provider::canUndo() const {
-        return this->m_patchTreeOffset < this->m_patches.size() - 1;
+        return this->m_undoJournal.canUndo();
     }
 
     bool Provider::canRedo() const {
-        return this->m_patchTreeOffset > 0;
+        return this->m_undoJournal.canRedo();
+    }
+
+    void Provider::setUndoHistoryLimit(size_t limit) {
+        this->m_undoJournal.setMemoryLimit(limit);
     }
 
     bool Provider::hasFilePicker() const {
@@ -265,22 +430,25 @@ namespace hex::prv {
         bool insideValidRegion = false;
 
         std::optional<u64> nextRegionAddress;
-        for (const auto &overlay : this->m_overlays) {
-            Region overlayRegion = { overlay->getAddress(), overlay->getSize() };
-            if (!nextRegionAddress.has_value() || overlay->getAddress() < nextRegionAddress) {
-                nextRegionAddress = overlayRegion.getStartAddress();
-            }
+        {
+            std::scoped_lock lock(this->m_overlayIndexMutex);
+            this->rebuildOverlayIndex();
 
-            if (Region { address, 1 }.overlaps(overlayRegion)) {
+            this->m_overlayIndex.visit_overlapping(address, [&insideValidRegion](const auto &) {
                 insideValidRegion = true;
-            }
+            });
+
+            if (insideValidRegion)
+                nextRegionAddress = address;
+            else if (auto it = std::lower_bound(this->m_overlayStartAddresses.begin(), this->m_overlayStartAddresses.end(), address); it != this->m_overlayStartAddresses.end())
+                nextRegionAddress = *it;
         }
 
-        for (const auto &[patchAddress, value] : this->m_patches.back()) {
-            if (!nextRegionAddress.has_value() || patchAddress < nextRegionAddress)
+        if (auto patchAddress = getPatches().getNextPatchAddress(address); patchAddress.has_value()) {
+            if (!nextRegionAddress.has_value() || *patchAddress < nextRegionAddress)
                 nextRegionAddress = patchAddress;
 
-            if (address == patchAddress)
+            if (address == *patchAddress)
                 insideValidRegion = true;
         }
 
@@ -290,6 +458,26 @@ namespace hex::prv {
             return { Region { address, *nextRegionAddress - address }, insideValidRegion };
     }
 
+    std::vector<Region> Provider::getDataRegions(u64 address, size_t size) const {
+        const u64 baseAddress = this->getBaseAddress();
+        if (address < baseAddress || address - baseAddress >= this->getActualSize() || size == 0)
+            return { };
+
+        size = std::min<u64>(size, this->getActualSize() - (address - baseAddress));
+
+        std::vector<Region> regions;
+        for (auto region : this->getRawDataRegions(address - baseAddress, size))
+            regions.push_back({ region.address + baseAddress, region.size });
+
+        std::scoped_lock lock(this->m_overlayIndexMutex);
+        this->rebuildOverlayIndex();
+
+        return ProviderSnapshot::mergeDataRegions(std::move(regions), address, size, this->m_patches, this->m_overlayIndex);
+    }
+
+    std::vector<Region> Provider::getRawDataRegions(u64 offset, size_t size) const {
+        return { Region { offset, size } };
+    }
 
     u32 Provider::getID() const {
         return this->m_id;
@@ -0,0 +1,137 @@
+#include <hex/providers/snapshot.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace hex::prv {
+
+    ProviderSnapshot::ProviderSnapshot(Provider *provider, u64 generation, u64 baseAddress, size_t actualSize, std::shared_ptr<const PatchStore> patches, std::shared_ptr<const OverlayState> overlays, std::shared_ptr<const RawDataState> rawData)
+        : m_provider(provider), m_generation(generation), m_baseAddress(baseAddress), m_actualSize(actualSize), m_patches(std::move(patches)), m_overlays(std::move(overlays)), m_rawData(std::move(rawData)) {
+    }
+
+    void ProviderSnapshot::read(u64 address, void *buffer, size_t size, bool overlays) const {
+        if (buffer == nullptr || size == 0)
+            return;
+
+        IOStatistics::ScopedOperation operation(this->m_provider->getIOStatistics(), IOStatistics::Operation::Read, size);
+        this->readData(address, buffer, size, false);
+        this->applyChanges(address, buffer, size, overlays);
+    }
+
+    void ProviderSnapshot::readSequential(u64 address, void *buffer, size_t size, bool overlays) const {
+        if (buffer == nullptr || size == 0)
+            return;
+
+        IOStatistics::ScopedOperation operation(this->m_provider->getIOStatistics(), IOStatistics::Operation::Read, size);
+        this->readData(address, buffer, size, true);
+        this->applyChanges(address, buffer, size, overlays);
+    }
+
+    void ProviderSnapshot::readData(u64 address, void *buffer, size_t size, bool sequential) const {
+        auto bytes = static_cast<u8 *>(buffer);
+
+        // Without a frozen copy of the raw data, it might have shrunk since the snapshot was taken. Everything that doesn't exist anymore reads as zeros
+        const u64 availableSize = std::min<u64>(this->m_actualSize, this->m_rawData != nullptr ? this->m_rawData->getSize() : this->m_provider->getActualSize());
+        const u64 offset = address - this->m_baseAddress;
+
+        size_t readSize = 0;
+        if (address >= this->m_baseAddress && offset < availableSize)
+            readSize = std::min<u64>(size, availableSize - offset);
+
+        if (readSize > 0) {
+            if (this->m_rawData != nullptr)
+                this->m_rawData->read(offset, bytes, readSize, sequential);
+            else if (sequential)
+                this->m_provider->readRawSequential(offset, bytes, readSize);
+            else
+                this->m_provider->readRaw(offset, bytes, readSize);
+        }
+
+        if (readSize < size)
+            std::memset(bytes + readSize, 0x00, size - readSize);
+    }
+
+    void ProviderSnapshot::applyChanges(u64 address, void *buffer, size_t size, bool overlays) const {
+        this->m_patches->apply(address, buffer, size);
+
+        if (!overlays || this->m_overlays->overlays.empty())
+            return;
+
+        std::vector<u64> hits;
+        this->m_overlays->index.visit_overlapping(address, address + size - 1, [&hits](const auto &interval) {
+            hits.push_back(interval.value);
+        });
+
+        // Later overlays take precedence over earlier ones
+        std::sort(hits.begin(), hits.end());
+
+        for (auto index : hits) {
+            const auto &[overlayAddress, overlayData] = this->m_overlays->overlays[index];
+
+            const u64 overlapStart = std::max(address, overlayAddress);
+            const u64 overlapEnd   = std::min<u64>(address + size, overlayAddress + overlayData.size());
+            if (overlapEnd > overlapStart)
+                std::memcpy(static_cast<u8 *>(buffer) + (overlapStart - address), overlayData.data() + (overlapStart - overlayAddress), overlapEnd - overlapStart);
+        }
+    }
+
+    std::vector<Region> ProviderSnapshot::getDataRegions(u64 address, size_t size) const {
+        if (address < this->m_baseAddress || address - this->m_baseAddress >= this->m_actualSize || size == 0)
+            return { };
+
+        size = std::min<u64>(size, this->m_actualSize - (address - this->m_baseAddress));
+
+        const u64 offset = address - this->m_baseAddress;
+        auto rawRegions = this->m_rawData != nullptr ? this->m_rawData->getDataRegions(offset, size) : this->m_provider->getRawDataRegions(offset, size);
+
+        std::vector<Region> regions;
+        for (auto region : rawRegions)
+            regions.push_back({ region.address + this->m_baseAddress, region.size });
+
+        return mergeDataRegions(std::move(regions), address, size, *this->m_patches, this->m_overlays->index);
+    }
+
+    bool ProviderSnapshot::isCurrent() const {
+        return this->m_provider->getGeneration() == this->m_generation;
+    }
+
+    std::vector<Region> ProviderSnapshot::mergeDataRegions(std::vector<Region> regions, u64 address, size_t size, const PatchStore &patches, const interval_tree::IntervalTree<u64, u64> &overlayIndex) {
+        const u64 endAddress = address + size;
+
+        auto addRegion = [&](u64 start, u64 end) {
+            start = std::max(start, address);
+            end   = std::min(end, endAddress);
+            if (start < end)
+                regions.push_back({ start, end - start });
+        };
+
+        // Patches and overlays can place arbitrary data on top of holes
+        const auto &runs = patches.getRuns();
+        auto run = runs.upper_bound(address);
+        if (run != runs.begin())
+            run = std::prev(run);
+        for (; run != runs.end() && run->first < endAddress; ++run)
+            addRegion(run->first, run->first + run->second.size());
+
+        overlayIndex.visit_overlapping(address, endAddress - 1, [&](const auto &interval) {
+            addRegion(interval.start, interval.stop + 1);
+        });
+
+        std::sort(regions.begin(), regions.end(), [](const auto &a, const auto &b) { return a.address < b.address; });
+
+        std::vector<Region> result;
+        for (const auto &region : regions) {
+            if (region.size == 0)
+                continue;
+
+            if (!result.empty() && result.back().address + result.back().size >= region.address)
+                result.back().size = std::max(result.back().address + result.back().size, region.address + region.size) - result.back().address;
+            else
+                result.push_back(region);
+        }
+
+        return result;
+    }
+
+}
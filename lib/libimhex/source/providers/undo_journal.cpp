@@ -0,0 +1,110 @@
+#include <hex/providers/undo_journal.hpp>
+
+#include <ranges>
+
+namespace hex::prv {
+
+    namespace {
+
+        size_t getRunListMemoryUsage(const PatchStore::RunList &runs) {
+            size_t result = runs.capacity() * sizeof(PatchStore::RunList::value_type);
+            for (const auto &[address, bytes] : runs)
+                result += bytes.capacity();
+
+            return result;
+        }
+
+        void restoreRuns(PatchStore &patches, u64 address, size_t size, const PatchStore::RunList &runs) {
+            patches.erase(address, size);
+            for (const auto &[runAddress, bytes] : runs)
+                patches.write(runAddress, bytes.data(), bytes.size());
+        }
+
+    }
+
+    void UndoJournal::beginTransaction() {
+        this->m_transactionOpen = false;
+    }
+
+    void UndoJournal::record(u64 address, size_t size, PatchStore::RunList before, PatchStore::RunList after) {
+        if (size == 0)
+            return;
+
+        this->dropRedoHistory();
+
+        if (!this->m_transactionOpen || this->m_transactions.empty()) {
+            this->m_transactions.emplace_back();
+            this->m_position = this->m_transactions.size();
+            this->m_transactionOpen = true;
+        }
+
+        const auto memoryUsage = sizeof(Delta) + getRunListMemoryUsage(before) + getRunListMemoryUsage(after);
+
+        auto &transaction = this->m_transactions.back();
+        transaction.deltas.push_back({ address, size, std::move(before), std::move(after) });
+        transaction.memoryUsage += memoryUsage;
+        this->m_memoryUsage += memoryUsage;
+
+        this->enforceMemoryLimit();
+    }
+
+    void UndoJournal::undo(PatchStore &patches) {
+        if (!this->canUndo())
+            return;
+
+        this->m_position--;
+        this->m_transactionOpen = false;
+
+        for (const auto &delta : this->m_transactions[this->m_position].deltas | std::views::reverse)
+            restoreRuns(patches, delta.address, delta.size, delta.before);
+    }
+
+    void UndoJournal::redo(PatchStore &patches) {
+        if (!this->canRedo())
+            return;
+
+        for (const auto &delta : this->m_transactions[this->m_position].deltas)
+            restoreRuns(patches, delta.address, delta.size, delta.after);
+
+        this->m_position++;
+        this->m_transactionOpen = false;
+    }
+
+    bool UndoJournal::canUndo() const {
+        return this->m_position > 0;
+    }
+
+    bool UndoJournal::canRedo() const {
+        return this->m_position < this->m_transactions.size();
+    }
+
+    void UndoJournal::clear() {
+        this->m_transactions.clear();
+        this->m_position = 0;
+        this->m_transactionOpen = false;
+        this->m_memoryUsage = 0;
+    }
+
+    void UndoJournal::setMemoryLimit(size_t limit) {
+        this->m_memoryLimit = limit;
+        this->enforceMemoryLimit();
+    }
+
+    void UndoJournal::dropRedoHistory() {
+        while (this->m_transactions.size() > this->m_position) {
+            this->m_memoryUsage -= this->m_transactions.back().memoryUsage;
+            this->m_transactions.pop_back();
+            this->m_transactionOpen = false;
+        }
+    }
+
+    void UndoJournal::enforceMemoryLimit() {
+        // Forget the oldest history first. The transaction that is currently being recorded is always kept
+        while (this->m_memoryUsage > this->m_memoryLimit && this->m_transactions.size() > 1 && this->m_position > 1) {
+            this->m_memoryUsage -= this->m_transactions.front().memoryUsage;
+            this->m_transactions.pop_front();
+            this->m_position--;
+        }
+    }
+
+}
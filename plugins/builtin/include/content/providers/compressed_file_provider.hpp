@@ -0,0 +1,113 @@
+#pragma once
+
+#include <hex/providers/provider.hpp>
+#include <hex/providers/block_cache.hpp>
+#include <hex/helpers/file.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hex::plugin::builtin::prv {
+
+    class CompressedFileProvider : public hex::prv::Provider {
+    public:
+        CompressedFileProvider();
+        ~CompressedFileProvider() override;
+
+        [[nodiscard]] bool isAvailable() const override { return this->m_dataValid; }
+        [[nodiscard]] bool isReadable() const override { return true; }
+        [[nodiscard]] bool isWritable() const override { return false; }
+        [[nodiscard]] bool isResizable() const override { return false; }
+        [[nodiscard]] bool isSavable() const override { return false; }
+
+        void readRaw(u64 offset, void *buffer, size_t size) override;
+        void writeRaw(u64 offset, const void *buffer, size_t size) override;
+        [[nodiscard]] size_t getActualSize() const override;
+
+        bool open() override;
+        void close() override;
+
+        [[nodiscard]] std::string getName() const override;
+        [[nodiscard]] std::vector<std::pair<std::string, std::string>> getDataInformation() const override;
+
+        void loadSettings(const nlohmann::json &settings) override;
+        [[nodiscard]] nlohmann::json storeSettings(nlohmann::json settings) const override;
+
+        [[nodiscard]] std::string getTypeName() const override {
+            return "hex.builtin.provider.compressed_file";
+        }
+
+        [[nodiscard]] bool hasFilePicker() const override { return true; }
+        [[nodiscard]] bool handleFilePicker() override;
+
+    protected:
+        enum class Format : u8 {
+            Unknown,
+            GZip,
+            XZ,
+            ZStd
+        };
+
+        // A point in the compressed stream from which decompression can be resumed
+        struct Checkpoint {
+            u64 compressedOffset;
+            u64 decompressedOffset;
+
+            // GZip: number of bits of the previous byte that belong to the next block. XZ: integrity check type of the stream
+            u8 parameter;
+
+            // GZip: the preceding 32 KiB of decompressed data, stored deflated
+            std::vector<u8> window;
+        };
+
+        [[nodiscard]] Format detectFormat();
+
+        bool buildIndex();
+        void buildGZipIndex(const std::stop_token &stopToken);
+        bool buildXZIndex();
+        bool buildZStdIndex();
+
+        [[nodiscard]] std::fs::path getIndexPath() const;
+        bool loadIndex();
+        void storeIndex() const;
+
+        void addCheckpoint(Checkpoint checkpoint);
+        [[nodiscard]] std::optional<Checkpoint> findCheckpoint(u64 offset) const;
+
+        class Decoder;
+        class GZipDecoder;
+        class XZDecoder;
+        class ZStdDecoder;
+
+        // Returns the ranges that couldn't be decompressed
+        [[nodiscard]] std::vector<Region> decompress(u64 offset, void *buffer, size_t size);
+
+        [[nodiscard]] std::unique_ptr<Decoder> takeDecoder(const Checkpoint &checkpoint, u64 offset);
+        void returnDecoder(std::unique_ptr<Decoder> decoder);
+
+        size_t readCompressed(u64 offset, void *buffer, size_t size);
+
+        std::fs::path m_path;
+        fs::File m_file;
+        std::mutex m_fileMutex;
+
+        Format m_format = Format::Unknown;
+        u64 m_compressedSize = 0;
+        std::atomic<u64> m_dataSize = 0;
+        std::atomic<bool> m_indexComplete = false;
+        bool m_dataValid = false;
+
+        mutable std::mutex m_indexMutex;
+        std::vector<Checkpoint> m_checkpoints;
+        std::jthread m_indexThread;
+
+        std::mutex m_decoderMutex;
+        std::vector<std::unique_ptr<Decoder>> m_decoders;
+
+        hex::prv::BlockCache m_cache;
+    };
+
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <hex/providers/provider.hpp>
+#include <hex/providers/block_cache.hpp>
 
+#include <algorithm>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -50,6 +53,11 @@ namespace hex::plugin::builtin::prv {
 
     protected:
         void reloadDrives();
+        // Returns the number of bytes that could be read
+        size_t readSectors(u64 offset, void *buffer, size_t size);
+        bool writeSectors(u64 offset, const void *buffer, size_t size);
+
+        [[nodiscard]] size_t getIOAlignment() const { return std::max<size_t>(this->m_sectorSize, 4096); }
 
         std::set<std::string> m_availableDrives;
         std::fs::path m_path;
@@ -64,11 +72,15 @@ namespace hex::plugin::builtin::prv {
         size_t m_diskSize   = 0;
         size_t m_sectorSize = 0;
 
-        u64 m_sectorBufferAddress = 0;
-        std::vector<u8> m_sectorBuffer;
+        hex::prv::BlockCache m_cache;
+        std::mutex m_writeMutex;
 
         bool m_readable = false;
         bool m_writable = false;
+
+        // Bypass the operating system's page cache. Only takes effect if the disk supports it
+        bool m_directIO   = false;
+        bool m_unbuffered = false;
     };
 
 }
\ No newline at end of file
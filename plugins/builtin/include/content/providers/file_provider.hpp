@@ -1,6 +1,10 @@
 #pragma once
 
 #include <hex/providers/provider.hpp>
+#include <hex/providers/piece_layout.hpp>
+
+#include <memory>
+#include <mutex>
 
 #include <string_view>
 
@@ -29,6 +33,8 @@ namespace hex::plugin::builtin::prv {
         [[nodiscard]] bool isSavable() const override;
 
         void read(u64 offset, void *buffer, size_t size, bool overlays) override;
+        void readMany(std::span<const hex::prv::ReadRequest> requests, bool overlays) override;
+        void readSequential(u64 offset, void *buffer, size_t size, bool overlays) override;
         void write(u64 offset, const void *buffer, size_t size) override;
 
         void resize(size_t newSize) override;
@@ -36,6 +42,7 @@ namespace hex::plugin::builtin::prv {
         void remove(u64 offset, size_t size) override;
 
         void readRaw(u64 offset, void *buffer, size_t size) override;
+        void readRawSequential(u64 offset, void *buffer, size_t size) override;
         void writeRaw(u64 offset, const void *buffer, size_t size) override;
         [[nodiscard]] size_t getActualSize() const override;
 
@@ -50,6 +57,10 @@ namespace hex::plugin::builtin::prv {
 
         void setPath(const std::fs::path &path);
 
+        void setFollowing(bool following);
+        [[nodiscard]] bool isFollowing() const { return this->m_following; }
+        [[nodiscard]] static bool isFollowingSupported();
+
         [[nodiscard]] bool open() override;
         void close() override;
 
@@ -63,10 +74,40 @@ namespace hex::plugin::builtin::prv {
         std::pair<Region, bool> getRegionValidity(u64 address) const override;
 
     protected:
+        class MappedFile;
+
+        [[nodiscard]] std::vector<Region> getRawDataRegions(u64 offset, size_t size) const override;
+        [[nodiscard]] std::shared_ptr<const hex::prv::RawDataState> getRawDataState() const override;
+
+        [[nodiscard]] std::shared_ptr<const hex::prv::PieceLayout> getLayout() const;
+        void setLayout(std::shared_ptr<const hex::prv::PieceLayout> layout);
+
+        bool writeToFile(const std::fs::path &path);
+        bool replaceFile(const std::fs::path &path);
+        void resizeFile(size_t newSize);
+
+        void writeOriginal(u64 offset, const void *buffer, size_t size);
+
+        void startFollowing();
+        void stopFollowing();
+        void updateFollowedFile(bool force = false);
+
         std::fs::path m_path;
-        void *m_mappedFile = nullptr;
+        std::shared_ptr<MappedFile> m_mappedFile;
         size_t m_fileSize  = 0;
 
+        // Inserts and removals only modify the layout. The file itself is rewritten once when saving.
+        // Every edit replaces the layout with an updated copy, so readers on other threads and snapshots keep using the one they started with
+        std::shared_ptr<const hex::prv::PieceLayout> m_layout;
+        mutable std::mutex m_layoutMutex;
+
+#if !defined(OS_WINDOWS)
+        // inotify descriptor used to notice when a followed file gets written to
+        int m_followWatch = -1;
+#endif
+
+        bool m_following = false;
+
         struct stat m_fileStats = { };
         bool m_fileStatsValid   = false;
         bool m_emptyFile        = false;
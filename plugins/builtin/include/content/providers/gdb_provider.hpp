@@ -1,19 +1,61 @@
 #pragma once
 
+#include <hex/helpers/gdb_protocol.hpp>
 #include <hex/helpers/socket.hpp>
 #include <hex/providers/provider.hpp>
+#include <hex/providers/block_cache.hpp>
 
-#include <array>
+#include <atomic>
 #include <mutex>
+#include <optional>
 #include <string_view>
 #include <thread>
 
 namespace hex::plugin::builtin::prv {
 
+    namespace gdb {
+
+        // Connection to a GDB remote stub. Requests are serialized so the connection can be shared between threads
+        class Connection {
+        public:
+            bool connect(const std::string &address, u16 port);
+            void disconnect();
+            [[nodiscard]] bool isConnected() const;
+
+            // Returns the ranges whose packets failed. They're zeroed, everything else holds the data that was read
+            [[nodiscard]] std::vector<Region> readMemory(u64 address, void *buffer, size_t size);
+            bool writeMemory(u64 address, const void *buffer, size_t size);
+
+            [[nodiscard]] size_t getMaxPacketSize() const { return this->m_maxPacketSize; }
+
+        private:
+            bool negotiateFeatures();
+
+            void sendPackets(const std::string &packets);
+            [[nodiscard]] std::optional<std::string> receivePacket();
+            [[nodiscard]] std::optional<std::string> exchange(const std::string &data);
+
+            [[nodiscard]] size_t getMaxReadSize() const;
+            [[nodiscard]] std::string createReadCommand(u64 address, size_t size) const;
+
+            // Reads memory using unpipelined 'm' packets, whose replies can't be mistaken for errors
+            bool readMemoryHex(u64 address, u8 *buffer, size_t size);
+
+            hex::Socket m_socket;
+            std::string m_receiveBuffer;
+            std::mutex m_mutex;
+
+            size_t m_maxPacketSize = 400;
+            hex::gdb::BinaryRead m_binaryRead = hex::gdb::BinaryRead::Unsupported;
+            bool m_binaryWrite = false;
+        };
+
+    }
+
     class GDBProvider : public hex::prv::Provider {
     public:
         GDBProvider();
-        ~GDBProvider() override = default;;
+        ~GDBProvider() override = default;
 
         [[nodiscard]] bool isAvailable() const override;
         [[nodiscard]] bool isReadable() const override;
@@ -39,9 +81,15 @@ namespace hex::plugin::builtin::prv {
 
         [[nodiscard]] bool isConnected() const;
 
+        // Drops all cached memory. Has to be called whenever the target ran, e.g. after it got stopped or stepped
+        void invalidateCache();
+
         [[nodiscard]] bool hasLoadInterface() const override { return true; }
         void drawLoadInterface() override;
 
+        [[nodiscard]] bool hasInterface() const override { return true; }
+        void drawInterface() override;
+
         void loadSettings(const nlohmann::json &settings) override;
         [[nodiscard]] nlohmann::json storeSettings(nlohmann::json settings) const override;
 
@@ -52,7 +100,7 @@ namespace hex::plugin::builtin::prv {
         [[nodiscard]] std::pair<Region, bool> getRegionValidity(u64 address) const override;
 
     protected:
-        hex::Socket m_socket;
+        gdb::Connection m_connection;
 
         std::string m_ipAddress;
         int m_port = 0;
@@ -60,17 +108,19 @@ namespace hex::plugin::builtin::prv {
         u64 m_size = 0;
 
         constexpr static size_t CacheLineSize = 0x1000;
+        constexpr static size_t RefreshedCacheLineCount = 16;
+        constexpr static int MinCacheSize = 64, MaxCacheSize = 64 * 1024;
 
-        struct CacheLine {
-            u64 address;
-
-            std::array<u8, CacheLineSize> data;
-        };
+        [[nodiscard]] std::vector<Region> readMemory(u64 offset, void *buffer, size_t size);
+        void refreshCache();
+        void drawCacheSettings();
 
-        std::list<CacheLine> m_cache;
+        // Cache size in KiB
+        int m_cacheSize = 1024;
+        std::atomic<bool> m_autoRefresh = true;
 
-        std::thread m_cacheUpdateThread;
-        std::mutex m_cacheLock;
+        hex::prv::BlockCache m_cache;
+        std::jthread m_cacheUpdateThread;
     };
 
 }
\ No newline at end of file
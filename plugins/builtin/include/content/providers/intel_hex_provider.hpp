@@ -1,8 +1,14 @@
 #pragma once
 
 #include <hex/providers/provider.hpp>
+#include <hex/helpers/file.hpp>
 
-#include <IntervalTree.h>
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace hex::plugin::builtin::prv {
 
@@ -17,8 +23,6 @@ namespace hex::plugin::builtin::prv {
         [[nodiscard]] bool isResizable() const override { return false; }
         [[nodiscard]] bool isSavable() const override { return false; }
 
-        void setBaseAddress(u64 address) override;
-
         void readRaw(u64 offset, void *buffer, size_t size) override;
         void writeRaw(u64 offset, const void *buffer, size_t size) override;
         [[nodiscard]] size_t getActualSize() const override;
@@ -41,10 +45,102 @@ namespace hex::plugin::builtin::prv {
 
         std::pair<Region, bool> getRegionValidity(u64 address) const override;
 
+        // Decodes size bytes of hex digits from the start of text
+        [[nodiscard]] static bool decodeHex(std::string_view text, u8 *buffer, size_t size);
+
     protected:
+        // A run of contiguous bytes in the loaded image, stored at arenaOffset in the arena
+        struct Extent {
+            u64 address;
+            u64 arenaOffset;
+            u64 size;
+        };
+
+        // Data of one or more consecutive records. Points into a buffer that has to stay alive until the extents got built
+        struct DataRun {
+            u64 address;
+            const u8 *data;
+            u64 size;
+        };
+
+        constexpr static size_t ChunkSize = 8 * 1024 * 1024;
+
+        [[nodiscard]] std::vector<Region> getRawDataRegions(u64 offset, size_t size) const override;
+
+        // Reads the file in large chunks that end at record boundaries and parses batches of them on all cores.
+        // The results are then handed to processChunk in file order
+        template<typename T>
+        static bool parseChunked(const std::fs::path &path, char recordStart, const std::function<bool(std::string_view, T &)> &parseChunk, const std::function<bool(T &)> &processChunk) {
+            fs::File file(path, fs::File::Mode::Read);
+            if (!file.isValid())
+                return false;
+
+            const auto threadCount = std::max<u32>(std::thread::hardware_concurrency(), 1);
+
+            std::vector<std::string> texts(threadCount);
+            std::string remainder;
+            bool endOfFile = false;
+            while (!endOfFile) {
+                u32 chunkCount = 0;
+                while (chunkCount < threadCount && !endOfFile) {
+                    auto &text = texts[chunkCount];
+                    text = std::move(remainder);
+                    remainder.clear();
+
+                    const auto textSize = text.size();
+                    text.resize(textSize + ChunkSize);
+                    text.resize(textSize + file.readBuffer(reinterpret_cast<u8 *>(text.data() + textSize), ChunkSize));
+
+                    if (text.size() == textSize) {
+                        endOfFile = true;
+                    } else {
+                        // Move the last, possibly incomplete record over to the next chunk
+                        auto split = text.rfind(recordStart);
+                        if (split == std::string::npos || split == 0) {
+                            remainder = std::move(text);
+                            continue;
+                        }
+
+                        remainder = text.substr(split);
+                        text.resize(split);
+                    }
+
+                    if (!text.empty())
+                        chunkCount++;
+                }
+
+                std::vector<T> results(chunkCount);
+                std::vector<std::future<bool>> futures;
+                for (u32 i = 0; i < chunkCount; i++) {
+                    futures.push_back(std::async(std::launch::async, [&, i] {
+                        return parseChunk(texts[i], results[i]);
+                    }));
+                }
+
+                bool success = true;
+                for (auto &future : futures)
+                    success = future.get() && success;
+
+                if (!success)
+                    return false;
+
+                for (auto &result : results) {
+                    if (!processChunk(result))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        void setRecords(std::vector<DataRun> runs);
+        [[nodiscard]] std::vector<Extent>::const_iterator findExtent(u64 offset) const;
+
         bool m_dataValid = false;
         size_t m_dataSize = 0x00;
-        interval_tree::IntervalTree<u64, std::vector<u8>> m_data;
+
+        std::vector<Extent> m_extents;
+        std::vector<u8> m_arena;
 
         std::fs::path m_sourceFilePath;
     };
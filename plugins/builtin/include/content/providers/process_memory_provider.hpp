@@ -0,0 +1,95 @@
+#pragma once
+
+#include <hex/providers/provider.hpp>
+#include <hex/helpers/process_memory.hpp>
+
+#include <atomic>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hex::plugin::builtin::prv {
+
+    // Reads the memory of a running process. Offsets are the virtual addresses in the process' address space
+    class ProcessMemoryProvider : public hex::prv::Provider {
+    public:
+        ProcessMemoryProvider() = default;
+        ~ProcessMemoryProvider() override = default;
+
+        [[nodiscard]] bool isAvailable() const override { return this->m_processId != 0 && this->m_available; }
+        [[nodiscard]] bool isReadable() const override { return true; }
+        [[nodiscard]] bool isWritable() const override { return false; }
+        [[nodiscard]] bool isResizable() const override { return false; }
+        [[nodiscard]] bool isSavable() const override { return false; }
+
+        void read(u64 offset, void *buffer, size_t size, bool overlays) override;
+        void readMany(std::span<const hex::prv::ReadRequest> requests, bool overlays) override;
+
+        void readRaw(u64 offset, void *buffer, size_t size) override;
+        void writeRaw(u64 offset, const void *buffer, size_t size) override;
+        [[nodiscard]] size_t getActualSize() const override;
+
+        [[nodiscard]] bool open() override;
+        void close() override;
+
+        [[nodiscard]] std::string getName() const override;
+        [[nodiscard]] std::vector<std::pair<std::string, std::string>> getDataInformation() const override;
+
+        [[nodiscard]] bool hasLoadInterface() const override { return true; }
+        void drawLoadInterface() override;
+
+        [[nodiscard]] bool hasInterface() const override { return true; }
+        void drawInterface() override;
+
+        void loadSettings(const nlohmann::json &settings) override;
+        [[nodiscard]] nlohmann::json storeSettings(nlohmann::json settings) const override;
+
+        [[nodiscard]] std::string getTypeName() const override {
+            return "hex.builtin.provider.process_memory";
+        }
+
+        [[nodiscard]] std::pair<Region, bool> getRegionValidity(u64 address) const override;
+
+        void setProcessId(u32 processId) { this->m_processId = processId; }
+        void setSnapshotMode(bool enabled) { this->m_snapshotMode = enabled; }
+
+        // Re-reads the process' memory map and, in snapshot mode, the contents of all its mappings
+        bool reload();
+
+    protected:
+        struct Mapping {
+            u64 address;
+            u64 size;
+            std::string name;
+
+            // Location of the mapping's data in the snapshot arena
+            u64 arenaOffset;
+        };
+
+        [[nodiscard]] std::vector<Region> getRawDataRegions(u64 offset, size_t size) const override;
+
+        [[nodiscard]] std::optional<std::vector<Mapping>> readMappings() const;
+        void reloadProcesses();
+        [[nodiscard]] std::vector<Mapping>::const_iterator findMapping(u64 address) const;
+
+        // Adds the parts of a read that overlap a mapping. In snapshot mode they're copied right away instead
+        void addTransfers(u64 offset, void *buffer, size_t size, std::vector<hex::process::Transfer> &transfers) const;
+
+        std::vector<std::pair<u32, std::string>> m_availableProcesses;
+
+        u32 m_processId = 0;
+        std::string m_processName;
+
+        bool m_snapshotMode = false;
+        bool m_available = false;
+
+        mutable std::shared_mutex m_mappingMutex;
+        std::vector<Mapping> m_mappings;
+        std::vector<u8> m_snapshot;
+        std::atomic<u64> m_addressSpaceSize = 0;
+    };
+
+}
@@ -5,8 +5,11 @@
 #include <imgui.h>
 #include <hex/ui/view.hpp>
 #include <ui/widgets.hpp>
+#include <hex/helpers/masked_pattern.hpp>
 
 #include <atomic>
+#include <functional>
+#include <span>
 #include <vector>
 
 #include <IntervalTree.h>
@@ -24,14 +27,15 @@ namespace hex::plugin::builtin {
 
         struct Occurrence {
             Region region;
-            enum class DecodeType { ASCII, Binary, UTF16, Unsigned, Signed, Float, Double } decodeType;
+            enum class DecodeType { ASCII, Binary, UTF16, Unsigned, Signed, Float, Double, UTF8, UTF32 } decodeType;
             std::endian endian = std::endian::native;
-        };
 
-        struct BinaryPattern {
-            u8 mask, value;
+            // Line of the sequence list that matched
+            u32 sequenceIndex = 0;
         };
 
+        using BinaryPattern = MaskedPattern::Byte;
+
         struct SearchSettings {
             ui::SelectedRegion range = ui::SelectedRegion::EntireData;
 
@@ -40,12 +44,13 @@ namespace hex::plugin::builtin {
                 Sequence,
                 Regex,
                 BinaryPattern,
-                Value
+                Value,
+                SequenceList
             } mode = Mode::Strings;
 
             struct Strings {
                 int minLength = 5;
-                enum class Type : int { ASCII = 0, UTF16LE = 1, UTF16BE = 2, ASCII_UTF16LE = 3, ASCII_UTF16BE = 4 } type = Type::ASCII;
+                enum class Type : int { ASCII = 0, UTF16LE = 1, UTF16BE = 2, ASCII_UTF16LE = 3, ASCII_UTF16BE = 4, UTF8 = 5, UTF32LE = 6, UTF32BE = 7, All = 8 } type = Type::ASCII;
                 bool nullTermination = false;
 
                 bool m_lowerCaseLetters = true;
@@ -82,7 +87,18 @@ namespace hex::plugin::builtin {
                 } type = Type::U8;
             } value;
 
-        } m_searchSettings, m_decodeSettings;
+            struct SequenceList {
+                std::string input;
+                std::vector<std::string> sequences;
+
+                // Only updated when the input changes, decoding every line each frame gets expensive for long lists
+                bool valid = false;
+            } sequenceList;
+
+        } m_searchSettings;
+
+        // Settings the current results of each provider were found with
+        std::map<prv::Provider*, SearchSettings> m_decodeSettings;
 
         using OccurrenceTree = interval_tree::IntervalTree<u64, Occurrence>;
 
@@ -94,17 +110,22 @@ namespace hex::plugin::builtin {
         bool m_settingsValid = false;
 
     private:
-        static std::vector<Occurrence> searchStrings(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Strings &settings);
-        static std::vector<Occurrence> searchSequence(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Sequence &settings);
-        static std::vector<Occurrence> searchRegex(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Regex &settings);
-        static std::vector<Occurrence> searchBinaryPattern(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::BinaryPattern &settings);
-        static std::vector<Occurrence> searchValue(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Value &settings);
+        static std::vector<Occurrence> searchStrings(Task &task, const prv::ProviderSnapshot &snapshot, Region searchRegion, const SearchSettings::Strings &settings, const std::function<bool(const Occurrence &)> &filter = { });
+        static std::vector<Occurrence> searchSequence(Task &task, const prv::ProviderSnapshot &snapshot, Region searchRegion, const SearchSettings::Sequence &settings);
+        static std::vector<Occurrence> searchRegex(Task &task, const prv::ProviderSnapshot &snapshot, Region searchRegion, const SearchSettings::Regex &settings);
+        static std::vector<Occurrence> searchBinaryPattern(Task &task, const prv::ProviderSnapshot &snapshot, Region searchRegion, const SearchSettings::BinaryPattern &settings);
+        static std::vector<Occurrence> searchValue(Task &task, const prv::ProviderSnapshot &snapshot, Region searchRegion, const SearchSettings::Value &settings);
+        static std::vector<Occurrence> searchSequenceList(Task &task, const prv::ProviderSnapshot &snapshot, Region searchRegion, const SearchSettings::SequenceList &settings);
 
         static std::vector<BinaryPattern> parseBinaryPatternString(std::string string);
+        static std::vector<std::string> parseSequenceList(const std::string &input);
+        static void updateSequenceList(SearchSettings::SequenceList &settings);
         static std::tuple<bool, std::variant<u64, i64, float, double>, size_t> parseNumericValueInput(const std::string &input, SearchSettings::Value::Type type);
 
         void runSearch();
         std::string decodeValue(prv::Provider *provider, Occurrence occurrence) const;
+        std::vector<std::string> decodeValues(prv::Provider *provider, std::span<const Occurrence> occurrences) const;
+        static std::string decodeBytes(const SearchSettings &settings, const Occurrence &occurrence, std::vector<u8> bytes);
     };
 
 }
\ No newline at end of file
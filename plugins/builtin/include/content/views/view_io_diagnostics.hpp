@@ -0,0 +1,17 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <hex/ui/view.hpp>
+
+namespace hex::plugin::builtin {
+
+    class ViewIODiagnostics : public View {
+    public:
+        explicit ViewIODiagnostics();
+        ~ViewIODiagnostics() override = default;
+
+        void drawContent() override;
+    };
+
+}
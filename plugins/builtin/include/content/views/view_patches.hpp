@@ -17,7 +17,7 @@ namespace hex::plugin::builtin {
         void drawContent() override;
 
     private:
-        u64 m_selectedPatch = 0x00;
+        Region m_selectedPatch = { 0x00, 0x00 };
     };
 
 }
\ No newline at end of file
@@ -21,13 +21,15 @@ namespace hex::plugin::builtin {
         reader.setEndAddress(offset + size - 1);
 
         u64 index = 0x00;
-        for (u8 byte : reader) {
-            if ((index % LineLength) == 0x00)
-                result += NewLineIndent;
+        for (const auto &chunk : reader.chunks()) {
+            for (u8 byte : chunk.data) {
+                if ((index % LineLength) == 0x00)
+                    result += NewLineIndent;
 
-            result += hex::format(byteFormat, byte);
+                result += hex::format(byteFormat, byte);
 
-            index++;
+                index++;
+            }
         }
 
         // Remove trailing comma
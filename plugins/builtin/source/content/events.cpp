@@ -6,6 +6,7 @@
 #include <hex/api/localization.hpp>
 #include <hex/helpers/file.hpp>
 #include <hex/helpers/logger.hpp>
+#include <hex/helpers/literals.hpp>
 #include <hex/api/project_file_manager.hpp>
 
 #include <imgui.h>
@@ -17,6 +18,15 @@
 
 namespace hex::plugin::builtin {
 
+    using namespace hex::literals;
+
+    static void applyUndoHistoryLimit(hex::prv::Provider *provider) {
+        auto limit = ContentRegistry::Settings::getSetting("hex.builtin.setting.hex_editor", "hex.builtin.setting.hex_editor.undo_history_limit");
+
+        if (limit.is_number())
+            provider->setUndoHistoryLimit(static_cast<size_t>(limit.get<int>()) * 1_MiB);
+    }
+
     static void openFile(const std::fs::path &path) {
         auto provider = ImHexApi::Provider::createProvider("hex.builtin.provider.file", true);
         if (auto *fileProvider = dynamic_cast<prv::FileProvider*>(provider); fileProvider != nullptr) {
@@ -90,6 +100,8 @@ namespace hex::plugin::builtin {
         });
 
         EventManager::subscribe<EventProviderCreated>([](hex::prv::Provider *provider) {
+            applyUndoHistoryLimit(provider);
+
             if (provider->shouldSkipLoadInterface())
                 return;
 
@@ -123,6 +135,11 @@ namespace hex::plugin::builtin {
             ProviderExtraData::erase(provider);
         });
 
+        EventManager::subscribe<EventSettingsChanged>([] {
+            for (auto provider : ImHexApi::Provider::getProviders())
+                applyUndoHistoryLimit(provider);
+        });
+
         fs::setFileBrowserErrorCallback([]{
             #if defined(NFD_PORTAL)
                 View::showErrorPopup("hex.builtin.popup.error.file_dialog.portal"_lang);
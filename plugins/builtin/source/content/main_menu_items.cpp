@@ -9,10 +9,51 @@
 #include <hex/helpers/crypto.hpp>
 #include <hex/helpers/patches.hpp>
 
+#include "content/providers/file_provider.hpp"
+
 namespace hex::plugin::builtin {
 
     static bool g_demoWindowOpen = false;
 
+    static Patches getProviderPatches(hex::prv::Provider *provider) {
+        Patches result;
+
+        for (const auto &[address, bytes] : provider->getPatches().getRuns()) {
+            for (u64 i = 0; i < bytes.size(); i++)
+                result[address + i] = bytes[i];
+        }
+
+        return result;
+    }
+
+    static void addProviderPatches(Task &task, hex::prv::Provider *provider, const Patches &patches) {
+        task.setMaxValue(patches.size());
+
+        // Group all imported patches into a single undo step
+        provider->createUndoPoint();
+
+        // Coalesce consecutive patched bytes so they can be added as a single run
+        std::vector<u8> run;
+        u64 runAddress = 0x00;
+        u64 progress = 0;
+        for (const auto &[address, value] : patches) {
+            if (!run.empty() && address != runAddress + run.size()) {
+                provider->addPatch(runAddress, run.data(), run.size());
+                run.clear();
+            }
+
+            if (run.empty())
+                runAddress = address;
+            run.push_back(value);
+
+            progress++;
+            task.update(progress);
+        }
+
+        if (!run.empty())
+            provider->addPatch(runAddress, run.data(), run.size());
+    }
+
     static void createFileMenu() {
 
         ContentRegistry::Interface::registerMainMenuItem("hex.builtin.menu.file", 1000);
@@ -42,10 +83,16 @@ namespace hex::plugin::builtin {
             if (ImGui::MenuItem("hex.builtin.menu.file.reload_file"_lang, "CTRL + R", false, !taskRunning && ImHexApi::Provider::isValid())) {
                 auto provider = ImHexApi::Provider::get();
 
+                provider->waitForAsyncReads();
                 provider->close();
                 if (!provider->open())
                     ImHexApi::Provider::remove(provider, true);
             }
+
+            auto fileProvider = ImHexApi::Provider::isValid() ? dynamic_cast<prv::FileProvider *>(ImHexApi::Provider::get()) : nullptr;
+            if (ImGui::MenuItem("hex.builtin.menu.file.follow_file"_lang, nullptr, fileProvider != nullptr && fileProvider->isFollowing(), fileProvider != nullptr && prv::FileProvider::isFollowingSupported())) {
+                fileProvider->setFollowing(!fileProvider->isFollowing());
+            }
         });
 
         /* File open, quit imhex */
@@ -141,18 +188,7 @@ namespace hex::plugin::builtin {
                             auto patchData = fs::File(path, fs::File::Mode::Read).readBytes();
                             auto patch     = hex::loadIPSPatch(patchData);
 
-                            task.setMaxValue(patch.size());
-
-                            auto provider = ImHexApi::Provider::get();
-
-                            u64 progress = 0;
-                            for (auto &[address, value] : patch) {
-                                provider->addPatch(address, &value, 1);
-                                progress++;
-                                task.update(progress);
-                            }
-
-                            provider->createUndoPoint();
+                            addProviderPatches(task, ImHexApi::Provider::get(), patch);
                         });
                     });
                 }
@@ -163,18 +199,7 @@ namespace hex::plugin::builtin {
                             auto patchData = fs::File(path, fs::File::Mode::Read).readBytes();
                             auto patch     = hex::loadIPS32Patch(patchData);
 
-                            task.setMaxValue(patch.size());
-
-                            auto provider = ImHexApi::Provider::get();
-
-                            u64 progress = 0;
-                            for (auto &[address, value] : patch) {
-                                provider->addPatch(address, &value, 1);
-                                progress++;
-                                task.update(progress);
-                            }
-
-                            provider->createUndoPoint();
+                            addProviderPatches(task, ImHexApi::Provider::get(), patch);
                         });
                     });
                 }
@@ -186,7 +211,7 @@ namespace hex::plugin::builtin {
             /* Export */
             if (ImGui::BeginMenu("hex.builtin.menu.file.export"_lang, providerValid && provider->isWritable())) {
                 if (ImGui::MenuItem("hex.builtin.menu.file.export.ips"_lang, nullptr, false)) {
-                    Patches patches = provider->getPatches();
+                    Patches patches = getProviderPatches(provider);
                     if (!patches.contains(0x00454F45) && patches.contains(0x00454F46)) {
                         u8 value = 0;
                         provider->read(0x00454F45, &value, sizeof(u8));
@@ -211,7 +236,7 @@ namespace hex::plugin::builtin {
                 }
 
                 if (ImGui::MenuItem("hex.builtin.menu.file.export.ips32"_lang, nullptr, false)) {
-                    Patches patches = provider->getPatches();
+                    Patches patches = getProviderPatches(provider);
                     if (!patches.contains(0x00454F45) && patches.contains(0x45454F46)) {
                         u8 value = 0;
                         provider->read(0x45454F45, &value, sizeof(u8));
@@ -6,6 +6,8 @@
 #include "content/providers/disk_provider.hpp"
 #include "content/providers/intel_hex_provider.hpp"
 #include "content/providers/motorola_srec_provider.hpp"
+#include "content/providers/compressed_file_provider.hpp"
+#include "content/providers/process_memory_provider.hpp"
 
 #include <hex/api/project_file_manager.hpp>
 #include <nlohmann/json.hpp>
@@ -21,6 +23,11 @@ namespace hex::plugin::builtin {
         ContentRegistry::Provider::add<prv::GDBProvider>();
         ContentRegistry::Provider::add<prv::IntelHexProvider>();
         ContentRegistry::Provider::add<prv::MotorolaSRECProvider>();
+        ContentRegistry::Provider::add<prv::CompressedFileProvider>();
+
+        #if defined(OS_LINUX)
+            ContentRegistry::Provider::add<prv::ProcessMemoryProvider>();
+        #endif
 
         ProjectFile::registerHandler({
              .basePath = "providers",
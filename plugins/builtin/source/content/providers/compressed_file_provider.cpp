@@ -0,0 +1,1056 @@
+#include "content/providers/compressed_file_provider.hpp"
+
+#include <hex/api/event.hpp>
+#include <hex/api/imhex_api.hpp>
+#include <hex/api/localization.hpp>
+#include <hex/api/task.hpp>
+#include <hex/helpers/fmt.hpp>
+#include <hex/helpers/utils.hpp>
+
+#include <nlohmann/json.hpp>
+
+#if defined(IMHEX_ZLIB_SUPPORT)
+    #include <zlib.h>
+#endif
+
+#if defined(IMHEX_LZMA_SUPPORT)
+    #include <lzma.h>
+#endif
+
+#if defined(IMHEX_ZSTD_SUPPORT)
+    #include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+
+namespace hex::plugin::builtin::prv {
+
+    using namespace hex::literals;
+
+    namespace {
+
+        constexpr static auto IndexMagic        = std::array<char, 8>{ 'I', 'H', 'E', 'X', 'C', 'I', 'D', 'X' };
+        constexpr static u32 IndexVersion       = 2;
+
+        constexpr static size_t CheckpointSpan  = 16_MiB;
+        constexpr static size_t WindowSize      = 32_KiB;
+        constexpr static size_t InputChunkSize  = 256_KiB;
+        constexpr static size_t MaxDecoders     = 4;
+
+        constexpr static u32 ZStdFrameMagic     = 0xFD2FB528;
+        constexpr static u32 ZStdSkippableMagic = 0x184D2A50;
+        constexpr static u32 ZStdSeekableMagic  = 0x8F92EAB1;
+
+        template<typename T>
+        T readLittleEndian(const u8 *data, size_t size = sizeof(T)) {
+            T result = 0;
+            for (size_t i = 0; i < size; i++)
+                result |= T(data[i]) << (i * 8);
+
+            return result;
+        }
+
+        template<typename T>
+        void appendLittleEndian(std::vector<u8> &data, T value) {
+            for (size_t i = 0; i < sizeof(T); i++)
+                data.push_back(u8(u64(value) >> (i * 8)));
+        }
+
+        #if defined(IMHEX_ZLIB_SUPPORT)
+
+            std::vector<u8> deflateWindow(const u8 *data, size_t size) {
+                std::vector<u8> result(compressBound(size));
+
+                auto resultSize = uLongf(result.size());
+                if (compress2(result.data(), &resultSize, data, size, Z_BEST_SPEED) != Z_OK)
+                    return { };
+
+                result.resize(resultSize);
+                return result;
+            }
+
+            std::vector<u8> inflateWindow(const std::vector<u8> &data) {
+                std::vector<u8> result(WindowSize);
+
+                auto resultSize = uLongf(result.size());
+                if (uncompress(result.data(), &resultSize, data.data(), data.size()) != Z_OK)
+                    return { };
+
+                result.resize(resultSize);
+                return result;
+            }
+
+        #endif
+
+    }
+
+    // Decompresses the data following a checkpoint. The decoders used last are kept around, so reads that continue where a previous one
+    // stopped don't have to start over at the checkpoint and decompress everything in front of them again
+    class CompressedFileProvider::Decoder {
+    public:
+        Decoder(CompressedFileProvider &provider, const Checkpoint &checkpoint)
+            : m_provider(provider), m_position(checkpoint.decompressedOffset), m_inputOffset(checkpoint.compressedOffset), m_input(InputChunkSize) { }
+        virtual ~Decoder() = default;
+
+        [[nodiscard]] bool isFinished() const { return this->m_finished; }
+        [[nodiscard]] u64 getPosition() const { return this->m_position; }
+
+        [[nodiscard]] bool canContinueAt(const Checkpoint &checkpoint, u64 offset) const {
+            return !this->m_finished && checkpoint.decompressedOffset <= this->m_position && this->m_position <= offset;
+        }
+
+        // Decompresses the data at the given offset, which mustn't lie in front of the current position
+        size_t read(u64 offset, u8 *buffer, size_t size) {
+            std::vector<u8> skipBuffer(std::min<u64>(offset - this->m_position, 64_KiB));
+            while (this->m_position < offset) {
+                const auto skipped = this->decode(skipBuffer.data(), std::min<u64>(offset - this->m_position, skipBuffer.size()));
+                if (skipped == 0)
+                    return 0;
+
+                this->m_position += skipped;
+            }
+
+            const auto produced = this->decode(buffer, size);
+            this->m_position += produced;
+
+            return produced;
+        }
+
+    protected:
+        // Decompresses as much as fits into the buffer. Produces nothing once the data ended or turned out to be corrupted
+        virtual size_t decode(u8 *buffer, size_t size) = 0;
+
+        size_t readInput() {
+            const auto inputSize = this->m_provider.readCompressed(this->m_inputOffset, this->m_input.data(), this->m_input.size());
+            this->m_inputOffset += inputSize;
+
+            return inputSize;
+        }
+
+        CompressedFileProvider &m_provider;
+        u64 m_position;
+        u64 m_inputOffset;
+        std::vector<u8> m_input;
+        bool m_finished = false;
+    };
+
+    #if defined(IMHEX_ZLIB_SUPPORT)
+
+        class CompressedFileProvider::GZipDecoder : public Decoder {
+        public:
+            GZipDecoder(CompressedFileProvider &provider, const Checkpoint &checkpoint) : Decoder(provider, checkpoint) {
+                if (inflateInit2(&this->m_stream, -15) != Z_OK) {
+                    this->m_finished = true;
+                    return;
+                }
+
+                // The checkpoint may start in the middle of a byte, feed the remaining bits of it to the decompressor first
+                if (checkpoint.parameter != 0) {
+                    u8 byte = 0;
+                    if (this->m_provider.readCompressed(this->m_inputOffset - 1, &byte, 1) != 1) {
+                        this->m_finished = true;
+                        return;
+                    }
+
+                    inflatePrime(&this->m_stream, checkpoint.parameter, byte >> (8 - checkpoint.parameter));
+                }
+
+                const auto window = inflateWindow(checkpoint.window);
+                inflateSetDictionary(&this->m_stream, window.data(), window.size());
+            }
+
+            ~GZipDecoder() override {
+                inflateEnd(&this->m_stream);
+            }
+
+        protected:
+            size_t decode(u8 *buffer, size_t size) override {
+                size_t produced = 0;
+                while (produced < size && !this->m_finished) {
+                    if (this->m_stream.avail_in == 0) {
+                        this->m_stream.avail_in = this->readInput();
+                        this->m_stream.next_in  = this->m_input.data();
+
+                        if (this->m_stream.avail_in == 0) {
+                            this->m_finished = true;
+                            break;
+                        }
+                    }
+
+                    // Skip the trailer of the previous gzip member before the next one starts
+                    if (this->m_trailerBytes > 0) {
+                        const auto skipped = std::min<size_t>(this->m_trailerBytes, this->m_stream.avail_in);
+                        this->m_stream.next_in  += skipped;
+                        this->m_stream.avail_in -= skipped;
+                        this->m_trailerBytes    -= skipped;
+
+                        // Following members are decoded including their header and trailer
+                        if (this->m_trailerBytes == 0)
+                            inflateReset2(&this->m_stream, 31);
+
+                        continue;
+                    }
+
+                    this->m_stream.next_out  = buffer + produced;
+                    this->m_stream.avail_out = size - produced;
+
+                    const auto availableOut = this->m_stream.avail_out;
+                    const auto result = inflate(&this->m_stream, Z_NO_FLUSH);
+                    produced += availableOut - this->m_stream.avail_out;
+
+                    if (result == Z_STREAM_END) {
+                        if (this->m_rawDeflate)
+                            this->m_trailerBytes = 8;
+                        else
+                            inflateReset(&this->m_stream);
+
+                        this->m_rawDeflate = false;
+                    } else if (result != Z_OK && result != Z_BUF_ERROR) {
+                        this->m_finished = true;
+                    }
+                }
+
+                return produced;
+            }
+
+        private:
+            z_stream m_stream = { };
+
+            // The checkpoint's member is decoded as raw deflate data, so its trailer needs to be skipped manually
+            bool m_rawDeflate = true;
+            size_t m_trailerBytes = 0;
+        };
+
+    #endif
+
+    #if defined(IMHEX_LZMA_SUPPORT)
+
+        // Decodes a single block. The ones following it have checkpoints of their own
+        class CompressedFileProvider::XZDecoder : public Decoder {
+        public:
+            XZDecoder(CompressedFileProvider &provider, const Checkpoint &checkpoint) : Decoder(provider, checkpoint) {
+                this->m_finished = !this->initialize(checkpoint);
+            }
+
+            ~XZDecoder() override {
+                lzma_end(&this->m_stream);
+            }
+
+        protected:
+            size_t decode(u8 *buffer, size_t size) override {
+                size_t produced = 0;
+                while (produced < size && !this->m_finished) {
+                    if (this->m_stream.avail_in == 0) {
+                        this->m_stream.avail_in = this->readInput();
+                        this->m_stream.next_in  = this->m_input.data();
+
+                        if (this->m_stream.avail_in == 0) {
+                            this->m_finished = true;
+                            break;
+                        }
+                    }
+
+                    this->m_stream.next_out  = buffer + produced;
+                    this->m_stream.avail_out = size - produced;
+
+                    const auto availableOut = this->m_stream.avail_out;
+                    const auto result = lzma_code(&this->m_stream, LZMA_RUN);
+                    produced += availableOut - this->m_stream.avail_out;
+
+                    if (result != LZMA_OK)
+                        this->m_finished = true;
+                }
+
+                return produced;
+            }
+
+        private:
+            bool initialize(const Checkpoint &checkpoint) {
+                std::array<u8, LZMA_BLOCK_HEADER_SIZE_MAX> header = { };
+                if (this->m_provider.readCompressed(this->m_inputOffset, header.data(), 1) != 1)
+                    return false;
+
+                std::array<lzma_filter, LZMA_FILTERS_MAX + 1> filters = { };
+                lzma_block block = { };
+                block.version = 1;
+                block.check = lzma_check(checkpoint.parameter);
+                block.filters = filters.data();
+                block.header_size = lzma_block_header_size_decode(header[0]);
+
+                if (this->m_provider.readCompressed(this->m_inputOffset, header.data(), block.header_size) != block.header_size)
+                    return false;
+                if (lzma_block_header_decode(&block, nullptr, header.data()) != LZMA_OK)
+                    return false;
+
+                const auto initResult = lzma_block_decoder(&this->m_stream, &block);
+
+                for (auto &filter : filters)
+                    std::free(filter.options);
+
+                this->m_inputOffset += block.header_size;
+
+                return initResult == LZMA_OK;
+            }
+
+            lzma_stream m_stream = LZMA_STREAM_INIT;
+        };
+
+    #endif
+
+    #if defined(IMHEX_ZSTD_SUPPORT)
+
+        // Continues with the following frames once the checkpoint's one ended
+        class CompressedFileProvider::ZStdDecoder : public Decoder {
+        public:
+            ZStdDecoder(CompressedFileProvider &provider, const Checkpoint &checkpoint) : Decoder(provider, checkpoint), m_context(ZSTD_createDCtx()) {
+                this->m_finished = this->m_context == nullptr;
+            }
+
+            ~ZStdDecoder() override {
+                ZSTD_freeDCtx(this->m_context);
+            }
+
+        protected:
+            size_t decode(u8 *buffer, size_t size) override {
+                size_t produced = 0;
+                while (produced < size && !this->m_finished) {
+                    if (this->m_inBuffer.pos == this->m_inBuffer.size) {
+                        this->m_inBuffer = { this->m_input.data(), this->readInput(), 0 };
+
+                        if (this->m_inBuffer.size == 0) {
+                            this->m_finished = true;
+                            break;
+                        }
+                    }
+
+                    ZSTD_outBuffer outBuffer = { buffer + produced, size - produced, 0 };
+                    if (ZSTD_isError(ZSTD_decompressStream(this->m_context, &outBuffer, &this->m_inBuffer)))
+                        this->m_finished = true;
+
+                    produced += outBuffer.pos;
+                }
+
+                return produced;
+            }
+
+        private:
+            ZSTD_DCtx *m_context;
+            ZSTD_inBuffer m_inBuffer = { nullptr, 0, 0 };
+        };
+
+    #endif
+
+    CompressedFileProvider::CompressedFileProvider() : Provider(), m_cache([this](u64 offset, void *buffer, size_t size) { return this->decompress(offset, buffer, size); }, 256_KiB, 64_MiB) {
+        this->m_cache.setStatistics(&this->getIOStatistics());
+    }
+
+    CompressedFileProvider::~CompressedFileProvider() {
+        this->close();
+    }
+
+    void CompressedFileProvider::readRaw(u64 offset, void *buffer, size_t size) {
+        if ((offset + size) > this->getActualSize() || buffer == nullptr || size == 0)
+            return;
+
+        this->m_cache.read(offset, buffer, size);
+    }
+
+    void CompressedFileProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
+        hex::unused(offset, buffer, size);
+    }
+
+    size_t CompressedFileProvider::getActualSize() const {
+        return this->m_dataSize;
+    }
+
+    size_t CompressedFileProvider::readCompressed(u64 offset, void *buffer, size_t size) {
+        std::scoped_lock lock(this->m_fileMutex);
+
+        if (offset >= this->m_compressedSize)
+            return 0;
+
+        this->m_file.seek(offset);
+        return this->m_file.readBuffer(static_cast<u8 *>(buffer), std::min<u64>(size, this->m_compressedSize - offset));
+    }
+
+    CompressedFileProvider::Format CompressedFileProvider::detectFormat() {
+        std::array<u8, 6> magic = { };
+        if (this->readCompressed(0, magic.data(), magic.size()) != magic.size())
+            return Format::Unknown;
+
+        if (magic[0] == 0x1F && magic[1] == 0x8B)
+            return Format::GZip;
+        if (magic == std::array<u8, 6>{ 0xFD, '7', 'z', 'X', 'Z', 0x00 })
+            return Format::XZ;
+
+        const auto zstdMagic = readLittleEndian<u32>(magic.data());
+        if (zstdMagic == ZStdFrameMagic || (zstdMagic & 0xFFFFFFF0) == ZStdSkippableMagic)
+            return Format::ZStd;
+
+        return Format::Unknown;
+    }
+
+    void CompressedFileProvider::addCheckpoint(Checkpoint checkpoint) {
+        std::scoped_lock lock(this->m_indexMutex);
+
+        this->m_checkpoints.push_back(std::move(checkpoint));
+    }
+
+    std::optional<CompressedFileProvider::Checkpoint> CompressedFileProvider::findCheckpoint(u64 offset) const {
+        std::scoped_lock lock(this->m_indexMutex);
+
+        auto it = std::upper_bound(this->m_checkpoints.begin(), this->m_checkpoints.end(), offset, [](u64 offset, const Checkpoint &checkpoint) {
+            return offset < checkpoint.decompressedOffset;
+        });
+
+        if (it == this->m_checkpoints.begin())
+            return std::nullopt;
+
+        return *std::prev(it);
+    }
+
+
+    bool CompressedFileProvider::buildIndex() {
+        switch (this->m_format) {
+            case Format::GZip:
+                #if defined(IMHEX_ZLIB_SUPPORT)
+                    // Deflate streams can only be indexed by decompressing them entirely. Do that in the background and make the data available as it gets indexed
+                    this->m_indexThread = std::jthread([this](const std::stop_token &stopToken) {
+                        this->buildGZipIndex(stopToken);
+                    });
+                    return true;
+                #else
+                    return false;
+                #endif
+            case Format::XZ:
+                if (!this->buildXZIndex())
+                    return false;
+                break;
+            case Format::ZStd:
+                if (!this->buildZStdIndex())
+                    return false;
+                break;
+            default:
+                return false;
+        }
+
+        this->m_indexComplete = true;
+        this->m_cache.setDataSize(this->m_dataSize);
+        this->storeIndex();
+
+        return true;
+    }
+
+    void CompressedFileProvider::buildGZipIndex(const std::stop_token &stopToken) {
+        #if defined(IMHEX_ZLIB_SUPPORT)
+
+            z_stream stream = { };
+            if (inflateInit2(&stream, 47) != Z_OK)
+                return;
+            ON_SCOPE_EXIT { inflateEnd(&stream); };
+
+            std::vector<u8> input(InputChunkSize);
+            std::vector<u8> window(WindowSize);
+
+            u64 inputOffset = 0, totalIn = 0, totalOut = 0, lastCheckpoint = 0;
+            bool firstCheckpoint = true;
+
+            auto publishDataSize = [this](u64 size) {
+                const u64 oldSize = this->m_dataSize;
+                if (size <= oldSize)
+                    return;
+
+                this->m_dataSize = size;
+                this->m_cache.setDataSize(size);
+
+                TaskManager::doLater([this, oldSize, size] {
+                    const auto &providers = ImHexApi::Provider::getProviders();
+                    if (std::find(providers.begin(), providers.end(), this) != providers.end())
+                        EventManager::post<EventDataRangeChanged>(this, Region { this->getBaseAddress() + oldSize, size - oldSize });
+                });
+            };
+
+            int result = Z_OK;
+            while (result != Z_DATA_ERROR && !stopToken.stop_requested()) {
+                stream.avail_in = this->readCompressed(inputOffset, input.data(), input.size());
+                stream.next_in  = input.data();
+                inputOffset += stream.avail_in;
+
+                if (stream.avail_in == 0)
+                    break;
+
+                do {
+                    if (stream.avail_out == 0) {
+                        stream.avail_out = window.size();
+                        stream.next_out  = window.data();
+                    }
+
+                    totalIn  += stream.avail_in;
+                    totalOut += stream.avail_out;
+                    result = inflate(&stream, Z_BLOCK);
+                    totalIn  -= stream.avail_in;
+                    totalOut -= stream.avail_out;
+
+                    if (result == Z_NEED_DICT || result == Z_MEM_ERROR || result == Z_DATA_ERROR) {
+                        result = Z_DATA_ERROR;
+                        break;
+                    }
+
+                    if (result == Z_STREAM_END) {
+                        // Another gzip member may follow this one
+                        inflateReset(&stream);
+                        result = Z_OK;
+                        continue;
+                    }
+
+                    // Decompression can only be resumed at the start of a deflate block that isn't preceded by the final one
+                    const bool atBlockBoundary = (stream.data_type & 0x80) != 0 && (stream.data_type & 0x40) == 0;
+                    if (atBlockBoundary && (firstCheckpoint || totalOut - lastCheckpoint >= CheckpointSpan)) {
+                        std::vector<u8> lastWindow(WindowSize);
+                        const auto left = stream.avail_out;
+                        if (left > 0)
+                            std::memcpy(lastWindow.data(), window.data() + WindowSize - left, left);
+                        if (left < WindowSize)
+                            std::memcpy(lastWindow.data() + left, window.data(), WindowSize - left);
+
+                        this->addCheckpoint({ totalIn, totalOut, u8(stream.data_type & 0x07), deflateWindow(lastWindow.data(), lastWindow.size()) });
+
+                        publishDataSize(lastCheckpoint = totalOut);
+                        firstCheckpoint = false;
+                    }
+                } while (stream.avail_in != 0);
+            }
+
+            if (stopToken.stop_requested() || firstCheckpoint)
+                return;
+
+            publishDataSize(totalOut);
+            this->m_indexComplete = true;
+            this->storeIndex();
+
+        #else
+            hex::unused(stopToken);
+        #endif
+    }
+
+    bool CompressedFileProvider::buildXZIndex() {
+        #if defined(IMHEX_LZMA_SUPPORT)
+
+            // Every xz stream ends with an index of all its blocks, each of which can be decoded independently. Walk the streams back to front to collect them
+            lzma_index *combinedIndex = nullptr;
+            ON_SCOPE_EXIT { lzma_index_end(combinedIndex, nullptr); };
+
+            u64 position = this->m_compressedSize;
+            u64 streamPadding = 0;
+            while (position > 0) {
+                std::array<u8, LZMA_STREAM_HEADER_SIZE> footer = { };
+                if (position < 2 * LZMA_STREAM_HEADER_SIZE || this->readCompressed(position - footer.size(), footer.data(), footer.size()) != footer.size())
+                    return false;
+
+                // Streams may be followed by padding made up of zero bytes
+                if (readLittleEndian<u32>(footer.data() + footer.size() - 4) == 0) {
+                    position      -= 4;
+                    streamPadding += 4;
+                    continue;
+                }
+
+                lzma_stream_flags footerFlags;
+                if (lzma_stream_footer_decode(&footerFlags, footer.data()) != LZMA_OK)
+                    return false;
+
+                const u64 footerPosition = position - footer.size();
+                if (footerPosition < footerFlags.backward_size + LZMA_STREAM_HEADER_SIZE)
+                    return false;
+
+                std::vector<u8> indexData(footerFlags.backward_size);
+                if (this->readCompressed(footerPosition - indexData.size(), indexData.data(), indexData.size()) != indexData.size())
+                    return false;
+
+                lzma_index *index = nullptr;
+                u64 memoryLimit = UINT64_MAX;
+                size_t indexPosition = 0;
+                if (lzma_index_buffer_decode(&index, &memoryLimit, nullptr, indexData.data(), &indexPosition, indexData.size()) != LZMA_OK)
+                    return false;
+
+                const auto streamSize = lzma_index_stream_size(index);
+                if (streamSize > position) {
+                    lzma_index_end(index, nullptr);
+                    return false;
+                }
+
+                lzma_index_stream_flags(index, &footerFlags);
+                lzma_index_stream_padding(index, streamPadding);
+
+                if (combinedIndex != nullptr && lzma_index_cat(index, combinedIndex, nullptr) != LZMA_OK) {
+                    lzma_index_end(index, nullptr);
+                    return false;
+                }
+
+                combinedIndex = index;
+                position -= streamSize;
+                streamPadding = 0;
+            }
+
+            if (combinedIndex == nullptr)
+                return false;
+
+            lzma_index_iter iterator;
+            lzma_index_iter_init(&iterator, combinedIndex);
+            while (!lzma_index_iter_next(&iterator, LZMA_INDEX_ITER_NONEMPTY_BLOCK)) {
+                this->addCheckpoint({ iterator.block.compressed_file_offset, iterator.block.uncompressed_file_offset, u8(iterator.stream.flags->check), { } });
+            }
+
+            this->m_dataSize = lzma_index_uncompressed_size(combinedIndex);
+
+            return !this->m_checkpoints.empty();
+
+        #else
+            return false;
+        #endif
+    }
+
+    bool CompressedFileProvider::buildZStdIndex() {
+        #if defined(IMHEX_ZSTD_SUPPORT)
+
+            struct Frame {
+                u64 compressedOffset, compressedSize;
+                std::optional<u64> decompressedSize;
+            };
+
+            std::vector<Frame> frames;
+
+            // Seekable zstd files end with a skippable frame containing the sizes of all frames
+            std::array<u8, 9> footer = { };
+            if (this->m_compressedSize > footer.size() && this->readCompressed(this->m_compressedSize - footer.size(), footer.data(), footer.size()) == footer.size() && readLittleEndian<u32>(footer.data() + 5) == ZStdSeekableMagic) {
+                const auto frameCount = readLittleEndian<u32>(footer.data());
+                const auto entrySize  = (footer[4] & 0x80) != 0 ? 12 : 8;
+
+                std::vector<u8> table(u64(frameCount) * entrySize);
+                if (this->m_compressedSize < table.size() + footer.size() || this->readCompressed(this->m_compressedSize - footer.size() - table.size(), table.data(), table.size()) != table.size())
+                    return false;
+
+                u64 compressedOffset = 0;
+                for (u32 i = 0; i < frameCount; i++) {
+                    const auto entry = table.data() + i * entrySize;
+                    const auto compressedSize = readLittleEndian<u32>(entry);
+
+                    frames.push_back({ compressedOffset, compressedSize, readLittleEndian<u32>(entry + 4) });
+                    compressedOffset += compressedSize;
+                }
+            } else {
+                // Otherwise walk all frame and block headers, which doesn't require decompressing anything
+                u64 offset = 0;
+                std::array<u8, 18> header = { };
+                while (offset < this->m_compressedSize) {
+                    if (this->readCompressed(offset, header.data(), 8) < 8)
+                        break;
+
+                    const auto magic = readLittleEndian<u32>(header.data());
+                    if ((magic & 0xFFFFFFF0) == ZStdSkippableMagic) {
+                        offset += 8 + readLittleEndian<u32>(header.data() + 4);
+                        continue;
+                    }
+
+                    if (magic != ZStdFrameMagic)
+                        return false;
+
+                    const u8 descriptor    = header[4];
+                    const bool singleSegment = (descriptor & 0x20) != 0;
+                    const bool hasChecksum   = (descriptor & 0x04) != 0;
+                    const u8 dictionaryIdSize = std::array<u8, 4>{ 0, 1, 2, 4 }[descriptor & 0x03];
+                    const u8 contentSizeFlag  = descriptor >> 6;
+                    const u8 contentSizeSize  = std::array<u8, 4>{ u8(singleSegment ? 1 : 0), 2, 4, 8 }[contentSizeFlag];
+
+                    const u64 headerSize = 5 + (singleSegment ? 0 : 1) + dictionaryIdSize + contentSizeSize;
+                    if (this->readCompressed(offset, header.data(), headerSize) != headerSize)
+                        return false;
+
+                    std::optional<u64> decompressedSize;
+                    if (contentSizeSize > 0) {
+                        decompressedSize = readLittleEndian<u64>(header.data() + headerSize - contentSizeSize, contentSizeSize);
+                        if (contentSizeSize == 2)
+                            *decompressedSize += 256;
+                    }
+
+                    u64 frameEnd = offset + headerSize;
+                    while (true) {
+                        std::array<u8, 3> blockHeader = { };
+                        if (this->readCompressed(frameEnd, blockHeader.data(), blockHeader.size()) != blockHeader.size())
+                            return false;
+
+                        const auto value = readLittleEndian<u32>(blockHeader.data(), blockHeader.size());
+                        const auto type  = (value >> 1) & 0x03;
+                        frameEnd += blockHeader.size() + (type == 1 ? 1 : (value >> 3));
+
+                        if ((value & 0x01) != 0)
+                            break;
+                    }
+
+                    if (hasChecksum)
+                        frameEnd += 4;
+
+                    frames.push_back({ offset, frameEnd - offset, decompressedSize });
+                    offset = frameEnd;
+                }
+
+                // Frames that don't store their decompressed size need to be decompressed to find it. Do that for all of them in parallel
+                std::vector<std::future<void>> futures;
+                const auto threadCount = std::max<u32>(std::thread::hardware_concurrency(), 1);
+                for (u32 thread = 0; thread < threadCount; thread++) {
+                    futures.push_back(std::async(std::launch::async, [&, thread] {
+                        fs::File file(this->m_path, fs::File::Mode::Read);
+                        auto context = ZSTD_createDCtx();
+                        ON_SCOPE_EXIT { ZSTD_freeDCtx(context); };
+
+                        std::vector<u8> input(InputChunkSize), output(ZSTD_DStreamOutSize());
+                        for (size_t i = thread; i < frames.size(); i += threadCount) {
+                            auto &frame = frames[i];
+                            if (frame.decompressedSize.has_value())
+                                continue;
+
+                            ZSTD_DCtx_reset(context, ZSTD_reset_session_only);
+                            file.seek(frame.compressedOffset);
+
+                            u64 decompressedSize = 0;
+                            for (u64 consumed = 0; consumed < frame.compressedSize;) {
+                                ZSTD_inBuffer inBuffer = { input.data(), file.readBuffer(input.data(), std::min<u64>(input.size(), frame.compressedSize - consumed)), 0 };
+                                if (inBuffer.size == 0)
+                                    break;
+                                consumed += inBuffer.size;
+
+                                while (inBuffer.pos < inBuffer.size) {
+                                    ZSTD_outBuffer outBuffer = { output.data(), output.size(), 0 };
+                                    if (ZSTD_isError(ZSTD_decompressStream(context, &outBuffer, &inBuffer)))
+                                        return;
+
+                                    decompressedSize += outBuffer.pos;
+                                }
+                            }
+
+                            frame.decompressedSize = decompressedSize;
+                        }
+                    }));
+                }
+
+                for (auto &future : futures)
+                    future.wait();
+            }
+
+            u64 decompressedOffset = 0;
+            for (const auto &frame : frames) {
+                if (!frame.decompressedSize.has_value())
+                    return false;
+
+                if (*frame.decompressedSize > 0)
+                    this->addCheckpoint({ frame.compressedOffset, decompressedOffset, 0, { } });
+
+                decompressedOffset += *frame.decompressedSize;
+            }
+
+            this->m_dataSize = decompressedOffset;
+
+            return !this->m_checkpoints.empty();
+
+        #else
+            return false;
+        #endif
+    }
+
+
+    std::fs::path CompressedFileProvider::getIndexPath() const {
+        for (const auto &path : fs::getDefaultPaths(fs::ImHexPath::Config)) {
+            if (fs::isPathWritable(path))
+                return path / "indices" / hex::format("{:016X}.idx", std::hash<std::string>{}(hex::toUTF8String(this->m_path)));
+        }
+
+        return { };
+    }
+
+    bool CompressedFileProvider::loadIndex() {
+        const auto indexPath = this->getIndexPath();
+        if (indexPath.empty())
+            return false;
+
+        fs::File file(indexPath, fs::File::Mode::Read);
+        if (!file.isValid())
+            return false;
+
+        // All values are stored in little endian so indices stay valid no matter which machine created them
+        const auto data = file.readBytes(file.getSize());
+        size_t position = 0;
+
+        auto readValue = [&]<typename T>(T &value) {
+            if (data.size() - position < sizeof(T))
+                return false;
+
+            value = T(readLittleEndian<u64>(data.data() + position, sizeof(T)));
+            position += sizeof(T);
+
+            return true;
+        };
+
+        auto readBytes = [&](size_t size) -> std::optional<std::vector<u8>> {
+            if (data.size() - position < size)
+                return std::nullopt;
+
+            position += size;
+            return std::vector<u8>(data.begin() + (position - size), data.begin() + position);
+        };
+
+        const auto magic = readBytes(IndexMagic.size());
+        u32 version = 0;
+        u8 format = 0;
+        u64 compressedSize = 0, dataSize = 0, count = 0;
+        i64 modificationTime = 0;
+        if (!magic.has_value() || !readValue(version) || !readValue(format) || !readValue(compressedSize) || !readValue(modificationTime) || !readValue(dataSize) || !readValue(count))
+            return false;
+
+        // Discard indices of files that have been modified since the index was created
+        std::error_code error;
+        const auto lastWriteTime = std::fs::last_write_time(this->m_path, error).time_since_epoch().count();
+        if (!std::equal(IndexMagic.begin(), IndexMagic.end(), magic->begin()) || version != IndexVersion || Format(format) != this->m_format || compressedSize != this->m_compressedSize || modificationTime != lastWriteTime)
+            return false;
+
+        std::vector<Checkpoint> checkpoints;
+        for (u64 i = 0; i < count; i++) {
+            Checkpoint checkpoint = { };
+            u32 windowSize = 0;
+            if (!readValue(checkpoint.compressedOffset) || !readValue(checkpoint.decompressedOffset) || !readValue(checkpoint.parameter) || !readValue(windowSize))
+                return false;
+
+            auto window = readBytes(windowSize);
+            if (!window.has_value())
+                return false;
+
+            checkpoint.window = std::move(*window);
+            checkpoints.push_back(std::move(checkpoint));
+        }
+
+        {
+            std::scoped_lock lock(this->m_indexMutex);
+            this->m_checkpoints = std::move(checkpoints);
+        }
+
+        this->m_dataSize = dataSize;
+        this->m_indexComplete = true;
+        this->m_cache.setDataSize(dataSize);
+
+        return true;
+    }
+
+    void CompressedFileProvider::storeIndex() const {
+        const auto indexPath = this->getIndexPath();
+        if (indexPath.empty())
+            return;
+
+        fs::createDirectories(indexPath.parent_path());
+
+        fs::File file(indexPath, fs::File::Mode::Create);
+        if (!file.isValid())
+            return;
+
+        std::error_code error;
+        const i64 modificationTime = std::fs::last_write_time(this->m_path, error).time_since_epoch().count();
+
+        std::vector<u8> data(IndexMagic.begin(), IndexMagic.end());
+        appendLittleEndian(data, IndexVersion);
+        appendLittleEndian(data, u8(this->m_format));
+        appendLittleEndian(data, this->m_compressedSize);
+        appendLittleEndian(data, modificationTime);
+        appendLittleEndian(data, this->m_dataSize.load());
+
+        {
+            std::scoped_lock lock(this->m_indexMutex);
+
+            appendLittleEndian(data, u64(this->m_checkpoints.size()));
+            for (const auto &checkpoint : this->m_checkpoints) {
+                appendLittleEndian(data, checkpoint.compressedOffset);
+                appendLittleEndian(data, checkpoint.decompressedOffset);
+                appendLittleEndian(data, checkpoint.parameter);
+                appendLittleEndian(data, u32(checkpoint.window.size()));
+                data.insert(data.end(), checkpoint.window.begin(), checkpoint.window.end());
+            }
+        }
+
+        file.write(data);
+    }
+
+
+    std::unique_ptr<CompressedFileProvider::Decoder> CompressedFileProvider::takeDecoder(const Checkpoint &checkpoint, u64 offset) {
+        {
+            std::scoped_lock lock(this->m_decoderMutex);
+
+            // Continue with the decoder that has the least data left to skip
+            auto best = this->m_decoders.end();
+            for (auto it = this->m_decoders.begin(); it != this->m_decoders.end(); ++it) {
+                if ((*it)->canContinueAt(checkpoint, offset) && (best == this->m_decoders.end() || (*it)->getPosition() > (*best)->getPosition()))
+                    best = it;
+            }
+
+            if (best != this->m_decoders.end()) {
+                auto decoder = std::move(*best);
+                this->m_decoders.erase(best);
+
+                return decoder;
+            }
+        }
+
+        switch (this->m_format) {
+            #if defined(IMHEX_ZLIB_SUPPORT)
+                case Format::GZip:
+                    return std::make_unique<GZipDecoder>(*this, checkpoint);
+            #endif
+            #if defined(IMHEX_LZMA_SUPPORT)
+                case Format::XZ:
+                    return std::make_unique<XZDecoder>(*this, checkpoint);
+            #endif
+            #if defined(IMHEX_ZSTD_SUPPORT)
+                case Format::ZStd:
+                    return std::make_unique<ZStdDecoder>(*this, checkpoint);
+            #endif
+            default:
+                return nullptr;
+        }
+    }
+
+    void CompressedFileProvider::returnDecoder(std::unique_ptr<Decoder> decoder) {
+        if (decoder == nullptr || decoder->isFinished())
+            return;
+
+        std::scoped_lock lock(this->m_decoderMutex);
+
+        // A few of them so parallel readers don't keep taking them away from each other. Their state can be large, so not too many
+        this->m_decoders.push_back(std::move(decoder));
+        if (this->m_decoders.size() > MaxDecoders)
+            this->m_decoders.erase(this->m_decoders.begin());
+    }
+
+    std::vector<Region> CompressedFileProvider::decompress(u64 offset, void *buffer, size_t size) {
+        auto bytes = static_cast<u8 *>(buffer);
+
+        // Decompress starting at the closest checkpoint in front of the requested data and continue with the next one if a frame or block ends early
+        while (size > 0) {
+            auto checkpoint = this->findCheckpoint(offset);
+            if (!checkpoint.has_value())
+                break;
+
+            auto decoder = this->takeDecoder(*checkpoint, offset);
+            if (decoder == nullptr)
+                break;
+
+            const auto decompressedSize = decoder->read(offset, bytes, size);
+            this->returnDecoder(std::move(decoder));
+
+            if (decompressedSize == 0)
+                break;
+
+            offset += decompressedSize;
+            bytes  += decompressedSize;
+            size   -= decompressedSize;
+        }
+
+        if (size == 0)
+            return { };
+
+        // Data that couldn't be decompressed reads as zeros but doesn't end up in the cache, so it's attempted again the next time
+        std::memset(bytes, 0x00, size);
+        return { Region { offset, size } };
+    }
+
+
+    bool CompressedFileProvider::open() {
+        this->m_file = fs::File(this->m_path, fs::File::Mode::Read);
+        if (!this->m_file.isValid())
+            return false;
+
+        this->m_compressedSize = this->m_file.getSize();
+        this->m_format = this->detectFormat();
+        if (this->m_format == Format::Unknown)
+            return false;
+
+        if (!this->loadIndex() && !this->buildIndex())
+            return false;
+
+        this->m_dataValid = true;
+
+        return true;
+    }
+
+    void CompressedFileProvider::close() {
+        if (this->m_indexThread.joinable()) {
+            this->m_indexThread.request_stop();
+            this->m_indexThread.join();
+        }
+
+        {
+            std::scoped_lock lock(this->m_indexMutex);
+            this->m_checkpoints.clear();
+        }
+
+        {
+            std::scoped_lock lock(this->m_decoderMutex);
+            this->m_decoders.clear();
+        }
+
+        this->m_cache.setDataSize(0);
+        this->m_dataSize = 0;
+        this->m_indexComplete = false;
+        this->m_dataValid = false;
+
+        this->m_file.close();
+    }
+
+    std::string CompressedFileProvider::getName() const {
+        return hex::format("hex.builtin.provider.compressed_file.name"_lang, hex::toUTF8String(this->m_path.filename()));
+    }
+
+    std::vector<std::pair<std::string, std::string>> CompressedFileProvider::getDataInformation() const {
+        std::vector<std::pair<std::string, std::string>> result;
+
+        const char *format = "";
+        switch (this->m_format) {
+            case Format::GZip: format = "GZip"; break;
+            case Format::XZ:   format = "XZ";   break;
+            case Format::ZStd: format = "ZStandard"; break;
+            default: break;
+        }
+
+        size_t checkpointCount;
+        {
+            std::scoped_lock lock(this->m_indexMutex);
+            checkpointCount = this->m_checkpoints.size();
+        }
+
+        result.emplace_back("hex.builtin.provider.file.path"_lang, hex::toUTF8String(this->m_path));
+        result.emplace_back("hex.builtin.provider.compressed_file.format"_lang, format);
+        result.emplace_back("hex.builtin.provider.compressed_file.compressed_size"_lang, hex::toByteString(this->m_compressedSize));
+        result.emplace_back("hex.builtin.provider.file.size"_lang, hex::toByteString(this->getActualSize()));
+        result.emplace_back("hex.builtin.provider.compressed_file.checkpoints"_lang, hex::format("{}{}", checkpointCount, this->m_indexComplete ? "" : " ..."));
+
+        return result;
+    }
+
+    bool CompressedFileProvider::handleFilePicker() {
+        return fs::openFileBrowser(fs::DialogMode::Open, { { "Compressed File", "gz,xz,zst" } }, [this](const std::fs::path &path) {
+            this->m_path = path;
+        });
+    }
+
+    void CompressedFileProvider::loadSettings(const nlohmann::json &settings) {
+        Provider::loadSettings(settings);
+
+        auto path = settings["path"].get<std::string>();
+        this->m_path = std::u8string(path.begin(), path.end());
+    }
+
+    nlohmann::json CompressedFileProvider::storeSettings(nlohmann::json settings) const {
+        settings["path"] = hex::toUTF8String(this->m_path);
+
+        return Provider::storeSettings(settings);
+    }
+
+}
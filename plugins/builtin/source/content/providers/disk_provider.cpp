@@ -3,10 +3,13 @@
 #include <hex/api/localization.hpp>
 
 #include <hex/helpers/fmt.hpp>
+#include <hex/helpers/logger.hpp>
 #include <hex/helpers/utils.hpp>
 #include <hex/ui/imgui_imhex_extensions.h>
 
 #include <bitset>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
 
 #include <imgui.h>
@@ -16,20 +19,58 @@
 #elif defined(OS_LINUX) || defined(OS_MACOS)
     #include <fcntl.h>
     #include <unistd.h>
+    #include <sys/ioctl.h>
     #include <sys/stat.h>
     #include <sys/types.h>
 #endif
 
 #if defined(OS_LINUX)
-    #define lseek lseek64
+    #include <linux/fs.h>
+#elif defined(OS_MACOS)
+    #include <sys/disk.h>
 #endif
 
 namespace hex::plugin::builtin::prv {
 
-    DiskProvider::DiskProvider() : Provider() {
+    using namespace hex::literals;
+
+    namespace {
+
+        // Unbuffered I/O requires the memory to be aligned as well, which std::vector doesn't guarantee
+        class AlignedBuffer {
+        public:
+            AlignedBuffer(size_t size, size_t alignment) : m_storage(size + alignment), m_size(size) {
+                const auto misalignment = reinterpret_cast<uintptr_t>(this->m_storage.data()) % alignment;
+                this->m_data = this->m_storage.data() + (misalignment == 0 ? 0 : alignment - misalignment);
+            }
+
+            [[nodiscard]] u8 *data() { return this->m_data; }
+            [[nodiscard]] size_t size() const { return this->m_size; }
+
+        private:
+            std::vector<u8> m_storage;
+            u8 *m_data;
+            size_t m_size;
+        };
+
+        constexpr u64 alignUp(u64 value, u64 alignment) {
+            return ((value + alignment - 1) / alignment) * alignment;
+        }
 
     }
 
+    DiskProvider::DiskProvider() : Provider(), m_cache([this](u64 offset, void *buffer, size_t size) -> std::vector<Region> {
+        // Whatever couldn't be read, e.g. because of bad sectors, reads as zeros but isn't cached so it's attempted again the next time
+        const auto bytesRead = this->readSectors(offset, buffer, size);
+        if (bytesRead >= size)
+            return { };
+
+        std::memset(static_cast<u8 *>(buffer) + bytesRead, 0x00, size - bytesRead);
+        return { Region { offset + bytesRead, size - bytesRead } };
+    }) {
+        this->m_cache.setStatistics(&this->getIOStatistics());
+    }
+
     bool DiskProvider::isAvailable() const {
         #if defined(OS_WINDOWS)
 
@@ -71,9 +112,12 @@ namespace hex::plugin::builtin::prv {
 
             const auto &path = this->m_path.native();
 
-            this->m_diskHandle = reinterpret_cast<HANDLE>(CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+            const DWORD flags = FILE_ATTRIBUTE_NORMAL | (this->m_directIO ? FILE_FLAG_NO_BUFFERING : 0);
+            this->m_unbuffered = this->m_directIO;
+
+            this->m_diskHandle = reinterpret_cast<HANDLE>(CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr));
             if (this->m_diskHandle == INVALID_HANDLE_VALUE) {
-                this->m_diskHandle = reinterpret_cast<HANDLE>(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+                this->m_diskHandle = reinterpret_cast<HANDLE>(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr));
                 this->m_writable   = false;
 
                 if (this->m_diskHandle == INVALID_HANDLE_VALUE)
@@ -94,8 +138,10 @@ namespace hex::plugin::builtin::prv {
                         nullptr)) {
                     this->m_diskSize   = diskGeometry.DiskSize.QuadPart;
                     this->m_sectorSize = diskGeometry.Geometry.BytesPerSector;
-                    this->m_sectorBuffer.resize(this->m_sectorSize);
                 }
+
+                if (this->m_sectorSize == 0)
+                    this->m_sectorSize = 512;
             }
 
             if (this->m_diskHandle == nullptr || this->m_diskHandle == INVALID_HANDLE_VALUE) {
@@ -110,28 +156,73 @@ namespace hex::plugin::builtin::prv {
 
             const auto &path = this->m_path.native();
 
-            struct stat driveStat;
+            auto openDisk = [&](int flags) {
+                this->m_writable   = true;
+                this->m_diskHandle = ::open(path.c_str(), O_RDWR | flags);
+                if (this->m_diskHandle == -1) {
+                    this->m_diskHandle = ::open(path.c_str(), O_RDONLY | flags);
+                    this->m_writable   = false;
+                }
+            };
 
-            if (::stat(path.c_str(), &driveStat) == 0)
-                this->m_diskSize   = driveStat.st_size;
-            else
-                this->m_diskSize = 0;
+            #if defined(O_DIRECT)
+                this->m_unbuffered = this->m_directIO;
+                openDisk(this->m_unbuffered ? O_DIRECT : 0);
 
-            this->m_sectorSize = 0;
+                // Not every filesystem supports O_DIRECT, fall back to buffered I/O there
+                if (this->m_diskHandle == -1 && this->m_unbuffered) {
+                    this->m_unbuffered = false;
+                    openDisk(0);
+                }
+            #else
+                openDisk(0);
 
-            this->m_diskHandle = ::open(path.c_str(), O_RDWR);
-            if (this->m_diskHandle == -1) {
-                this->m_diskHandle = ::open(path.c_str(), O_RDONLY);
-                this->m_writable   = false;
-            }
+                #if defined(OS_MACOS)
+                    if (this->m_diskHandle != -1 && this->m_directIO)
+                        ::fcntl(this->m_diskHandle, F_NOCACHE, 1);
+                #endif
+            #endif
 
             if (this->m_diskHandle == -1) {
                 this->m_readable = false;
                 return false;
             }
 
+            this->m_diskSize   = 0;
+            this->m_sectorSize = 512;
+
+            struct stat driveStat;
+            if (::fstat(this->m_diskHandle, &driveStat) == 0) {
+                this->m_diskSize = driveStat.st_size;
+
+                // Block devices report a size of zero, so their geometry has to be queried from the driver
+                #if defined(OS_LINUX)
+                    if (S_ISBLK(driveStat.st_mode)) {
+                        u64 diskSize = 0;
+                        if (::ioctl(this->m_diskHandle, BLKGETSIZE64, &diskSize) == 0)
+                            this->m_diskSize = diskSize;
+
+                        int sectorSize = 0;
+                        if (::ioctl(this->m_diskHandle, BLKSSZGET, &sectorSize) == 0 && sectorSize > 0)
+                            this->m_sectorSize = sectorSize;
+                    }
+                #elif defined(OS_MACOS)
+                    if (S_ISBLK(driveStat.st_mode) || S_ISCHR(driveStat.st_mode)) {
+                        u32 blockSize  = 0;
+                        u64 blockCount = 0;
+                        if (::ioctl(this->m_diskHandle, DKIOCGETBLOCKSIZE, &blockSize) == 0 && ::ioctl(this->m_diskHandle, DKIOCGETBLOCKCOUNT, &blockCount) == 0 && blockSize > 0) {
+                            this->m_sectorSize = blockSize;
+                            this->m_diskSize   = blockSize * blockCount;
+                        }
+                    }
+                #endif
+            }
+
         #endif
 
+        this->m_cache.setDataSize(this->m_diskSize);
+        this->m_cache.clear();
+
         return true;
     }
 
@@ -151,107 +242,147 @@ namespace hex::plugin::builtin::prv {
             this->m_diskHandle = -1;
 
         #endif
+
+        this->m_cache.clear();
     }
 
     void DiskProvider::readRaw(u64 offset, void *buffer, size_t size) {
-        #if defined(OS_WINDOWS)
-
-            DWORD bytesRead = 0;
-
-            u64 startOffset = offset;
+        this->m_cache.read(offset, buffer, size);
+    }
 
-            while (size > 0) {
-                LARGE_INTEGER seekPosition;
-                seekPosition.LowPart  = (offset & 0xFFFF'FFFF) - (offset % this->m_sectorSize);
-                seekPosition.HighPart = offset >> 32;
+    size_t DiskProvider::readSectors(u64 offset, void *buffer, size_t size) {
+        // Called by the block cache with block aligned offsets, which are always sector aligned as well.
+        // Unbuffered I/O additionally needs sector aligned sizes and buffers, so other reads go through a bounce buffer
+        if (this->m_unbuffered && (reinterpret_cast<uintptr_t>(buffer) % this->getIOAlignment() != 0 || size % this->m_sectorSize != 0)) {
+            AlignedBuffer sectors(alignUp(size, this->m_sectorSize), this->getIOAlignment());
+            const auto bytesRead = std::min(this->readSectors(offset, sectors.data(), sectors.size()), size);
+            std::memcpy(buffer, sectors.data(), bytesRead);
 
-                if (this->m_sectorBufferAddress != static_cast<u64>(seekPosition.QuadPart)) {
-                    ::SetFilePointer(this->m_diskHandle, seekPosition.LowPart, &seekPosition.HighPart, FILE_BEGIN);
-                    ::ReadFile(this->m_diskHandle, this->m_sectorBuffer.data(), this->m_sectorBuffer.size(), &bytesRead, nullptr);
-                    this->m_sectorBufferAddress = seekPosition.QuadPart;
-                }
+            return bytesRead;
+        }
 
-                std::memcpy(reinterpret_cast<u8 *>(buffer) + (offset - startOffset), this->m_sectorBuffer.data() + (offset & (this->m_sectorSize - 1)), std::min(this->m_sectorSize, size));
+        auto bytes = static_cast<u8 *>(buffer);
+        size_t totalRead = 0;
 
-                size = std::max<ssize_t>(static_cast<ssize_t>(size) - this->m_sectorSize, 0);
-                offset += this->m_sectorSize;
-            }
+        // Only positional reads are used so multiple threads can read from the disk at the same time
+        while (size > 0) {
+            #if defined(OS_WINDOWS)
 
-        #else
+                OVERLAPPED overlapped = { };
+                overlapped.Offset     = offset & 0xFFFF'FFFF;
+                overlapped.OffsetHigh = offset >> 32;
 
-        u64 startOffset    = offset;
+                DWORD bytesRead = 0;
+                if (!::ReadFile(this->m_diskHandle, bytes, static_cast<DWORD>(std::min<size_t>(size, 0x8000'0000)), &bytesRead, &overlapped) || bytesRead == 0)
+                    break;
 
-        while (size > 0) {
-            u64 seekPosition = offset - (offset % this->m_sectorSize);
+            #else
 
-            if (this->m_sectorBufferAddress != seekPosition) {
-                ::lseek(this->m_diskHandle, seekPosition, SEEK_SET);
-                if (::read(this->m_diskHandle, buffer, size) < 0)
+                auto bytesRead = ::pread(this->m_diskHandle, bytes, size, offset);
+                if (bytesRead < 0 && errno == EINTR)
+                    continue;
+                if (bytesRead <= 0)
                     break;
 
-                this->m_sectorBufferAddress = seekPosition;
-            }
-
-            std::memcpy(reinterpret_cast<u8 *>(buffer) + (offset - startOffset), this->m_sectorBuffer.data() + (offset & (this->m_sectorSize - 1)), std::min(this->m_sectorSize, size));
+            #endif
 
-            size = std::max<ssize_t>(static_cast<ssize_t>(size) - this->m_sectorSize, 0);
-            offset += this->m_sectorSize;
+            bytes += bytesRead;
+            offset += bytesRead;
+            size -= bytesRead;
+            totalRead += bytesRead;
         }
 
-        #endif
+        return totalRead;
     }
 
-    void DiskProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
-        #if defined(OS_WINDOWS)
+    bool DiskProvider::writeSectors(u64 offset, const void *buffer, size_t size) {
+        auto bytes = static_cast<const u8 *>(buffer);
 
-            DWORD bytesWritten = 0;
+        while (size > 0) {
+            #if defined(OS_WINDOWS)
 
-            u64 startOffset = offset;
+                OVERLAPPED overlapped = { };
+                overlapped.Offset     = offset & 0xFFFF'FFFF;
+                overlapped.OffsetHigh = offset >> 32;
 
-            std::vector<u8> modifiedSectorBuffer;
-            modifiedSectorBuffer.resize(this->m_sectorSize);
+                DWORD bytesWritten = 0;
+                if (!::WriteFile(this->m_diskHandle, bytes, static_cast<DWORD>(std::min<size_t>(size, 0x8000'0000)), &bytesWritten, &overlapped) || bytesWritten == 0)
+                    return false;
 
-            while (size > 0) {
-                u64 sectorBase  = offset - (offset % this->m_sectorSize);
-                size_t currSize = std::min(size, this->m_sectorSize);
+            #else
 
-                this->readRaw(sectorBase, modifiedSectorBuffer.data(), modifiedSectorBuffer.size());
-                std::memcpy(modifiedSectorBuffer.data() + ((offset - sectorBase) % this->m_sectorSize), reinterpret_cast<const u8 *>(buffer) + (startOffset - offset), currSize);
+                auto bytesWritten = ::pwrite(this->m_diskHandle, bytes, size, offset);
+                if (bytesWritten <= 0)
+                    return false;
 
-                LARGE_INTEGER seekPosition;
-                seekPosition.LowPart  = (offset & 0xFFFF'FFFF) - (offset % this->m_sectorSize);
-                seekPosition.HighPart = offset >> 32;
+            #endif
 
-                ::SetFilePointer(this->m_diskHandle, seekPosition.LowPart, &seekPosition.HighPart, FILE_BEGIN);
-                ::WriteFile(this->m_diskHandle, modifiedSectorBuffer.data(), modifiedSectorBuffer.size(), &bytesWritten, nullptr);
+            bytes += bytesWritten;
+            offset += bytesWritten;
+            size -= bytesWritten;
+        }
 
-                offset += currSize;
-                size -= currSize;
-            }
+        return true;
+    }
 
-        #else
+    void DiskProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
+        if (size == 0 || offset + size > this->m_diskSize)
+            return;
 
-            u64 startOffset = offset;
+        constexpr static size_t MaxWriteSize = 16_MiB;
 
-            std::vector<u8> modifiedSectorBuffer;
-            modifiedSectorBuffer.resize(this->m_sectorSize);
+        // Writes have to cover whole sectors. Only the first and last sector may be partially modified and need to be read back first
+        std::scoped_lock lock(this->m_writeMutex);
 
-            while (size > 0) {
-                u64 sectorBase  = offset - (offset % this->m_sectorSize);
-                size_t currSize = std::min(size, this->m_sectorSize);
+        const u64 endOffset = offset + size;
+        const u64 alignedStart = offset - (offset % this->m_sectorSize);
+        u64 alignedEnd = alignUp(endOffset, this->m_sectorSize);
 
-                this->readRaw(sectorBase, modifiedSectorBuffer.data(), modifiedSectorBuffer.size());
-                std::memcpy(modifiedSectorBuffer.data() + ((offset - sectorBase) % this->m_sectorSize), reinterpret_cast<const u8 *>(buffer) + (startOffset - offset), currSize);
+        #if defined(OS_WINDOWS)
+            alignedEnd = std::min<u64>(alignedEnd, this->m_diskSize);
+        #else
+            // Unbuffered writes can't end in the middle of a sector. Image files whose size isn't a multiple of it get truncated back afterwards instead
+            if (!this->m_unbuffered)
+                alignedEnd = std::min<u64>(alignedEnd, this->m_diskSize);
+        #endif
 
-                ::lseek(this->m_diskHandle, sectorBase, SEEK_SET);
-                if (::write(this->m_diskHandle, modifiedSectorBuffer.data(), modifiedSectorBuffer.size()) < 0)
-                    break;
+        AlignedBuffer sectors(std::min<u64>(alignedEnd - alignedStart, alignUp(MaxWriteSize, this->m_sectorSize)), this->getIOAlignment());
+        for (u64 chunkStart = alignedStart; chunkStart < alignedEnd; chunkStart += sectors.size()) {
+            const u64 chunkEnd = std::min<u64>(chunkStart + sectors.size(), alignedEnd);
+
+            // Writing back sectors that couldn't be read would overwrite their unmodified bytes with garbage
+            auto readBack = [&](u64 sectorOffset, size_t sectorSize) {
+                const auto bytesRead = this->readSectors(sectorOffset, sectors.data() + (sectorOffset - chunkStart), sectorSize);
+                return bytesRead >= std::min<u64>(sectorSize, this->m_diskSize - sectorOffset);
+            };
+
+            bool readBackFailed = false;
+            if (offset > chunkStart)
+                readBackFailed = !readBack(chunkStart, this->m_sectorSize);
+            if (endOffset < chunkEnd) {
+                const u64 lastSector = chunkEnd - 1 - ((chunkEnd - 1) % this->m_sectorSize);
+                readBackFailed = readBackFailed || !readBack(lastSector, chunkEnd - lastSector);
+            }
 
-                offset += currSize;
-                size -= currSize;
+            if (readBackFailed) {
+                log::error("Failed to read the sectors around the modified data of {}", hex::toUTF8String(this->m_path));
+                break;
             }
 
+            const u64 copyStart = std::max(offset, chunkStart);
+            const u64 copyEnd   = std::min(endOffset, chunkEnd);
+            std::memcpy(sectors.data() + (copyStart - chunkStart), static_cast<const u8 *>(buffer) + (copyStart - offset), copyEnd - copyStart);
+
+            if (!this->writeSectors(chunkStart, sectors.data(), chunkEnd - chunkStart))
+                break;
+        }
+
+        #if !defined(OS_WINDOWS)
+            if (alignedEnd > this->m_diskSize && ::ftruncate(this->m_diskHandle, this->m_diskSize) != 0)
+                log::error("Failed to restore the size of {}", hex::toUTF8String(this->m_path));
         #endif
+
+        this->m_cache.invalidate(offset, size);
     }
 
     size_t DiskProvider::getActualSize() const {
@@ -338,10 +469,13 @@ namespace hex::plugin::builtin::prv {
                 this->m_path = this->m_pathBuffer;
 
         #endif
+
+        ImGui::Checkbox("hex.builtin.provider.disk.direct_io"_lang, &this->m_directIO);
     }
 
     nlohmann::json DiskProvider::storeSettings(nlohmann::json settings) const {
         settings["path"] = hex::toUTF8String(this->m_path);
+        settings["directIO"] = this->m_directIO;
 
         return Provider::storeSettings(settings);
     }
@@ -352,6 +486,9 @@ namespace hex::plugin::builtin::prv {
         auto path = settings["path"].get<std::string>();
         this->setPath(std::u8string(path.begin(), path.end()));
         this->reloadDrives();
+
+        if (settings.contains("directIO"))
+            this->m_directIO = settings["directIO"].get<bool>();
     }
 
     std::pair<Region, bool> DiskProvider::getRegionValidity(u64 address) const {
@@ -1,17 +1,81 @@
 #include "content/providers/file_provider.hpp"
 
+#include <cerrno>
 #include <cstring>
 
+#include <hex/api/event.hpp>
 #include <hex/api/imhex_api.hpp>
 #include <hex/api/localization.hpp>
 #include <hex/helpers/utils.hpp>
 #include <hex/helpers/file.hpp>
 #include <hex/helpers/fmt.hpp>
+#include <hex/helpers/literals.hpp>
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <optional>
+#include <random>
+
+#if defined(OS_LINUX)
+    #include <sys/inotify.h>
+#endif
+
 namespace hex::plugin::builtin::prv {
 
+    using namespace hex::literals;
+
+    // Mapping of the opened file. Layouts keep it alive after the provider closed or reopened the file, so it only gets unmapped once nothing reads from it anymore
+    class FileProvider::MappedFile : public hex::prv::OriginalData {
+    public:
+        #if defined(OS_WINDOWS)
+            MappedFile(void *data, size_t size) : m_data(data), m_mappedSize(size) { }
+
+            ~MappedFile() override {
+                ::UnmapViewOfFile(this->m_data);
+            }
+        #else
+            MappedFile(void *data, size_t size, int scanFile) : m_data(data), m_mappedSize(size), m_scanFile(scanFile) { }
+
+            ~MappedFile() override {
+                ::munmap(this->m_data, this->m_mappedSize);
+
+                if (this->m_scanFile != -1)
+                    ::close(this->m_scanFile);
+            }
+        #endif
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        void read(u64 offset, void *buffer, size_t size, bool sequential) const override;
+        [[nodiscard]] std::vector<Region> getDataRegions(u64 offset, size_t size) const override;
+
+        void write(u64 offset, const void *buffer, size_t size, const std::fs::path &path);
+
+        // Tries to grow the mapping in place after the file got larger. Layouts that are still being read only ever access the part that was mapped before
+        void grow(size_t newSize);
+
+        [[nodiscard]] void *getData() const { return this->m_data; }
+        [[nodiscard]] size_t getMappedSize() const { return this->m_mappedSize; }
+
+        #if !defined(OS_WINDOWS)
+            [[nodiscard]] int getScanFile() const { return this->m_scanFile; }
+        #endif
+
+    private:
+        void *m_data;
+        std::atomic<size_t> m_mappedSize;
+
+        #if !defined(OS_WINDOWS)
+            // Separate descriptor used by sequential scans so their access hints don't affect the mapping
+            int m_scanFile = -1;
+        #endif
+    };
+
     bool FileProvider::isAvailable() const {
         return this->m_mappedFile != nullptr;
     }
@@ -29,7 +93,25 @@ namespace hex::plugin::builtin::prv {
     }
 
     bool FileProvider::isSavable() const {
-        return !this->getPatches().empty();
+        auto layout = this->getLayout();
+
+        return !this->getPatches().empty() || (layout != nullptr && !layout->isIdentity());
+    }
+
+    std::shared_ptr<const hex::prv::PieceLayout> FileProvider::getLayout() const {
+        std::scoped_lock lock(this->m_layoutMutex);
+
+        return this->m_layout;
+    }
+
+    void FileProvider::setLayout(std::shared_ptr<const hex::prv::PieceLayout> layout) {
+        std::scoped_lock lock(this->m_layoutMutex);
+
+        this->m_layout = std::move(layout);
+    }
+
+    std::shared_ptr<const hex::prv::RawDataState> FileProvider::getRawDataState() const {
+        return this->getLayout();
     }
 
 
@@ -37,61 +119,474 @@ namespace hex::plugin::builtin::prv {
         if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
+        hex::prv::IOStatistics::ScopedOperation operation(this->m_ioStatistics, hex::prv::IOStatistics::Operation::Read, size);
         this->readRaw(offset - this->getBaseAddress(), buffer, size);
 
-        for (u64 i = 0; i < size; i++)
-            if (getPatches().contains(offset + i))
-                reinterpret_cast<u8 *>(buffer)[i] = getPatches()[offset + PageSize * this->m_currPage + i];
+        getPatches().apply(offset, buffer, size);
+
+        if (overlays)
+            this->applyOverlays(offset, buffer, size);
+    }
+
+    void FileProvider::readMany(std::span<const hex::prv::ReadRequest> requests, bool overlays) {
+        // Reads are served straight from the mapped file so there's nothing to gain from coalescing them
+        for (const auto &request : requests)
+            this->read(request.offset, request.buffer, request.size, overlays);
+    }
+
+    void FileProvider::readSequential(u64 offset, void *buffer, size_t size, bool overlays) {
+        if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
+            return;
+
+        hex::prv::IOStatistics::ScopedOperation operation(this->m_ioStatistics, hex::prv::IOStatistics::Operation::Read, size);
+        this->readRawSequential(offset - this->getBaseAddress(), buffer, size);
+
+        getPatches().apply(offset, buffer, size);
 
         if (overlays)
             this->applyOverlays(offset, buffer, size);
     }
 
+    void FileProvider::readRawSequential(u64 offset, void *buffer, size_t size) {
+        if (auto layout = this->getLayout(); layout != nullptr)
+            layout->read(offset, buffer, size, true);
+    }
+
     void FileProvider::write(u64 offset, const void *buffer, size_t size) {
         if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
+        hex::prv::IOStatistics::ScopedOperation operation(this->m_ioStatistics, hex::prv::IOStatistics::Operation::Write, size);
         addPatch(offset, buffer, size, true);
     }
 
     void FileProvider::readRaw(u64 offset, void *buffer, size_t size) {
-        if ((offset + size) > this->getActualSize() || buffer == nullptr || size == 0)
-            return;
-
-        std::memcpy(buffer, reinterpret_cast<u8 *>(this->m_mappedFile) + offset, size);
+        if (auto layout = this->getLayout(); layout != nullptr)
+            layout->read(offset, buffer, size, false);
     }
 
     void FileProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
-        if ((offset + size) > this->getActualSize() || buffer == nullptr || size == 0)
+        auto layout = this->getLayout();
+        if (layout == nullptr || (offset + size) > layout->getSize() || buffer == nullptr || size == 0)
+            return;
+
+        if (layout->isIdentity()) {
+            this->writeOriginal(offset, buffer, size);
             return;
+        }
+
+        auto bytes = static_cast<const u8 *>(buffer);
+
+        auto updatedLayout = layout;
+        layout->getPieces().forEachPiece(offset, size, [&](u64 pieceOffset, const auto &piece) {
+            if (piece.source == hex::prv::PieceTable::Source::Original)
+                this->writeOriginal(piece.offset, bytes + (pieceOffset - offset), piece.size);
+            else
+                updatedLayout = updatedLayout->writeAdded(piece.offset, bytes + (pieceOffset - offset), piece.size);
+        });
+
+        if (updatedLayout != layout)
+            this->setLayout(std::move(updatedLayout));
+    }
+
+    #if !defined(OS_WINDOWS)
+
+        static bool writeAll(int file, const u8 *buffer, size_t size, u64 offset) {
+            while (size > 0) {
+                auto result = ::pwrite(file, buffer, size, offset);
+                if (result <= 0)
+                    return false;
+
+                buffer += result;
+                offset += result;
+                size   -= result;
+            }
+
+            return true;
+        }
+
+        static bool copyFileData(int from, u64 fromOffset, int to, u64 toOffset, u64 size) {
+            #if defined(OS_LINUX)
+                // Let the kernel copy the data directly, which allows filesystems that support it to share the extents instead
+                loff_t inOffset = fromOffset, outOffset = toOffset;
+                while (size > 0) {
+                    auto result = ::copy_file_range(from, &inOffset, to, &outOffset, size, 0);
+                    if (result <= 0)
+                        break;
+
+                    size -= result;
+                }
+
+                if (size == 0)
+                    return true;
+
+                fromOffset = inOffset;
+                toOffset   = outOffset;
+            #endif
+
+            std::vector<u8> buffer(std::min<u64>(size, 16_MiB));
+            while (size > 0) {
+                const auto chunkSize = std::min<u64>(size, buffer.size());
+                auto result = ::pread(from, buffer.data(), chunkSize, fromOffset);
+                if (result <= 0 || !writeAll(to, buffer.data(), result, toOffset))
+                    return false;
+
+                fromOffset += result;
+                toOffset   += result;
+                size       -= result;
+            }
 
-        std::memcpy(reinterpret_cast<u8 *>(this->m_mappedFile) + offset, buffer, size);
+            return true;
+        }
+
+    #endif
+
+    // Creates a new, empty file next to the target. Its name isn't used by anything else, so writing to it can't clobber an existing file
+    static std::optional<std::fs::path> createTempFile(const std::fs::path &target) {
+        #if defined(OS_WINDOWS)
+
+            std::random_device random;
+            for (u32 attempt = 0; attempt < 16; attempt++) {
+                auto tempPath = target;
+                tempPath += hex::format(".{:08X}.tmp", random());
+
+                auto file = ::CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file != INVALID_HANDLE_VALUE) {
+                    ::CloseHandle(file);
+                    return tempPath;
+                }
+
+                if (::GetLastError() != ERROR_FILE_EXISTS)
+                    break;
+            }
+
+            return std::nullopt;
+
+        #else
+
+            auto tempPath = target.native() + ".XXXXXX";
+            auto file = ::mkstemp(tempPath.data());
+            if (file == -1)
+                return std::nullopt;
+
+            ::close(file);
+            return tempPath;
+
+        #endif
+    }
+
+    void FileProvider::MappedFile::read(u64 offset, void *buffer, size_t size, [[maybe_unused]] bool sequential) const {
+        auto bytes = static_cast<u8 *>(buffer);
+
+        #if !defined(OS_WINDOWS)
+            if (sequential && this->m_scanFile != -1) {
+                // Stream the data with pread instead of faulting in the mapping page by page. This also keeps scanned pages out of our RSS
+                size_t bytesRead = 0;
+                while (bytesRead < size) {
+                    auto result = ::pread(this->m_scanFile, bytes + bytesRead, size - bytesRead, offset + bytesRead);
+                    if (result <= 0)
+                        break;
+
+                    bytesRead += result;
+                }
+
+                #if defined(OS_LINUX)
+                    // Start reading the next chunk ahead of time and drop the consumed one from the page cache
+                    ::posix_fadvise(this->m_scanFile, offset + size, size, POSIX_FADV_WILLNEED);
+                    ::posix_fadvise(this->m_scanFile, offset, size, POSIX_FADV_DONTNEED);
+                #endif
+
+                if (bytesRead == size)
+                    return;
+
+                bytes  += bytesRead;
+                offset += bytesRead;
+                size   -= bytesRead;
+            }
+        #endif
+
+        const size_t mappedFileSize = this->m_mappedSize;
+        const auto mappedSize = offset < mappedFileSize ? std::min<u64>(size, mappedFileSize - offset) : 0;
+        std::memcpy(bytes, reinterpret_cast<u8 *>(this->m_data) + offset, mappedSize);
+
+        #if !defined(OS_WINDOWS)
+            // Data that has been appended to a followed file after it got mapped is read from the file directly
+            for (size_t bytesRead = mappedSize; bytesRead < size;) {
+                auto result = ::pread(this->m_scanFile, bytes + bytesRead, size - bytesRead, offset + bytesRead);
+                if (result <= 0)
+                    break;
+
+                bytesRead += result;
+            }
+        #endif
+    }
+
+    void FileProvider::MappedFile::write(u64 offset, const void *buffer, size_t size, [[maybe_unused]] const std::fs::path &path) {
+        auto bytes = static_cast<const u8 *>(buffer);
+
+        const size_t mappedFileSize = this->m_mappedSize;
+        const auto mappedSize = offset < mappedFileSize ? std::min<u64>(size, mappedFileSize - offset) : 0;
+        std::memcpy(reinterpret_cast<u8 *>(this->m_data) + offset, bytes, mappedSize);
+
+        #if !defined(OS_WINDOWS)
+            if (mappedSize < size) {
+                auto file = ::open(path.native().c_str(), O_WRONLY);
+                if (file == -1)
+                    return;
+
+                writeAll(file, bytes + mappedSize, size - mappedSize, offset + mappedSize);
+                ::close(file);
+            }
+        #endif
+    }
+
+    void FileProvider::MappedFile::grow([[maybe_unused]] size_t newSize) {
+        #if defined(OS_LINUX)
+            // If the address space behind the mapping is taken, the new data is read using pread instead
+            if (::mremap(this->m_data, this->m_mappedSize, newSize, 0) != MAP_FAILED)
+                this->m_mappedSize = newSize;
+        #endif
+    }
+
+    std::vector<Region> FileProvider::MappedFile::getDataRegions(u64 offset, size_t size) const {
+        #if defined(OS_WINDOWS) || !defined(SEEK_DATA)
+
+            return { Region { offset, size } };
+
+        #else
+
+            if (this->m_scanFile == -1)
+                return { Region { offset, size } };
+
+            // Ask the filesystem which parts of the file are actually allocated so holes in sparse files don't have to be read
+            std::vector<Region> regions;
+            const u64 endOffset = offset + size;
+            for (u64 position = offset; position < endOffset;) {
+                auto dataStart = ::lseek(this->m_scanFile, position, SEEK_DATA);
+                if (dataStart < 0) {
+                    // ENXIO means there's no more data until the end of the file. Anything else means the query isn't supported
+                    if (errno != ENXIO)
+                        regions.push_back({ position, endOffset - position });
+
+                    break;
+                }
+
+                if (u64(dataStart) >= endOffset)
+                    break;
+
+                auto dataEnd = ::lseek(this->m_scanFile, dataStart, SEEK_HOLE);
+                const u64 regionEnd = dataEnd < 0 ? endOffset : std::min<u64>(dataEnd, endOffset);
+
+                regions.push_back({ u64(dataStart), regionEnd - dataStart });
+                position = regionEnd;
+            }
+
+            return regions;
+
+        #endif
+    }
+
+    void FileProvider::writeOriginal(u64 offset, const void *buffer, size_t size) {
+        if (this->m_mappedFile != nullptr)
+            this->m_mappedFile->write(offset, buffer, size, this->m_path);
     }
 
     void FileProvider::save() {
-        this->applyPatches();
+        // Inserted or removed bytes shift the rest of the file, so it needs to be rewritten as a whole
+        if (auto layout = this->getLayout(); layout != nullptr && !layout->isIdentity()) {
+            this->replaceFile(this->m_path);
+            return;
+        }
+
+        #if defined(OS_WINDOWS)
+
+            this->applyPatches();
+            if (this->m_mappedFile != nullptr)
+                ::FlushViewOfFile(this->m_mappedFile->getData(), 0);
+
+        #else
+
+            auto file = ::open(this->m_path.native().c_str(), O_WRONLY);
+            if (file == -1)
+                return;
+            ON_SCOPE_EXIT { ::close(file); };
+
+            // Patches are already stored as runs of consecutive bytes so each run can be written with a single call
+            for (const auto &[address, bytes] : this->m_patches.getRuns()) {
+                if (!writeAll(file, bytes.data(), bytes.size(), address - this->getBaseAddress()))
+                    return;
+            }
+
+            ::fsync(file);
+
+            this->m_patches.clear();
+            this->m_undoJournal.clear();
+            this->markDirty();
+
+        #endif
     }
 
-    void FileProvider::saveAs(const std::fs::path &path) {
-        fs::File file(path, fs::File::Mode::Create);
+    bool FileProvider::writeToFile(const std::fs::path &path) {
+        #if defined(OS_WINDOWS)
+
+            fs::File file(path, fs::File::Mode::Create);
+            if (!file.isValid())
+                return false;
+
+            std::vector<u8> buffer(std::min<size_t>(16_MiB, this->getActualSize()), 0x00);
+            for (u64 offset = 0; offset < this->getActualSize(); offset += buffer.size()) {
+                const auto bufferSize = std::min<size_t>(buffer.size(), this->getActualSize() - offset);
+
+                this->read(offset + this->getBaseAddress(), buffer.data(), bufferSize, false);
+                file.write(buffer.data(), bufferSize);
+            }
+
+            file.flush();
+
+            return true;
+
+        #else
+
+            auto layout = this->getLayout();
+            if (this->m_mappedFile == nullptr || this->m_mappedFile->getScanFile() == -1 || layout == nullptr)
+                return false;
+
+            auto file = ::open(path.native().c_str(), O_WRONLY | O_TRUNC);
+            if (file == -1)
+                return false;
+            ON_SCOPE_EXIT { ::close(file); };
+
+            // The new file replaces the opened one, so it gets the same permissions
+            const auto mode = this->m_fileStatsValid ? (this->m_fileStats.st_mode & 0777) : 0644;
+            if (::fchmod(file, mode) != 0)
+                return false;
+
+            // Collect all ranges whose content differs from the file on disk. Overlays are never saved, same as when the patches are written in place
+            std::vector<std::pair<u64, u64>> modifiedRanges;
+            for (const auto &[address, bytes] : this->m_patches.getRuns())
+                modifiedRanges.emplace_back(address - this->getBaseAddress(), address - this->getBaseAddress() + bytes.size());
+
+            // Copy unmodified data straight from the original file and only write out the modified ranges ourselves
+            // Unmodified data is copied straight from where it's stored, either the original file or the inserted bytes
+            std::vector<u8> buffer;
+            auto copyUnmodified = [&](u64 start, u64 end) {
+                bool success = true;
+                layout->getPieces().forEachPiece(start, end - start, [&](u64 offset, const auto &piece) {
+                    if (!success)
+                        return;
+
+                    if (piece.source == hex::prv::PieceTable::Source::Original) {
+                        success = copyFileData(this->m_mappedFile->getScanFile(), piece.offset, file, offset, piece.size);
+                        return;
+                    }
+
+                    buffer.resize(std::min<u64>(piece.size, 16_MiB));
+                    for (u64 pieceOffset = 0; pieceOffset < piece.size && success; pieceOffset += buffer.size()) {
+                        const auto chunkSize = std::min<u64>(buffer.size(), piece.size - pieceOffset);
+
+                        layout->readAdded(piece.offset + pieceOffset, buffer.data(), chunkSize);
+                        success = writeAll(file, buffer.data(), chunkSize, offset + pieceOffset);
+                    }
+                });
+
+                return success;
+            };
+
+            u64 position = 0;
+            const u64 fileSize = layout->getSize();
+            for (auto [start, end] : modifiedRanges) {
+                start = std::min(std::max(start, position), fileSize);
+                end   = std::min(end, fileSize);
+                if (end <= start)
+                    continue;
+
+                if (start > position && !copyUnmodified(position, start))
+                    return false;
+
+                buffer.resize(std::min<u64>(end - start, 16_MiB));
+                for (u64 offset = start; offset < end; offset += buffer.size()) {
+                    const auto chunkSize = std::min<u64>(buffer.size(), end - offset);
 
-        if (file.isValid()) {
-            auto provider = ImHexApi::Provider::get();
+                    this->read(offset + this->getBaseAddress(), buffer.data(), chunkSize, false);
+                    if (!writeAll(file, buffer.data(), chunkSize, offset))
+                        return false;
+                }
+
+                position = end;
+            }
+
+            if (position < fileSize && !copyUnmodified(position, fileSize))
+                return false;
+
+            return ::fsync(file) == 0;
+
+        #endif
+    }
+
+    bool FileProvider::replaceFile(const std::fs::path &path) {
+        // Write everything to a temporary file first so the target is only replaced once the new data is complete
+        const auto tempPath = createTempFile(path);
+        if (!tempPath.has_value())
+            return false;
+
+        std::error_code error;
+        if (!this->writeToFile(*tempPath)) {
+            std::fs::remove(*tempPath, error);
+            return false;
+        }
+
+        // The currently opened file needs to be unmapped before it can be replaced. Keep the layout without the mapping around in case that fails
+        std::error_code equivalentError;
+        const bool replacingOpenedFile = std::fs::equivalent(path, this->m_path, equivalentError);
+
+        std::shared_ptr<const hex::prv::PieceLayout> layout;
+        if (replacingOpenedFile) {
+            if (auto currentLayout = this->getLayout(); currentLayout != nullptr)
+                layout = currentLayout->withOriginal(nullptr);
+
+            this->close();
+        }
 
-            std::vector<u8> buffer(std::min<size_t>(0xFF'FFFF, provider->getActualSize()), 0x00);
-            size_t bufferSize = buffer.size();
+        std::fs::rename(*tempPath, path, error);
+        if (error) {
+            std::error_code removeError;
+            std::fs::remove(*tempPath, removeError);
+        }
+
+        if (replacingOpenedFile) {
+            if (!this->open())
+                return false;
 
-            for (u64 offset = 0; offset < provider->getActualSize(); offset += bufferSize) {
-                if (bufferSize > provider->getActualSize() - offset)
-                    bufferSize = provider->getActualSize() - offset;
+            if (error) {
+                // Nothing got saved, the file on disk is still the one the layout and the patches were made for
+                if (layout != nullptr)
+                    this->setLayout(layout->withOriginal(this->m_mappedFile));
 
-                provider->read(offset + this->getBaseAddress(), buffer.data(), bufferSize);
-                file.write(buffer);
+                return false;
             }
+
+            this->m_patches.clear();
+            this->m_undoJournal.clear();
+            this->markDirty();
         }
+
+        return !error;
+    }
+
+    void FileProvider::saveAs(const std::fs::path &path) {
+        this->replaceFile(path);
     }
 
     void FileProvider::resize(size_t newSize) {
+        const auto oldSize = this->getActualSize();
+
+        if (newSize > oldSize)
+            this->insert(oldSize, newSize - oldSize);
+        else if (newSize < oldSize)
+            this->remove(newSize, oldSize - newSize);
+    }
+
+    void FileProvider::resizeFile(size_t newSize) {
         this->close();
 
         {
@@ -105,50 +600,29 @@ namespace hex::plugin::builtin::prv {
     }
 
     void FileProvider::insert(u64 offset, size_t size) {
-        auto oldSize = this->getActualSize();
-        this->resize(oldSize + size);
-
-        std::vector<u8> buffer(0x1000);
-        const std::vector<u8> zeroBuffer(0x1000);
-
-        auto position = oldSize;
-        while (position > offset) {
-            const auto readSize = std::min<size_t>(position - offset, buffer.size());
-
-            position -= readSize;
+        auto layout = this->getLayout();
+        if (layout == nullptr)
+            return;
 
-            this->readRaw(position, buffer.data(), readSize);
-            this->writeRaw(position, zeroBuffer.data(), readSize);
-            this->writeRaw(position + size, buffer.data(), readSize);
-        }
+        this->setLayout(layout->insert(offset, size));
 
         Provider::insert(offset, size);
     }
 
     void FileProvider::remove(u64 offset, size_t size) {
-        auto oldSize = this->getActualSize();
-        this->resize(oldSize + size);
-
-        std::vector<u8> buffer(0x1000);
-
-        const auto newSize = oldSize - size;
-        auto position = offset;
-        while (position < newSize) {
-            const auto readSize = std::min<size_t>(newSize - position, buffer.size());
-
-            this->readRaw(position + size, buffer.data(), readSize);
-            this->writeRaw(position, buffer.data(), readSize);
-
-            position += readSize;
-        }
+        auto layout = this->getLayout();
+        if (layout == nullptr)
+            return;
 
-        this->resize(newSize);
+        this->setLayout(layout->remove(offset, size));
 
-        Provider::insert(offset, size);
+        Provider::remove(offset, size);
     }
 
     size_t FileProvider::getActualSize() const {
-        return this->m_fileSize;
+        auto layout = this->getLayout();
+
+        return layout != nullptr ? layout->getSize() : 0;
     }
 
     std::string FileProvider::getName() const {
@@ -180,6 +654,104 @@ namespace hex::plugin::builtin::prv {
         this->m_path = path;
     }
 
+    bool FileProvider::isFollowingSupported() {
+        #if defined(OS_WINDOWS)
+            return false;
+        #else
+            return true;
+        #endif
+    }
+
+    void FileProvider::setFollowing(bool following) {
+        if (following == this->m_following || !isFollowingSupported())
+            return;
+
+        this->m_following = following;
+
+        if (!this->isAvailable())
+            return;
+
+        if (following)
+            this->startFollowing();
+        else
+            this->stopFollowing();
+    }
+
+    void FileProvider::startFollowing() {
+        #if !defined(OS_WINDOWS)
+
+            #if defined(OS_LINUX)
+                this->m_followWatch = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                if (this->m_followWatch != -1 && ::inotify_add_watch(this->m_followWatch, this->m_path.native().c_str(), IN_MODIFY) == -1) {
+                    ::close(this->m_followWatch);
+                    this->m_followWatch = -1;
+                }
+            #endif
+
+            EventManager::subscribe<EventFrameBegin>(this, [this] {
+                this->updateFollowedFile();
+            });
+
+            // Pick up anything that has been written while the file wasn't followed. There are no inotify events for that yet
+            this->updateFollowedFile(true);
+
+        #endif
+    }
+
+    void FileProvider::stopFollowing() {
+        #if !defined(OS_WINDOWS)
+
+            EventManager::unsubscribe<EventFrameBegin>(this);
+
+            if (this->m_followWatch != -1)
+                ::close(this->m_followWatch);
+
+            this->m_followWatch = -1;
+
+        #endif
+    }
+
+    void FileProvider::updateFollowedFile([[maybe_unused]] bool force) {
+        #if !defined(OS_WINDOWS)
+
+            auto layout = this->getLayout();
+            if (this->m_mappedFile == nullptr || this->m_mappedFile->getScanFile() == -1 || layout == nullptr)
+                return;
+
+            #if defined(OS_LINUX)
+                // Without inotify the file size is simply polled every frame
+                if (this->m_followWatch != -1 && !force) {
+                    alignas(inotify_event) std::array<u8, 4096> events = { };
+
+                    bool modified = false;
+                    while (::read(this->m_followWatch, events.data(), events.size()) > 0)
+                        modified = true;
+
+                    if (!modified)
+                        return;
+                }
+            #endif
+
+            struct stat fileStats = { };
+            if (::fstat(this->m_mappedFile->getScanFile(), &fileStats) != 0 || u64(fileStats.st_size) <= this->m_fileSize)
+                return;
+
+            const u64 oldFileSize = this->m_fileSize;
+            const u64 newFileSize = fileStats.st_size;
+
+            if (this->m_mappedFile->getMappedSize() == oldFileSize)
+                this->m_mappedFile->grow(newFileSize);
+
+            const u64 oldSize = layout->getSize();
+            this->m_fileSize = newFileSize;
+            this->setLayout(layout->appendOriginal(newFileSize - oldFileSize));
+
+            // Only the appended bytes changed, everything that has been computed for the existing data stays valid
+            EventManager::post<EventDataRangeChanged>(this, Region { this->getBaseAddress() + oldSize, newFileSize - oldFileSize });
+
+        #endif
+    }
+
     bool FileProvider::open() {
         this->m_readable = true;
         this->m_writable = true;
@@ -219,19 +791,21 @@ namespace hex::plugin::builtin::prv {
                         return false;
                 }
 
-                this->m_mappedFile = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, this->m_fileSize);
-                if (this->m_mappedFile == nullptr) {
+                auto mappedFile = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, this->m_fileSize);
+                if (mappedFile == nullptr) {
 
-                    this->m_mappedFile = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, this->m_fileSize);
-                    if (this->m_mappedFile == nullptr) {
+                    mappedFile = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, this->m_fileSize);
+                    if (mappedFile == nullptr) {
                         this->m_readable = false;
 
                         return false;
                     }
                 }
+
+                this->m_mappedFile = std::make_shared<MappedFile>(mappedFile, this->m_fileSize);
             } else if (!this->m_emptyFile) {
                 this->m_emptyFile = true;
-                this->resize(1);
+                this->resizeFile(1);
             } else {
                 return false;
             }
@@ -258,27 +832,37 @@ namespace hex::plugin::builtin::prv {
 
             this->m_fileSize = this->m_fileStats.st_size;
 
-            this->m_mappedFile = ::mmap(nullptr, this->m_fileSize, mmapprot, MAP_SHARED, file, 0);
-            if (this->m_mappedFile == MAP_FAILED)
+            auto mappedFile = ::mmap(nullptr, this->m_fileSize, mmapprot, MAP_SHARED, file, 0);
+            if (mappedFile == MAP_FAILED)
                 return false;
 
+            auto scanFile = ::open(path.c_str(), O_RDONLY);
+            #if defined(OS_LINUX)
+                if (scanFile != -1)
+                    ::posix_fadvise(scanFile, 0, 0, POSIX_FADV_SEQUENTIAL);
+            #endif
+
+            this->m_mappedFile = std::make_shared<MappedFile>(mappedFile, this->m_fileSize, scanFile);
+
         #endif
 
-        return true;
-    }
+        if (this->m_mappedFile == nullptr)
+            return false;
 
-    void FileProvider::close() {
-        #if defined(OS_WINDOWS)
+        this->setLayout(std::make_shared<hex::prv::PieceLayout>(this->m_mappedFile, this->m_fileSize));
 
-            if (this->m_mappedFile != nullptr)
-                ::UnmapViewOfFile(this->m_mappedFile);
+        if (this->m_following)
+            this->startFollowing();
 
-        #else
+        return true;
+    }
 
-            if (this->m_mappedFile != nullptr)
-                ::munmap(this->m_mappedFile, this->m_fileSize);
+    void FileProvider::close() {
+        this->stopFollowing();
 
-        #endif
+        // The file only gets unmapped once the snapshots that still read from it are gone as well
+        this->setLayout(nullptr);
+        this->m_mappedFile.reset();
     }
 
     void FileProvider::loadSettings(const nlohmann::json &settings) {
@@ -286,10 +870,14 @@ namespace hex::plugin::builtin::prv {
 
         auto path = settings["path"].get<std::string>();
         this->setPath(std::u8string(path.begin(), path.end()));
+
+        if (settings.contains("follow"))
+            this->setFollowing(settings["follow"].get<bool>());
     }
 
     nlohmann::json FileProvider::storeSettings(nlohmann::json settings) const {
         settings["path"] = hex::toUTF8String(this->m_path);
+        settings["follow"] = this->m_following;
 
         return Provider::storeSettings(settings);
     }
@@ -303,4 +891,11 @@ namespace hex::plugin::builtin::prv {
             return { Region::Invalid(), false };
     }
 
+    std::vector<Region> FileProvider::getRawDataRegions(u64 offset, size_t size) const {
+        if (auto layout = this->getLayout(); layout != nullptr)
+            return layout->getDataRegions(offset, size);
+        else
+            return Provider::getRawDataRegions(offset, size);
+    }
+
 }
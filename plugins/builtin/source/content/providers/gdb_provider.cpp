@@ -1,6 +1,10 @@
 #include "content/providers/gdb_provider.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <cstring>
+#include <deque>
 #include <thread>
 #include <chrono>
 
@@ -9,6 +13,7 @@
 
 #include <hex/helpers/fmt.hpp>
 #include <hex/helpers/crypto.hpp>
+#include <hex/helpers/utils.hpp>
 #include <hex/api/localization.hpp>
 
 #include <nlohmann/json.hpp>
@@ -16,117 +21,295 @@
 namespace hex::plugin::builtin::prv {
 
     using namespace std::chrono_literals;
+    using namespace hex::literals;
 
     namespace gdb {
 
+        using namespace hex::gdb;
+
         namespace {
 
-            u8 calculateChecksum(const std::string &data) {
-                u64 checksum = 0;
+            // Number of requests that are sent before waiting for the first reply
+            constexpr size_t PipelineDepth = 8;
+
+        }
+
+        bool Connection::connect(const std::string &address, u16 port) {
+            std::scoped_lock lock(this->m_mutex);
 
-                for (const auto &c : data)
-                    checksum += c;
+            this->m_receiveBuffer.clear();
+            this->m_socket.connect(address, port);
+            if (!this->m_socket.isConnected())
+                return false;
 
-                return checksum & 0xFF;
+            if (!this->negotiateFeatures()) {
+                this->m_socket.disconnect();
+                return false;
             }
 
-            std::string createPacket(const std::string &data) {
-                return hex::format("${}#{:02x}", data, calculateChecksum(data));
+            return true;
+        }
+
+        void Connection::disconnect() {
+            // Wake up requests that are blocked waiting for a reply first, they hold the lock until they notice the connection is gone
+            this->m_socket.shutdown();
+
+            std::scoped_lock lock(this->m_mutex);
+            this->m_socket.disconnect();
+        }
+
+        bool Connection::isConnected() const {
+            return this->m_socket.isConnected();
+        }
+
+        bool Connection::negotiateFeatures() {
+            // Acknowledgements are only needed for unreliable links and would prevent requests from being pipelined
+            this->sendPackets(createPacket("QStartNoAckMode"));
+            if (auto reply = this->receivePacket(); !reply.has_value() || *reply != "OK")
+                return false;
+            this->m_socket.writeString("+");
+
+            this->m_maxPacketSize = 400;
+            this->m_binaryRead    = BinaryRead::Unsupported;
+            this->m_binaryWrite   = false;
+
+            bool binaryUpload = false;
+            if (auto reply = this->exchange("qSupported"); reply.has_value()) {
+                for (const auto &feature : hex::splitString(*reply, ";")) {
+                    if (feature.starts_with("PacketSize=")) {
+                        if (auto packetSize = std::strtoull(feature.c_str() + 11, nullptr, 16); packetSize > 0)
+                            this->m_maxPacketSize = packetSize;
+                    } else if (feature == "binary-upload+") {
+                        binaryUpload = true;
+                    }
+                }
             }
 
-            std::optional<std::string> parsePacket(const std::string &packet) {
-                if (packet.length() < 4)
-                    return std::nullopt;
+            // gdbserver announces the x packet and prefixes its replies. Other stubs such as LLDB's debugserver support it without announcing it
+            if (binaryUpload)
+                this->m_binaryRead = BinaryRead::Prefixed;
+            else if (this->exchange("x0,0") == "OK")
+                this->m_binaryRead = BinaryRead::Raw;
+
+            this->m_binaryWrite = this->exchange("X0,0:") == "OK";
+
+            return this->m_socket.isConnected();
+        }
+
+        void Connection::sendPackets(const std::string &packets) {
+            this->m_socket.writeString(packets);
+        }
+
+        std::optional<std::string> Connection::receivePacket() {
+            while (this->m_socket.isConnected()) {
+                if (auto start = this->m_receiveBuffer.find('$'); start == std::string::npos) {
+                    // Drop acknowledgements and anything else that isn't part of a packet
+                    this->m_receiveBuffer.clear();
+                } else {
+                    this->m_receiveBuffer.erase(0, start);
 
-                if (!packet.starts_with('$'))
-                    return std::nullopt;
+                    // Binary data is escaped so the first '#' always ends the packet
+                    if (auto end = this->m_receiveBuffer.find('#'); end != std::string::npos && end + 2 < this->m_receiveBuffer.size()) {
+                        const auto payload  = std::string_view(this->m_receiveBuffer).substr(1, end - 1);
+                        const auto checksum = std::strtoul(this->m_receiveBuffer.substr(end + 1, 2).c_str(), nullptr, 16);
 
-                if (packet[packet.length() - 3] != '#')
-                    return std::nullopt;
+                        std::optional<std::string> result;
+                        if (checksum == calculateChecksum(payload))
+                            result = decodePayload(payload);
 
-                std::string data     = packet.substr(1, packet.length() - 4);
-                std::string checksum = packet.substr(packet.length() - 2, 2);
+                        this->m_receiveBuffer.erase(0, end + 3);
 
-                if (checksum.length() != 2 || crypt::decode16(checksum)[0] != calculateChecksum(data))
-                    return std::nullopt;
+                        return result;
+                    }
+                }
+
+                auto received = this->m_socket.readString(0x10000);
+                if (received.empty()) {
+                    // The descriptor itself is only closed by disconnect so it can't get reused while another thread still shuts it down
+                    this->m_socket.shutdown();
+                    break;
+                }
 
-                return data;
+                this->m_receiveBuffer += received;
             }
 
+            return std::nullopt;
         }
 
-        void sendAck(Socket &socket) {
-            socket.writeString("+");
+        std::optional<std::string> Connection::exchange(const std::string &data) {
+            this->sendPackets(createPacket(data));
+
+            return this->receivePacket();
         }
 
-        std::vector<u8> readMemory(Socket &socket, u64 address, size_t size) {
-            std::string packet = createPacket(hex::format("m{:X},{:X}", address, size));
+        size_t Connection::getMaxReadSize() const {
+            // Binary replies can be shorter than requested if escaping made them exceed the packet size, that's handled by requesting the rest
+            switch (this->m_binaryRead) {
+                case BinaryRead::Prefixed:  return std::max<size_t>(this->m_maxPacketSize - 1, 1);
+                case BinaryRead::Raw:       return this->m_maxPacketSize;
+                default:                    return std::max<size_t>(this->m_maxPacketSize / 2, 1);
+            }
+        }
 
-            socket.writeString(packet);
+        std::string Connection::createReadCommand(u64 address, size_t size) const {
+            return hex::format("{}{:X},{:X}", this->m_binaryRead == BinaryRead::Unsupported ? 'm' : 'x', address, size);
+        }
 
-            auto receivedPacket = socket.readString(size * 2 + 4);
+        std::vector<Region> Connection::readMemory(u64 address, void *buffer, size_t size) {
+            std::scoped_lock lock(this->m_mutex);
+
+            struct Request {
+                u64 address;
+                size_t size;
+            };
+
+            auto bytes = static_cast<u8 *>(buffer);
+            const auto maxReadSize = this->getMaxReadSize();
+
+            std::deque<Request> pending, inFlight;
+            for (u64 offset = 0; offset < size; offset += maxReadSize)
+                pending.push_back({ address + offset, std::min<size_t>(maxReadSize, size - offset) });
+
+            std::vector<Region> failedRegions;
+            auto fail = [&](const Request &request) {
+                std::memset(bytes + (request.address - address), 0x00, request.size);
+                failedRegions.push_back({ request.address, request.size });
+            };
+
+            // Raw binary replies that look like an error might be data as well. They're read again once no other replies are outstanding
+            std::vector<Request> ambiguous;
+
+            // Keep multiple requests outstanding so the round trip time is paid once per batch instead of once per packet
+            while ((!pending.empty() || !inFlight.empty()) && this->m_socket.isConnected()) {
+                std::string packets;
+                while (!pending.empty() && inFlight.size() < PipelineDepth) {
+                    packets += createPacket(this->createReadCommand(pending.front().address, pending.front().size));
+                    inFlight.push_back(pending.front());
+                    pending.pop_front();
+                }
 
-            if (receivedPacket.empty())
-                return {};
+                if (!packets.empty())
+                    this->sendPackets(packets);
 
-            auto receivedData = parsePacket(receivedPacket);
-            if (!receivedData.has_value())
-                return {};
+                auto request = inFlight.front();
+                inFlight.pop_front();
 
-            if (receivedData->size() == 3 && receivedData->starts_with("E"))
-                return {};
+                auto reply = this->receivePacket();
+                auto data  = reply.has_value() ? parseReadReply(this->m_binaryRead, *reply, request.size) : std::nullopt;
+                if (!data.has_value() || data->empty()) {
+                    if (this->m_binaryRead == BinaryRead::Raw && reply.has_value() && isErrorReply(*reply))
+                        ambiguous.push_back(request);
+                    else
+                        fail(request);
 
-            auto data = crypt::decode16(receivedData.value());
+                    continue;
+                }
 
-            data.resize(size);
+                std::memcpy(bytes + (request.address - address), data->data(), data->size());
+                if (data->size() < request.size)
+                    pending.push_front({ request.address + data->size(), request.size - data->size() });
+            }
 
-            return data;
-        }
+            // Everything that's left got cut off by the connection dropping
+            for (const auto &request : inFlight)
+                fail(request);
+            for (const auto &request : pending)
+                fail(request);
 
-        void writeMemory(Socket &socket, u64 address, const void *buffer, size_t size) {
-            std::vector<u8> bytes(size);
-            std::memcpy(bytes.data(), buffer, size);
+            for (const auto &request : ambiguous) {
+                if (!this->readMemoryHex(request.address, bytes + (request.address - address), request.size))
+                    fail(request);
+            }
+
+            return failedRegions;
+        }
 
-            std::string byteString = crypt::encode16(bytes);
+        bool Connection::readMemoryHex(u64 address, u8 *buffer, size_t size) {
+            const auto maxReadSize = std::max<size_t>(this->m_maxPacketSize / 2, 1);
 
-            std::string packet = createPacket(hex::format("M{:X},{:X}:{}", address, size, byteString));
+            for (u64 offset = 0; offset < size;) {
+                auto reply = this->exchange(hex::format("m{:X},{:X}", address + offset, std::min<size_t>(maxReadSize, size - offset)));
+                auto data  = reply.has_value() ? parseReadReply(BinaryRead::Unsupported, *reply, size - offset) : std::nullopt;
+                if (!data.has_value() || data->empty())
+                    return false;
 
-            socket.writeString(packet);
+                std::memcpy(buffer + offset, data->data(), data->size());
+                offset += data->size();
+            }
 
-            auto receivedPacket = socket.readString(3);
+            return true;
         }
 
-        bool enableNoAckMode(Socket &socket) {
-            socket.writeString(createPacket("QStartNoAckMode"));
+        bool Connection::writeMemory(u64 address, const void *buffer, size_t size) {
+            std::scoped_lock lock(this->m_mutex);
+
+            auto bytes = static_cast<const u8 *>(buffer);
+
+            // Split the data into packets that stay within the negotiated packet size
+            std::vector<std::string> packets;
+            for (u64 offset = 0; offset < size;) {
+                const auto headerSize = hex::format("X{:X},{:X}:", address + offset, size - offset).size();
+                const auto maxPayloadSize = this->m_maxPacketSize > headerSize ? this->m_maxPacketSize - headerSize : 1;
+
+                std::string payload;
+                size_t chunkSize = 0;
+                if (this->m_binaryWrite) {
+                    while (offset + chunkSize < size) {
+                        const auto byte = bytes[offset + chunkSize];
+                        if (payload.size() + (needsEscaping(byte) ? 2 : 1) > maxPayloadSize && chunkSize > 0)
+                            break;
+
+                        if (needsEscaping(byte)) {
+                            payload.push_back('}');
+                            payload.push_back(byte ^ 0x20);
+                        } else {
+                            payload.push_back(byte);
+                        }
+
+                        chunkSize++;
+                    }
 
-            auto ack = socket.readString(1);
+                    packets.push_back(createPacket(hex::format("X{:X},{:X}:", address + offset, chunkSize) + payload));
+                } else {
+                    chunkSize = std::min<size_t>(std::max<size_t>(maxPayloadSize / 2, 1), size - offset);
+                    payload   = crypt::encode16(std::vector<u8>(bytes + offset, bytes + offset + chunkSize));
 
-            if (ack.empty() || ack[0] != '+')
-                return false;
+                    packets.push_back(createPacket(hex::format("M{:X},{:X}:{}", address + offset, chunkSize, payload)));
+                }
 
-            auto receivedPacket = socket.readString(6);
+                offset += chunkSize;
+            }
 
-            auto receivedData = parsePacket(receivedPacket);
+            bool success = true;
+            for (size_t i = 0; i < packets.size(); i += PipelineDepth) {
+                const auto batchSize = std::min(PipelineDepth, packets.size() - i);
 
-            if (receivedData && *receivedData == "OK") {
-                sendAck(socket);
-                return true;
-            } else {
-                return false;
+                std::string batch;
+                for (size_t j = 0; j < batchSize; j++)
+                    batch += packets[i + j];
+
+                this->sendPackets(batch);
+                for (size_t j = 0; j < batchSize; j++) {
+                    if (this->receivePacket() != "OK")
+                        success = false;
+                }
             }
+
+            return success;
         }
 
     }
 
-    GDBProvider::GDBProvider() : Provider(), m_size(0xFFFF'FFFF) {
+    GDBProvider::GDBProvider() : Provider(), m_size(0xFFFF'FFFF), m_cache([this](u64 offset, void *buffer, size_t size) { return this->readMemory(offset, buffer, size); }, CacheLineSize, this->m_cacheSize * 1_KiB) {
+        this->m_cache.setStatistics(&this->getIOStatistics());
     }
 
     bool GDBProvider::isAvailable() const {
-        return this->m_socket.isConnected();
+        return this->m_connection.isConnected();
     }
 
     bool GDBProvider::isReadable() const {
-        return this->m_socket.isConnected();
+        return this->m_connection.isConnected();
     }
 
     bool GDBProvider::isWritable() const {
@@ -146,41 +329,10 @@ namespace hex::plugin::builtin::prv {
         if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
-        offset -= this->getBaseAddress();
-
-        u64 alignedOffset = offset - (offset % CacheLineSize);
-
-        if (size <= CacheLineSize) {
-            std::scoped_lock lock(this->m_cacheLock);
-
-            const auto &cacheLine = std::find_if(this->m_cache.begin(), this->m_cache.end(), [&](auto &line) {
-                return line.address == alignedOffset;
-            });
-
-            if (cacheLine != this->m_cache.end()) {
-                // Cache hit
-
-            } else {
-                // Cache miss
-
-                this->m_cache.push_back({ alignedOffset, { 0 } });
-            }
-
-            if (cacheLine != this->m_cache.end())
-                std::memcpy(buffer, &cacheLine->data[0] + (offset % CacheLineSize), size);
-        } else {
-            while (size > 0) {
-                size_t readSize = std::min(size, CacheLineSize);
-                this->readRaw(offset, buffer, readSize);
-
-                size -= readSize;
-                offset += readSize;
-            }
-        }
+        hex::prv::IOStatistics::ScopedOperation operation(this->m_ioStatistics, hex::prv::IOStatistics::Operation::Read, size);
+        this->readRaw(offset - this->getBaseAddress(), buffer, size);
 
-        for (u64 i = 0; i < size; i++)
-            if (getPatches().contains(offset + i))
-                reinterpret_cast<u8 *>(buffer)[i] = getPatches()[offset + PageSize * this->m_currPage + i];
+        getPatches().apply(offset, buffer, size);
 
         if (overlays)
             this->applyOverlays(offset, buffer, size);
@@ -190,24 +342,51 @@ namespace hex::plugin::builtin::prv {
         if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
-        offset -= this->getBaseAddress();
-
-        gdb::writeMemory(this->m_socket, offset, buffer, size);
+        hex::prv::IOStatistics::ScopedOperation operation(this->m_ioStatistics, hex::prv::IOStatistics::Operation::Write, size);
+        this->writeRaw(offset - this->getBaseAddress(), buffer, size);
     }
 
     void GDBProvider::readRaw(u64 offset, void *buffer, size_t size) {
-        if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
+        if (offset > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
-        auto data = gdb::readMemory(this->m_socket, offset, size);
-        std::memcpy(buffer, &data[0], data.size());
+        // Misses are fetched synchronously, large reads are split into maximally sized packets by the connection itself
+        this->m_cache.read(offset, buffer, size);
     }
 
     void GDBProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
-        if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
+        if (offset > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
-        gdb::writeMemory(this->m_socket, offset, buffer, size);
+        this->m_connection.writeMemory(offset, buffer, size);
+        this->m_cache.invalidate(offset, size);
+    }
+
+    std::vector<Region> GDBProvider::readMemory(u64 offset, void *buffer, size_t size) {
+        // Memory that can't be read, e.g. unmapped pages, only zeroes the packets that failed. Those ranges don't get cached either
+        return this->m_connection.readMemory(offset, buffer, size);
+    }
+
+    void GDBProvider::refreshCache() {
+        std::array<u8, CacheLineSize> data = { };
+
+        // Only the most recently used lines are kept up to date, those are the ones that are currently being looked at.
+        // The network request is done without holding any cache locks so reads from the UI never have to wait for it
+        for (const auto line : this->m_cache.getCachedBlocks(RefreshedCacheLineCount)) {
+            const u64 address = line * CacheLineSize;
+            if (address >= this->m_size)
+                continue;
+
+            const auto size       = std::min<u64>(CacheLineSize, this->m_size - address);
+            const auto generation = this->m_cache.getGeneration();
+
+            if (this->m_connection.readMemory(address, data.data(), size).empty())
+                this->m_cache.refreshBlock(line, data.data(), size, generation);
+        }
+    }
+
+    void GDBProvider::invalidateCache() {
+        this->m_cache.clear();
     }
 
     void GDBProvider::save() {
@@ -241,34 +420,16 @@ namespace hex::plugin::builtin::prv {
     }
 
     bool GDBProvider::open() {
-        this->m_socket.connect(this->m_ipAddress, this->m_port);
-        if (!gdb::enableNoAckMode(this->m_socket)) {
-            this->m_socket.disconnect();
-            return false;
-        }
-
-        if (this->m_socket.isConnected()) {
-            this->m_cacheUpdateThread = std::thread([this]() {
-                auto cacheLine = this->m_cache.begin();
-                while (this->isConnected()) {
-                    {
-                        std::scoped_lock lock(this->m_cacheLock);
+        if (this->m_connection.connect(this->m_ipAddress, this->m_port)) {
+            this->m_cache.setDataSize(this->m_size);
+            this->m_cache.setCapacity(this->m_cacheSize * 1_KiB);
+            this->m_cache.clear();
 
-                        if (cacheLine != this->m_cache.end()) {
-                            auto data = gdb::readMemory(this->m_socket, cacheLine->address, 0x1000);
-
-                            while (this->m_cache.size() > 10) {
-                                this->m_cache.pop_front();
-                                cacheLine = this->m_cache.begin();
-                            }
-
-                            std::memcpy(cacheLine->data.data(), data.data(), data.size());
-                        }
+            this->m_cacheUpdateThread = std::jthread([this](const std::stop_token &stopToken) {
+                while (!stopToken.stop_requested() && this->isConnected()) {
+                    if (this->m_autoRefresh)
+                        this->refreshCache();
 
-                        cacheLine++;
-                        if (cacheLine == this->m_cache.end())
-                            cacheLine = this->m_cache.begin();
-                    }
                     std::this_thread::sleep_for(100ms);
                 }
             });
@@ -280,15 +441,19 @@ namespace hex::plugin::builtin::prv {
     }
 
     void GDBProvider::close() {
-        this->m_socket.disconnect();
+        if (this->m_cacheUpdateThread.joinable())
+            this->m_cacheUpdateThread.request_stop();
+
+        this->m_connection.disconnect();
 
-        if (this->m_cacheUpdateThread.joinable()) {
+        if (this->m_cacheUpdateThread.joinable())
             this->m_cacheUpdateThread.join();
-        }
+
+        this->m_cache.clear();
     }
 
     bool GDBProvider::isConnected() const {
-        return this->m_socket.isConnected();
+        return this->m_connection.isConnected();
     }
 
 
@@ -300,24 +465,49 @@ namespace hex::plugin::builtin::prv {
 
         ImGui::InputHexadecimal("hex.builtin.common.size"_lang, &this->m_size, ImGuiInputTextFlags_CharsHexadecimal);
 
+        this->drawCacheSettings();
+
         if (this->m_port < 0)
             this->m_port = 0;
         else if (this->m_port > 0xFFFF)
             this->m_port = 0xFFFF;
     }
 
+    void GDBProvider::drawInterface() {
+        this->drawCacheSettings();
+
+        if (ImGui::Button("hex.builtin.provider.gdb.invalidate_cache"_lang))
+            this->invalidateCache();
+    }
+
+    void GDBProvider::drawCacheSettings() {
+        if (ImGui::SliderInt("hex.builtin.provider.gdb.cache_size"_lang, &this->m_cacheSize, MinCacheSize, MaxCacheSize, "%d KiB", ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_AlwaysClamp))
+            this->m_cache.setCapacity(this->m_cacheSize * 1_KiB);
+
+        bool autoRefresh = this->m_autoRefresh;
+        if (ImGui::Checkbox("hex.builtin.provider.gdb.auto_refresh"_lang, &autoRefresh))
+            this->m_autoRefresh = autoRefresh;
+    }
+
     void GDBProvider::loadSettings(const nlohmann::json &settings) {
         Provider::loadSettings(settings);
 
         this->m_ipAddress = settings["ip"].get<std::string>();
         this->m_port      = settings["port"].get<int>();
         this->m_size      = settings["size"].get<size_t>();
+
+        if (settings.contains("cacheSize"))
+            this->m_cacheSize = std::clamp(settings["cacheSize"].get<int>(), MinCacheSize, MaxCacheSize);
+        if (settings.contains("autoRefresh"))
+            this->m_autoRefresh = settings["autoRefresh"].get<bool>();
     }
 
     nlohmann::json GDBProvider::storeSettings(nlohmann::json settings) const {
-        settings["ip"]   = this->m_ipAddress;
-        settings["port"] = this->m_port;
-        settings["size"] = this->m_size;
+        settings["ip"]          = this->m_ipAddress;
+        settings["port"]        = this->m_port;
+        settings["size"]        = this->m_size;
+        settings["cacheSize"]   = this->m_cacheSize;
+        settings["autoRefresh"] = this->m_autoRefresh.load();
 
         return Provider::storeSettings(settings);
     }
@@ -1,6 +1,11 @@
 #include "content/providers/intel_hex_provider.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <cstring>
+#include <numeric>
+#include <optional>
 
 #include <hex/api/imhex_api.hpp>
 #include <hex/api/localization.hpp>
@@ -14,170 +19,214 @@ namespace hex::plugin::builtin::prv {
 
     namespace intel_hex {
 
-        u8 parseHexDigit(char c) {
-            if (c >= '0' && c <= '9')
-                return c - '0';
-            else if (c >= 'A' && c <= 'F')
-                return c - 'A' + 10;
-            else if (c >= 'a' && c <= 'f')
-                return c - 'a' + 10;
-            else
-                throw std::runtime_error("Failed to parse hex digit");
-        }
+        enum class RecordType : u8 {
+            Data                    = 0x00,
+            EndOfFile               = 0x01,
+            ExtendedSegmentAddress  = 0x02,
+            StartSegmentAddress     = 0x03,
+            ExtendedLinearAddress   = 0x04,
+            StartLinearAddress      = 0x05
+        };
+
+        // Data of consecutive records. The address state at the start of a chunk is only known once all previous chunks have been parsed,
+        // so runs that were parsed before the chunk set it themselves leave it empty
+        struct Run {
+            u32 address;
+            u64 dataOffset;
+            u64 size;
+            std::optional<u32> segmentAddress, linearAddress;
+        };
+
+        struct Chunk {
+            std::vector<u8> data;
+            std::vector<Run> runs;
 
-        std::map<u64, std::vector<u8>> parseIntelHex(const std::string &string) {
-            std::map<u64, std::vector<u8>> result;
+            std::optional<u32> segmentAddress, linearAddress;
+            bool hasRecords = false;
+            bool endOfFile = false;
+        };
 
-            u8 checksum = 0x00;
-            u64 offset = 0x00;
+        bool parseChunk(std::string_view text, Chunk &chunk) {
+            std::array<u8, 0x100 + 5> record = { };
 
-            u8 byteCount = 0x00;
-            u32 segmentAddress = 0x0000'0000;
-            u32 extendedLinearAddress = 0x0000'0000;
-            u16 address = 0x0000;
-            std::vector<u8> data;
-
-            enum class RecordType {
-                Data                    = 0x00,
-                EndOfFile               = 0x01,
-                ExtendedSegmentAddress  = 0x02,
-                StartSegmentAddress     = 0x03,
-                ExtendedLinearAddress   = 0x04,
-                StartLinearAddress      = 0x05
-            } recordType;
-
-            auto c = [&]() {
-                while (std::isspace(string[offset]) && offset < string.length())
+            size_t offset = 0;
+            while (true) {
+                while (offset < text.size() && std::isspace(static_cast<u8>(text[offset])))
                     offset++;
 
-                if (offset >= string.length())
-                    throw std::runtime_error("Unexpected end of file");
+                if (offset >= text.size())
+                    break;
 
-                return string[offset++];
-            };
+                // Parse start code
+                if (text[offset] != ':' || chunk.endOfFile)
+                    return false;
+                offset++;
 
-            auto parseValue = [&](u8 byteCount) {
-                u64 value = 0x00;
-                for (u8 i = 0; i < byteCount; i++) {
-                    u8 byte = (parseHexDigit(c()) << 4) | parseHexDigit(c());
-                    value <<= 8;
-                    value |= byte;
+                // Parse byte count, address, record type, data and checksum
+                if (!IntelHexProvider::decodeHex(text.substr(offset), record.data(), 1))
+                    return false;
 
-                    checksum += byte;
-                }
+                const u8 byteCount = record[0];
+                const size_t recordSize = byteCount + 5;
+                if (!IntelHexProvider::decodeHex(text.substr(offset), record.data(), recordSize))
+                    return false;
+                offset += recordSize * 2;
 
+                u8 checksum = 0x00;
+                for (size_t i = 0; i < recordSize; i++)
+                    checksum += record[i];
 
-                return value;
-            };
+                if (byteCount > 0 && checksum != 0x00)
+                    return false;
 
-            bool endOfFile = false;
-            try {
-                while (offset < string.length()) {
-                    // Parse start code
-                    if (c() != ':')
-                        return { };
+                chunk.hasRecords = true;
 
-                    checksum = 0x00;
+                const u16 address = (record[1] << 8) | record[2];
+                const u8 *data = record.data() + 4;
 
-                    if (endOfFile)
-                        throw std::runtime_error("Unexpected end of file");
+                // Construct region
+                switch (static_cast<RecordType>(record[3])) {
+                    case RecordType::Data: {
+                        if (byteCount == 0)
+                            break;
 
-                    // Parse byte count
-                    byteCount = parseValue(1);
+                        auto &runs = chunk.runs;
+                        if (runs.empty() || runs.back().address + runs.back().size != address || runs.back().segmentAddress != chunk.segmentAddress || runs.back().linearAddress != chunk.linearAddress)
+                            runs.push_back({ address, chunk.data.size(), 0, chunk.segmentAddress, chunk.linearAddress });
 
-                    // Parse address
-                    address = parseValue(2);
+                        runs.back().size += byteCount;
+                        chunk.data.insert(chunk.data.end(), data, data + byteCount);
+                        break;
+                    }
+                    case RecordType::EndOfFile: {
+                        chunk.endOfFile = true;
+                        break;
+                    }
+                    case RecordType::ExtendedSegmentAddress: {
+                        if (byteCount != 2)
+                            return false;
 
-                    // Parse record type
-                    recordType = static_cast<RecordType>(parseValue(1));
+                        chunk.segmentAddress = (data[0] << 8 | data[1]) * 16;
+                        break;
+                    }
+                    case RecordType::ExtendedLinearAddress: {
+                        if (byteCount != 2)
+                            return false;
 
-                    data.clear();
-                    for (u32 i = 0; i < byteCount; i++) {
-                        data.push_back(parseValue(1));
+                        chunk.linearAddress = (data[0] << 8 | data[1]) << 16;
+                        break;
                     }
+                    case RecordType::StartSegmentAddress:
+                    case RecordType::StartLinearAddress: {
+                        if (byteCount != 4)
+                            return false;
 
-                    parseValue(1);
-                    if (!data.empty() && checksum != 0x00)
-                        throw std::runtime_error("Checksum mismatch");
+                        // Can be safely ignored
+                        break;
+                    }
+                }
+            }
 
-                    while (std::isspace(string[offset]) && offset < string.length())
-                        offset++;
+            return true;
+        }
 
-                    // Construct region
-                    switch (recordType) {
-                        case RecordType::Data: {
-                            result[extendedLinearAddress | (segmentAddress + address)] = data;
-                            break;
-                        }
-                        case RecordType::EndOfFile: {
-                            endOfFile = true;
-                            break;
-                        }
-                        case RecordType::ExtendedSegmentAddress: {
-                            if (byteCount != 2)
-                                throw std::runtime_error("Unexpected byte count");
+    }
 
-                            segmentAddress = (data[0] << 8 | data[1]) * 16;
-                            break;
-                        }
-                        case RecordType::StartSegmentAddress: {
-                            if (byteCount != 4)
-                                throw std::runtime_error("Unexpected byte count");
+    bool IntelHexProvider::decodeHex(std::string_view text, u8 *buffer, size_t size) {
+        constexpr static auto DigitTable = [] {
+            std::array<u8, 0x100> table = { };
+            table.fill(0xFF);
 
-                            // Can be safely ignored
-                            break;
-                        }
-                        case RecordType::ExtendedLinearAddress: {
-                            if (byteCount != 2)
-                                throw std::runtime_error("Unexpected byte count");
+            for (u8 i = 0; i < 10; i++)
+                table['0' + i] = i;
+            for (u8 i = 0; i < 6; i++) {
+                table['A' + i] = 10 + i;
+                table['a' + i] = 10 + i;
+            }
 
-                            extendedLinearAddress = (data[0] << 8 | data[1]) << 16;
-                            break;
-                        }
-                        case RecordType::StartLinearAddress: {
-                            if (byteCount != 4)
-                                throw std::runtime_error("Unexpected byte count");
+            return table;
+        }();
 
-                            // Can be safely ignored
-                            break;
-                        }
-                    }
-                }
+        if (text.size() < size * 2)
+            return false;
 
-            } catch (const std::runtime_error &e) {
-                return { };
-            }
+        for (size_t i = 0; i < size; i++) {
+            const u8 high = DigitTable[static_cast<u8>(text[i * 2 + 0])];
+            const u8 low  = DigitTable[static_cast<u8>(text[i * 2 + 1])];
+            if ((high | low) == 0xFF)
+                return false;
 
-            return result;
+            buffer[i] = (high << 4) | low;
         }
 
+        return true;
     }
 
-    void IntelHexProvider::setBaseAddress(u64 address) {
-        auto oldBase = this->getBaseAddress();
+    void IntelHexProvider::setRecords(std::vector<DataRun> runs) {
+        this->m_extents.clear();
+        this->m_arena.clear();
+
+        std::vector<size_t> order(runs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return runs[a].address < runs[b].address; });
+
+        // Touching and overlapping runs are merged into a single extent
+        u64 arenaSize = 0;
+        for (const auto index : order) {
+            const auto &run = runs[index];
+            if (run.size == 0)
+                continue;
+
+            if (this->m_extents.empty() || run.address > this->m_extents.back().address + this->m_extents.back().size) {
+                this->m_extents.push_back({ run.address, arenaSize, run.size });
+                arenaSize += run.size;
+            } else {
+                auto &extent = this->m_extents.back();
+                const u64 endAddress = std::max(extent.address + extent.size, run.address + run.size);
+
+                arenaSize += endAddress - (extent.address + extent.size);
+                extent.size = endAddress - extent.address;
+            }
+        }
 
-        auto intervals = this->m_data.findOverlapping(oldBase, oldBase + this->getActualSize());
+        // Copy the data in file order so later records overwrite earlier ones
+        this->m_arena.resize(arenaSize);
+        for (const auto &run : runs) {
+            if (run.size == 0)
+                continue;
 
-        for (auto &interval : intervals) {
-            interval.start = (interval.start - oldBase) + address;
-            interval.stop  = (interval.stop  - oldBase) + address;
+            auto extent = this->findExtent(run.address);
+            std::memcpy(this->m_arena.data() + extent->arenaOffset + (run.address - extent->address), run.data, run.size);
         }
 
-        this->m_data = std::move(intervals);
+        this->m_dataSize = this->m_extents.empty() ? 0 : this->m_extents.back().address + this->m_extents.back().size;
+    }
 
-        Provider::setBaseAddress(address);
+    std::vector<IntelHexProvider::Extent>::const_iterator IntelHexProvider::findExtent(u64 offset) const {
+        // First extent that ends after the given offset
+        return std::upper_bound(this->m_extents.begin(), this->m_extents.end(), offset, [](u64 value, const Extent &extent) {
+            return value < extent.address + extent.size;
+        });
     }
 
     void IntelHexProvider::readRaw(u64 offset, void *buffer, size_t size) {
-        auto intervals = this->m_data.findOverlapping(offset, (offset + size) - 1);
-
-        std::memset(buffer, 0x00, size);
-        auto bytes = reinterpret_cast<u8*>(buffer);
-        for (const auto &interval : intervals) {
-            for (u32 i = std::max(interval.start, offset); i <= interval.stop && (i - offset) < size; i++) {
-                bytes[i - offset] =  interval.value[i - interval.start];
+        auto bytes = static_cast<u8*>(buffer);
+        const u64 endOffset = offset + size;
+
+        u64 current = offset;
+        for (auto extent = this->findExtent(offset); extent != this->m_extents.end() && extent->address < endOffset; ++extent) {
+            if (extent->address > current) {
+                std::memset(bytes + (current - offset), 0x00, extent->address - current);
+                current = extent->address;
             }
+
+            const u64 copyEnd = std::min(endOffset, extent->address + extent->size);
+            std::memcpy(bytes + (current - offset), this->m_arena.data() + extent->arenaOffset + (current - extent->address), copyEnd - current);
+            current = copyEnd;
         }
+
+        if (current < endOffset)
+            std::memset(bytes + (current - offset), 0x00, endOffset - current);
     }
 
     void IntelHexProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
@@ -189,32 +238,53 @@ namespace hex::plugin::builtin::prv {
     }
 
     bool IntelHexProvider::open() {
-        auto file = fs::File(this->m_sourceFilePath, fs::File::Mode::Read);
-        if (!file.isValid())
-            return false;
+        std::vector<std::vector<u8>> buffers;
+        std::vector<DataRun> runs;
 
-        auto data = intel_hex::parseIntelHex(file.readString());
-        if (data.empty())
-            return false;
+        u32 segmentAddress = 0x0000'0000, extendedLinearAddress = 0x0000'0000;
+        bool endOfFile = false;
 
-        u64 maxAddress = 0x00;
-        decltype(this->m_data)::interval_vector intervals;
-        for (auto &[address, bytes] : data) {
-            auto endAddress = (address + bytes.size()) - 1;
-            intervals.emplace_back(address, endAddress, std::move(bytes));
+        auto parsed = parseChunked<intel_hex::Chunk>(this->m_sourceFilePath, ':', intel_hex::parseChunk, [&](intel_hex::Chunk &chunk) {
+            if (endOfFile && chunk.hasRecords)
+                return false;
 
-            if (endAddress > maxAddress)
-                maxAddress = endAddress;
-        }
-        this->m_data = std::move(intervals);
-        this->m_dataSize = maxAddress + 1;
+            for (const auto &run : chunk.runs) {
+                const u32 linearAddress = run.linearAddress.value_or(extendedLinearAddress);
+                const u64 address = u64(run.segmentAddress.value_or(segmentAddress)) + run.address;
+
+                // The linear address is ORed with the segment offset, so runs have to be split where that offset carries into the upper bits
+                for (u64 runOffset = 0; runOffset < run.size;) {
+                    const u64 currAddress = address + runOffset;
+                    const u64 size = std::min<u64>(run.size - runOffset, 0x1'0000 - (currAddress & 0xFFFF));
+
+                    runs.push_back({ linearAddress | currAddress, chunk.data.data() + run.dataOffset + runOffset, size });
+                    runOffset += size;
+                }
+            }
+
+            segmentAddress        = chunk.segmentAddress.value_or(segmentAddress);
+            extendedLinearAddress = chunk.linearAddress.value_or(extendedLinearAddress);
+            endOfFile             = endOfFile || chunk.endOfFile;
+
+            buffers.push_back(std::move(chunk.data));
+
+            return true;
+        });
+
+        if (!parsed || runs.empty())
+            return false;
+
+        this->setRecords(std::move(runs));
         this->m_dataValid = true;
 
         return true;
     }
 
     void IntelHexProvider::close() {
-
+        this->m_extents.clear();
+        this->m_extents.shrink_to_fit();
+        this->m_arena.clear();
+        this->m_arena.shrink_to_fit();
     }
 
     [[nodiscard]] std::string IntelHexProvider::getName() const {
@@ -234,17 +304,25 @@ namespace hex::plugin::builtin::prv {
     }
 
     std::pair<Region, bool> IntelHexProvider::getRegionValidity(u64 address) const {
-        auto intervals = this->m_data.findOverlapping(address, address);
-        if (intervals.empty()) {
+        const u64 offset = address - this->getBaseAddress();
+
+        auto extent = this->findExtent(offset);
+        if (extent == this->m_extents.end() || extent->address > offset)
             return Provider::getRegionValidity(address);
-        }
 
-        auto closestInterval = intervals.front();
-        for (const auto &interval : intervals) {
-            if (interval.start < closestInterval.start)
-                closestInterval = interval;
+        return { Region { this->getBaseAddress() + extent->address, extent->size }, true };
+    }
+
+    std::vector<Region> IntelHexProvider::getRawDataRegions(u64 offset, size_t size) const {
+        // Everything that isn't covered by a record reads as zeros
+        std::vector<Region> regions;
+        const u64 endOffset = offset + size;
+        for (auto extent = this->findExtent(offset); extent != this->m_extents.end() && extent->address < endOffset; ++extent) {
+            const u64 start = std::max(offset, extent->address);
+            regions.push_back({ start, std::min(endOffset, extent->address + extent->size) - start });
         }
-        return { Region { closestInterval.start, (closestInterval.stop - closestInterval.start) + 1}, true };
+
+        return regions;
     }
 
     void IntelHexProvider::loadSettings(const nlohmann::json &settings) {
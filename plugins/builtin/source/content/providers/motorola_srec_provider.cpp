@@ -1,5 +1,7 @@
 #include "content/providers/motorola_srec_provider.hpp"
 
+#include <array>
+#include <cctype>
 
 #include <hex/api/localization.hpp>
 #include <hex/helpers/utils.hpp>
@@ -10,187 +12,170 @@ namespace hex::plugin::builtin::prv {
 
     namespace motorola_srec {
 
-        u8 parseHexDigit(char c) {
-            if (c >= '0' && c <= '9')
-                return c - '0';
-            else if (c >= 'A' && c <= 'F')
-                return c - 'A' + 10;
-            else if (c >= 'a' && c <= 'f')
-                return c - 'a' + 10;
-            else
-                throw std::runtime_error("Failed to parse hex digit");
-        }
-
-        std::map<u64, std::vector<u8>> parseMotorolaSREC(const std::string &string) {
-            std::map<u64, std::vector<u8>> result;
-
-            u64 offset = 0x00;
-            u8 checksum = 0x00;
-            u8 byteCount = 0x00;
-            u32 address = 0x0000'0000;
+        enum class RecordType : u8 {
+            Header          = 0x00,
+            Data16          = 0x01,
+            Data24          = 0x02,
+            Data32          = 0x03,
+            Reserved        = 0x04,
+            Count16         = 0x05,
+            Count24         = 0x06,
+            StartAddress32  = 0x07,
+            StartAddress24  = 0x08,
+            StartAddress16  = 0x09,
+        };
+
+        // Data of consecutive records
+        struct Run {
+            u64 address;
+            u64 dataOffset;
+            u64 size;
+        };
+
+        struct Chunk {
             std::vector<u8> data;
+            std::vector<Run> runs;
 
-            auto c = [&]() {
-                while (std::isspace(string[offset]) && offset < string.length())
-                    offset++;
-
-                if (offset >= string.length())
-                    throw std::runtime_error("Unexpected end of file");
+            bool hasRecords = false;
+            bool endOfFile = false;
+        };
 
-                return string[offset++];
-            };
+        bool parseChunk(std::string_view text, Chunk &chunk) {
+            std::array<u8, 0x100> record = { };
 
-            auto parseValue = [&](u8 byteCount) {
-                u64 value = 0x00;
-                for (u8 i = 0; i < byteCount; i++) {
-                    u8 byte = (parseHexDigit(c()) << 4) | parseHexDigit(c());
-                    value <<= 8;
-                    value |= byte;
+            size_t offset = 0;
+            while (true) {
+                while (offset < text.size() && std::isspace(static_cast<u8>(text[offset])))
+                    offset++;
 
-                    checksum += byte;
+                if (offset >= text.size())
+                    break;
+
+                // Parse record start and type
+                if (offset + 2 > text.size() || text[offset] != 'S' || chunk.endOfFile)
+                    return false;
+
+                const char typeCharacter = text[offset + 1];
+                if (typeCharacter < '0' || typeCharacter > '9')
+                    return false;
+
+                const auto recordType = static_cast<RecordType>(typeCharacter - '0');
+                offset += 2;
+
+                // Parse byte count, address, data and checksum
+                if (!IntelHexProvider::decodeHex(text.substr(offset), record.data(), 1))
+                    return false;
+
+                const size_t recordSize = record[0] + 1;
+                if (!IntelHexProvider::decodeHex(text.substr(offset), record.data(), recordSize))
+                    return false;
+                offset += recordSize * 2;
+
+                u8 checksum = 0x00;
+                for (size_t i = 0; i < recordSize; i++)
+                    checksum += record[i];
+
+                if (checksum != 0xFF)
+                    return false;
+
+                size_t addressSize = 0;
+                switch (recordType) {
+                    case RecordType::Reserved:
+                        break;
+                    case RecordType::Header:
+                    case RecordType::Data16:
+                    case RecordType::Count16:
+                    case RecordType::StartAddress16:
+                        addressSize = 2;
+                        break;
+                    case RecordType::Data24:
+                    case RecordType::Count24:
+                    case RecordType::StartAddress24:
+                        addressSize = 3;
+                        break;
+                    case RecordType::Data32:
+                    case RecordType::StartAddress32:
+                        addressSize = 4;
+                        break;
                 }
 
-                return value;
-            };
-
-            enum class RecordType {
-                Header          = 0x00,
-                Data16          = 0x01,
-                Data24          = 0x02,
-                Data32          = 0x03,
-                Reserved        = 0x04,
-                Count16         = 0x05,
-                Count24         = 0x06,
-                StartAddress32  = 0x07,
-                StartAddress24  = 0x08,
-                StartAddress16  = 0x09,
-            } recordType;
+                // Byte count includes the address and the checksum
+                if (recordSize < addressSize + 2)
+                    return false;
 
-            bool endOfFile = false;
-            try {
-                while (offset < string.length()) {
-                    // Parse record start
-                    if (c() != 'S')
-                        return { };
-
-                    if (endOfFile)
-                        throw std::runtime_error("Unexpected end of file");
-
-                    // Parse record type
-                    {
-                        char typeCharacter = c();
-                        if (typeCharacter < '0' || typeCharacter > '9')
-                            throw std::runtime_error("Invalid record type");
-                        recordType = static_cast<RecordType>(typeCharacter - '0');
-                    }
+                u64 address = 0x00;
+                for (size_t i = 0; i < addressSize; i++)
+                    address = (address << 8) | record[1 + i];
 
-                    checksum = 0x00;
+                const u8 *data = record.data() + 1 + addressSize;
+                const size_t dataSize = recordSize - addressSize - 2;
 
-                    // Parse byte count
-                    byteCount = parseValue(1);
+                chunk.hasRecords = true;
 
-                    // Parse address
-                    switch (recordType) {
-                        case RecordType::Reserved:
-                            break;
-                        case RecordType::Header:
-                        case RecordType::Data16:
-                        case RecordType::Count16:
-                        case RecordType::StartAddress16:
-                            byteCount -= 2;
-                            address = parseValue(2);
-                            break;
-                        case RecordType::Data24:
-                        case RecordType::Count24:
-                        case RecordType::StartAddress24:
-                            byteCount -= 3;
-                            address = parseValue(3);
-                            break;
-                        case RecordType::Data32:
-                        case RecordType::StartAddress32:
-                            byteCount -= 4;
-                            address = parseValue(4);
+                // Construct region
+                switch (recordType) {
+                    case RecordType::Data16:
+                    case RecordType::Data24:
+                    case RecordType::Data32: {
+                        if (dataSize == 0)
                             break;
-                    }
-
-                    byteCount -= 1;
-
-                    auto readData = [&byteCount, &parseValue]() {
-                        std::vector<u8> bytes;
-                        bytes.resize(byteCount);
-                        for (u8 i = 0; i < byteCount; i++) {
-                            bytes[i] = parseValue(1);
-                        }
-
-                        return bytes;
-                    };
 
-                    // Parse data
-                    data = readData();
+                        auto &runs = chunk.runs;
+                        if (runs.empty() || runs.back().address + runs.back().size != address)
+                            runs.push_back({ address, chunk.data.size(), 0 });
 
-                    // Parse checksum
-                    {
-                        auto value = parseValue(1);
-                        if (((checksum - value) ^ 0xFF) != value)
-                            throw std::runtime_error("Invalid checksum");
-                    }
-
-                    // Construct region
-                    switch (recordType) {
-                        case RecordType::Data16:
-                        case RecordType::Data24:
-                        case RecordType::Data32:
-                            result[address] = data;
-                            break;
-                        case RecordType::Header:
-                        case RecordType::Reserved:
-                            break;
-                        case RecordType::Count16:
-                        case RecordType::Count24:
-                            break;
-                        case RecordType::StartAddress32:
-                        case RecordType::StartAddress24:
-                        case RecordType::StartAddress16:
-                            endOfFile = true;
-                            break;
+                        runs.back().size += dataSize;
+                        chunk.data.insert(chunk.data.end(), data, data + dataSize);
+                        break;
                     }
+                    case RecordType::Header:
+                    case RecordType::Reserved:
+                        break;
+                    case RecordType::Count16:
+                    case RecordType::Count24:
+                        break;
+                    case RecordType::StartAddress32:
+                    case RecordType::StartAddress24:
+                    case RecordType::StartAddress16:
+                        chunk.endOfFile = true;
+                        break;
                 }
-            } catch (const std::runtime_error &e) {
-                return { };
             }
 
-            return result;
+            return true;
         }
 
     }
 
     bool MotorolaSRECProvider::open() {
-        auto file = fs::File(this->m_sourceFilePath, fs::File::Mode::Read);
-        if (!file.isValid())
-            return false;
+        std::vector<std::vector<u8>> buffers;
+        std::vector<DataRun> runs;
+        bool endOfFile = false;
 
-        auto data = motorola_srec::parseMotorolaSREC(file.readString());
-        if (data.empty())
-            return false;
+        auto parsed = parseChunked<motorola_srec::Chunk>(this->m_sourceFilePath, 'S', motorola_srec::parseChunk, [&](motorola_srec::Chunk &chunk) {
+            if (endOfFile && chunk.hasRecords)
+                return false;
 
-        u64 maxAddress = 0x00;
-        decltype(this->m_data)::interval_vector intervals;
-        for (auto &[address, bytes] : data) {
-            auto endAddress = (address + bytes.size()) - 1;
-            intervals.emplace_back(address, endAddress, std::move(bytes));
+            for (const auto &run : chunk.runs)
+                runs.push_back({ run.address, chunk.data.data() + run.dataOffset, run.size });
 
-            if (endAddress > maxAddress)
-                maxAddress = endAddress;
-        }
-        this->m_data = std::move(intervals);
-        this->m_dataSize = maxAddress + 1;
+            endOfFile = endOfFile || chunk.endOfFile;
+            buffers.push_back(std::move(chunk.data));
+
+            return true;
+        });
+
+        if (!parsed || runs.empty())
+            return false;
+
+        this->setRecords(std::move(runs));
         this->m_dataValid = true;
 
         return true;
     }
 
     void MotorolaSRECProvider::close() {
-
+        IntelHexProvider::close();
     }
 
     [[nodiscard]] std::string MotorolaSRECProvider::getName() const {
@@ -0,0 +1,327 @@
+#include "content/providers/process_memory_provider.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <sstream>
+
+#include <hex/api/localization.hpp>
+#include <hex/helpers/fmt.hpp>
+#include <hex/helpers/fs.hpp>
+#include <hex/helpers/logger.hpp>
+#include <hex/helpers/process_memory.hpp>
+#include <hex/helpers/utils.hpp>
+
+#include <imgui.h>
+#include <hex/ui/imgui_imhex_extensions.h>
+
+#include <nlohmann/json.hpp>
+
+namespace hex::plugin::builtin::prv {
+
+    namespace {
+
+        std::string readProcessName(u32 processId) {
+            std::ifstream file(hex::format("/proc/{}/comm", processId));
+
+            std::string name;
+            std::getline(file, name);
+
+            return name;
+        }
+
+    }
+
+    void ProcessMemoryProvider::read(u64 offset, void *buffer, size_t size, bool overlays) {
+        this->readMany(std::array { hex::prv::ReadRequest { offset, buffer, size } }, overlays);
+    }
+
+    void ProcessMemoryProvider::readMany(std::span<const hex::prv::ReadRequest> requests, bool overlays) {
+        size_t totalSize = 0;
+        for (const auto &request : requests)
+            totalSize += request.size;
+
+        hex::prv::IOStatistics::ScopedOperation operation(this->m_ioStatistics, hex::prv::IOStatistics::Operation::Read, totalSize);
+
+        // Collect the mapped parts of all requests first so they can be read with as few system calls as possible
+        {
+            std::shared_lock lock(this->m_mappingMutex);
+
+            std::vector<hex::process::Transfer> transfers;
+            for (const auto &request : requests) {
+                if (request.buffer == nullptr || request.size == 0 || (request.offset - this->getBaseAddress()) > (this->getActualSize() - request.size))
+                    continue;
+
+                std::memset(request.buffer, 0x00, request.size);
+                this->addTransfers(request.offset - this->getBaseAddress(), request.buffer, request.size, transfers);
+            }
+
+            hex::process::readMemory(this->m_processId, transfers);
+        }
+
+        for (const auto &request : requests) {
+            if (request.buffer == nullptr || request.size == 0 || (request.offset - this->getBaseAddress()) > (this->getActualSize() - request.size))
+                continue;
+
+            getPatches().apply(request.offset, request.buffer, request.size);
+
+            if (overlays)
+                this->applyOverlays(request.offset, request.buffer, request.size);
+        }
+    }
+
+    void ProcessMemoryProvider::readRaw(u64 offset, void *buffer, size_t size) {
+        if (offset > (this->getActualSize() - size) || buffer == nullptr || size == 0)
+            return;
+
+        std::shared_lock lock(this->m_mappingMutex);
+
+        std::vector<hex::process::Transfer> transfers;
+        std::memset(buffer, 0x00, size);
+        this->addTransfers(offset, buffer, size, transfers);
+        hex::process::readMemory(this->m_processId, transfers);
+    }
+
+    void ProcessMemoryProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
+        hex::unused(offset, buffer, size);
+    }
+
+    size_t ProcessMemoryProvider::getActualSize() const {
+        return this->m_addressSpaceSize;
+    }
+
+    std::vector<ProcessMemoryProvider::Mapping>::const_iterator ProcessMemoryProvider::findMapping(u64 address) const {
+        // First mapping that ends after the given address
+        return std::upper_bound(this->m_mappings.begin(), this->m_mappings.end(), address, [](u64 value, const Mapping &mapping) {
+            return value < mapping.address + mapping.size;
+        });
+    }
+
+    void ProcessMemoryProvider::addTransfers(u64 offset, void *buffer, size_t size, std::vector<hex::process::Transfer> &transfers) const {
+        auto bytes = static_cast<u8 *>(buffer);
+        const u64 endOffset = offset + size;
+
+        for (auto mapping = this->findMapping(offset); mapping != this->m_mappings.end() && mapping->address < endOffset; ++mapping) {
+            const u64 start = std::max(offset, mapping->address);
+            const u64 end   = std::min(endOffset, mapping->address + mapping->size);
+
+            if (this->m_snapshotMode)
+                std::memcpy(bytes + (start - offset), this->m_snapshot.data() + mapping->arenaOffset + (start - mapping->address), end - start);
+            else
+                transfers.push_back({ start, bytes + (start - offset), end - start });
+        }
+    }
+
+    std::optional<std::vector<ProcessMemoryProvider::Mapping>> ProcessMemoryProvider::readMappings() const {
+        std::ifstream file(hex::format("/proc/{}/maps", this->m_processId));
+        if (!file.is_open())
+            return std::nullopt;
+
+        std::vector<Mapping> mappings;
+
+        // Each line has the format "start-end permissions offset device inode [name]"
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream stream(line);
+
+            std::string range, permissions, offset, device, inode, name;
+            stream >> range >> permissions >> offset >> device >> inode;
+            std::getline(stream >> std::ws, name);
+
+            auto separator = range.find('-');
+            if (separator == std::string::npos || permissions.empty() || permissions[0] != 'r')
+                continue;
+
+            u64 start = 0, end = 0;
+            if (std::from_chars(range.data(), range.data() + separator, start, 16).ec != std::errc() || std::from_chars(range.data() + separator + 1, range.data() + range.size(), end, 16).ec != std::errc())
+                continue;
+
+            // The vsyscall page lives at the very top of the address space and can't be read by other processes
+            if (end <= start || name == "[vsyscall]")
+                continue;
+
+            mappings.push_back({ start, end - start, std::move(name), 0 });
+        }
+
+        if (mappings.empty())
+            return std::nullopt;
+
+        std::sort(mappings.begin(), mappings.end(), [](const auto &a, const auto &b) { return a.address < b.address; });
+
+        return mappings;
+    }
+
+    bool ProcessMemoryProvider::reload() {
+        auto mappings = this->readMappings();
+        if (!mappings.has_value())
+            return false;
+
+        std::vector<u8> snapshot;
+        if (this->m_snapshotMode) {
+            // Copy all readable memory at once so it can be analyzed without the process changing it in the meantime
+            u64 snapshotSize = 0;
+            for (auto &mapping : *mappings) {
+                mapping.arenaOffset = snapshotSize;
+                snapshotSize += mapping.size;
+            }
+
+            try {
+                snapshot.resize(snapshotSize);
+            } catch (const std::bad_alloc &) {
+                log::error("Not enough memory to create a {} snapshot of process {}", hex::toByteString(snapshotSize), this->m_processId);
+                return false;
+            }
+
+            std::vector<hex::process::Transfer> transfers;
+            for (const auto &mapping : *mappings)
+                transfers.push_back({ mapping.address, snapshot.data() + mapping.arenaOffset, mapping.size });
+
+            hex::process::readMemory(this->m_processId, transfers);
+        }
+
+        std::unique_lock lock(this->m_mappingMutex);
+        this->m_mappings = std::move(*mappings);
+        this->m_snapshot = std::move(snapshot);
+        this->m_addressSpaceSize = this->m_mappings.back().address + this->m_mappings.back().size;
+
+        return true;
+    }
+
+    bool ProcessMemoryProvider::open() {
+        #if defined(OS_LINUX)
+
+            if (this->m_processId == 0)
+                return false;
+
+            this->m_processName = readProcessName(this->m_processId);
+            this->m_available = this->reload();
+
+            return this->m_available;
+
+        #else
+
+            return false;
+
+        #endif
+    }
+
+    void ProcessMemoryProvider::close() {
+        std::unique_lock lock(this->m_mappingMutex);
+
+        this->m_mappings.clear();
+        this->m_snapshot.clear();
+        this->m_snapshot.shrink_to_fit();
+        this->m_addressSpaceSize = 0;
+        this->m_available = false;
+    }
+
+    std::string ProcessMemoryProvider::getName() const {
+        return hex::format("hex.builtin.provider.process_memory.name"_lang, this->m_processName, this->m_processId);
+    }
+
+    std::vector<std::pair<std::string, std::string>> ProcessMemoryProvider::getDataInformation() const {
+        std::shared_lock lock(this->m_mappingMutex);
+
+        u64 mappedSize = 0;
+        for (const auto &mapping : this->m_mappings)
+            mappedSize += mapping.size;
+
+        return {
+            { "hex.builtin.provider.process_memory.pid"_lang,         std::to_string(this->m_processId) },
+            { "hex.builtin.provider.process_memory.process_name"_lang, this->m_processName },
+            { "hex.builtin.provider.process_memory.mappings"_lang,    std::to_string(this->m_mappings.size()) },
+            { "hex.builtin.provider.process_memory.mapped_size"_lang, hex::toByteString(mappedSize) },
+            { "hex.builtin.provider.process_memory.snapshot"_lang,    this->m_snapshotMode ? "hex.builtin.common.yes"_lang : "hex.builtin.common.no"_lang }
+        };
+    }
+
+    void ProcessMemoryProvider::reloadProcesses() {
+        this->m_availableProcesses.clear();
+
+        std::error_code error;
+        for (const auto &entry : std::fs::directory_iterator("/proc", error)) {
+            u32 processId = 0;
+
+            const auto name = entry.path().filename().string();
+            if (std::from_chars(name.data(), name.data() + name.size(), processId).ec != std::errc() || processId == 0)
+                continue;
+
+            this->m_availableProcesses.emplace_back(processId, readProcessName(processId));
+        }
+
+        std::sort(this->m_availableProcesses.begin(), this->m_availableProcesses.end());
+    }
+
+    void ProcessMemoryProvider::drawLoadInterface() {
+        if (this->m_availableProcesses.empty())
+            this->reloadProcesses();
+
+        if (ImGui::BeginListBox("hex.builtin.provider.process_memory.process"_lang)) {
+            for (const auto &[processId, name] : this->m_availableProcesses) {
+                if (ImGui::Selectable(hex::format("{} ({})", name, processId).c_str(), this->m_processId == processId))
+                    this->m_processId = processId;
+            }
+
+            ImGui::EndListBox();
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("hex.builtin.provider.process_memory.reload"_lang))
+            this->reloadProcesses();
+
+        ImGui::Checkbox("hex.builtin.provider.process_memory.snapshot"_lang, &this->m_snapshotMode);
+    }
+
+    void ProcessMemoryProvider::drawInterface() {
+        if (ImGui::Button("hex.builtin.provider.process_memory.reload_mappings"_lang))
+            this->m_available = this->reload();
+    }
+
+    void ProcessMemoryProvider::loadSettings(const nlohmann::json &settings) {
+        Provider::loadSettings(settings);
+
+        this->m_processId = settings["pid"].get<u32>();
+
+        if (settings.contains("snapshot"))
+            this->m_snapshotMode = settings["snapshot"].get<bool>();
+    }
+
+    nlohmann::json ProcessMemoryProvider::storeSettings(nlohmann::json settings) const {
+        settings["pid"]      = this->m_processId;
+        settings["snapshot"] = this->m_snapshotMode;
+
+        return Provider::storeSettings(settings);
+    }
+
+    std::pair<Region, bool> ProcessMemoryProvider::getRegionValidity(u64 address) const {
+        const u64 offset = address - this->getBaseAddress();
+
+        std::shared_lock lock(this->m_mappingMutex);
+
+        auto mapping = this->findMapping(offset);
+        if (mapping == this->m_mappings.end() || mapping->address > offset)
+            return Provider::getRegionValidity(address);
+
+        return { Region { this->getBaseAddress() + mapping->address, mapping->size }, true };
+    }
+
+    std::vector<Region> ProcessMemoryProvider::getRawDataRegions(u64 offset, size_t size) const {
+        std::shared_lock lock(this->m_mappingMutex);
+
+        // Unmapped memory reads as zeros
+        std::vector<Region> regions;
+        const u64 endOffset = offset + size;
+        for (auto mapping = this->findMapping(offset); mapping != this->m_mappings.end() && mapping->address < endOffset; ++mapping) {
+            const u64 start = std::max(offset, mapping->address);
+            regions.push_back({ start, std::min(endOffset, mapping->address + mapping->size) - start });
+        }
+
+        return regions;
+    }
+
+}
@@ -330,6 +330,17 @@ namespace hex::plugin::builtin {
             return false;
         });
 
+        ContentRegistry::Settings::add("hex.builtin.setting.hex_editor", "hex.builtin.setting.hex_editor.undo_history_limit", 256, [](auto name, nlohmann::json &setting) {
+            static int limit = static_cast<int>(setting);
+
+            if (ImGui::SliderInt(name.data(), &limit, 1, 4096, "%d MiB")) {
+                setting = limit;
+                return true;
+            }
+
+            return false;
+        });
+
 
         /* Fonts */
 
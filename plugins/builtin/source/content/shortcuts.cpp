@@ -27,6 +27,7 @@ namespace hex::plugin::builtin {
             if (ImHexApi::Provider::isValid()) {
                 auto provider = ImHexApi::Provider::get();
 
+                provider->waitForAsyncReads();
                 provider->close();
                 if (!provider->open())
                     ImHexApi::Provider::remove(provider, true);
@@ -30,10 +30,20 @@ namespace hex::plugin::builtin {
 
             this->m_shouldInvalidate = true;
         });
+
+        // Bytes appended behind the selection, e.g. by a followed file, can make more of the inspected values available
+        EventManager::subscribe<EventDataRangeChanged>(this, [this](prv::Provider *provider, Region region) {
+            if (provider != ImHexApi::Provider::get() || this->m_validBytes == 0 || region.getEndAddress() < this->m_startAddress)
+                return;
+
+            this->m_validBytes       = u64(provider->getActualSize() - this->m_startAddress);
+            this->m_shouldInvalidate = true;
+        });
     }
 
     ViewDataInspector::~ViewDataInspector() {
         EventManager::unsubscribe<EventRegionSelected>(this);
+        EventManager::unsubscribe<EventDataRangeChanged>(this);
     }
 
     void ViewDataInspector::drawContent() {
@@ -47,17 +57,25 @@ namespace hex::plugin::builtin {
 
             this->m_updateTask = TaskManager::createBackgroundTask("Update Inspector",
                [this, validBytes = this->m_validBytes, startAddress = this->m_startAddress, endian = this->m_endian, invert = this->m_invert, numberDisplayStyle = this->m_numberDisplayStyle](auto &) {
+                hex::prv::IOStatistics::ScopedSubsystem ioSubsystem(hex::prv::IOSubsystem::DataInspector);
                 auto provider = ImHexApi::Provider::get();
 
                 this->m_workData.clear();
 
+                // Read the bytes needed by all inspectors at once instead of once per entry
+                size_t maxSize = 0;
+                for (auto &entry : ContentRegistry::DataInspector::getEntries())
+                    maxSize = std::max(maxSize, entry.maxSize);
+
+                std::vector<u8> inspectedBytes(std::min(validBytes, maxSize));
+                provider->read(startAddress, inspectedBytes.data(), inspectedBytes.size());
+
                 // Decode bytes using registered inspectors
                 for (auto &entry : ContentRegistry::DataInspector::getEntries()) {
                     if (validBytes < entry.requiredSize)
                         continue;
 
-                    std::vector<u8> buffer(validBytes > entry.maxSize ? entry.maxSize : validBytes);
-                    provider->read(startAddress, buffer.data(), buffer.size());
+                    std::vector<u8> buffer(inspectedBytes.begin(), inspectedBytes.begin() + std::min(validBytes, entry.maxSize));
 
                     if (invert) {
                         for (auto &byte : buffer)
@@ -1,11 +1,22 @@
 #include "content/views/view_find.hpp"
 
 #include <hex/api/imhex_api.hpp>
+#include <hex/helpers/aho_corasick.hpp>
+#include <hex/helpers/byte_class.hpp>
+#include <hex/helpers/file.hpp>
+#include <hex/helpers/fs.hpp>
+#include <hex/helpers/literals.hpp>
+#include <hex/helpers/string_scanner.hpp>
 #include <hex/providers/buffered_reader.hpp>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <future>
+#include <numeric>
 #include <regex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <charconv>
 
@@ -13,6 +24,8 @@
 
 namespace hex::plugin::builtin {
 
+    using namespace hex::literals;
+
     ViewFind::ViewFind() : View("hex.builtin.view.find.name") {
         const static auto HighlightColor = [] { return (ImGui::GetCustomColorU32(ImGuiCustomCol_ToolbarPurple) & 0x00FFFFFF) | 0x70000000; };
 
@@ -152,6 +165,27 @@ namespace hex::plugin::builtin {
         return result;
     }
 
+    std::vector<std::string> ViewFind::parseSequenceList(const std::string &input) {
+        std::vector<std::string> result;
+
+        for (auto line : hex::splitString(input, "\n")) {
+            hex::trim(line);
+
+            if (!line.empty())
+                result.push_back(std::move(line));
+        }
+
+        return result;
+    }
+
+    void ViewFind::updateSequenceList(SearchSettings::SequenceList &settings) {
+        // Every line holds one sequence in the same format as the sequence search
+        settings.sequences = parseSequenceList(settings.input);
+        settings.valid = !settings.sequences.empty() && std::all_of(settings.sequences.begin(), settings.sequences.end(), [](const auto &sequence) {
+            return !hex::decodeByteString(sequence).empty();
+        });
+    }
+
     template<typename Type, typename StorageType>
     static std::tuple<bool, std::variant<u64, i64, float, double>, size_t> parseNumericValue(const std::string &string) {
         static_assert(sizeof(StorageType) >= sizeof(Type));
@@ -199,50 +233,109 @@ namespace hex::plugin::builtin {
         return hex::format("{}", value);
     }
 
-    std::vector<ViewFind::Occurrence> ViewFind::searchStrings(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Strings &settings) {
-        using enum SearchSettings::Strings::Type;
+    // Holes in sparse data read as zeros, so searches that can't match a run of zeros only need to look at the allocated regions.
+    // Each region is padded so matches that begin or end inside of a hole are still found
+    static std::vector<Region> getDataSearchRegions(const prv::ProviderSnapshot &snapshot, Region searchRegion, size_t padding) {
+        std::vector<Region> result;
+        for (const auto &region : snapshot.getDataRegions(searchRegion.getStartAddress(), searchRegion.getSize())) {
+            const u64 start = std::max<u64>(region.getStartAddress() - std::min<u64>(region.getStartAddress(), padding), searchRegion.getStartAddress());
+            const u64 end   = std::min<u64>(region.getEndAddress() + std::min<u64>(padding, searchRegion.getEndAddress() - region.getEndAddress()), searchRegion.getEndAddress());
+
+            if (!result.empty() && result.back().getEndAddress() + 1 >= start)
+                result.back().size = end - result.back().getStartAddress() + 1;
+            else
+                result.push_back(Region { start, end - start + 1 });
+        }
 
-        std::vector<Occurrence> results;
+        return result;
+    }
+
+    // Splits the regions into chunks and searches them on all cores. searchChunk is called with a chunk and the region it lies in and may read
+    // past the end of the chunk to find matches that start inside of it. Only those are kept, so matches in the overlap with the next chunk
+    // aren't reported twice. The results are returned in the same order as if the regions had been searched front to back
+    template<typename Function>
+    static auto searchChunked(Task &task, const std::vector<Region> &regions, Function &&searchChunk) {
+        using Results = std::invoke_result_t<Function &, Region, Region>;
+
+        u64 totalSize = 0;
+        for (const auto &region : regions)
+            totalSize += region.getSize();
+        task.setMaxValue(totalSize);
+
+        // Small enough chunks that every worker gets a few of them and interrupting a search doesn't take long
+        const auto threadCount = std::max<u32>(std::thread::hardware_concurrency(), 1);
+        const u64 chunkSize = std::clamp<u64>(totalSize / (threadCount * 8), 1_MiB, 16_MiB);
+
+        std::vector<std::pair<Region, Region>> chunks;
+        for (const auto &region : regions) {
+            for (u64 offset = 0; offset < region.getSize(); offset += chunkSize)
+                chunks.emplace_back(region, Region { region.getStartAddress() + offset, std::min<u64>(chunkSize, region.getSize() - offset) });
+        }
 
-        if (settings.type == ASCII_UTF16BE || settings.type == ASCII_UTF16LE) {
-            auto newSettings = settings;
+        std::vector<Results> chunkResults(chunks.size());
+        std::atomic<size_t> nextChunk = 0;
+        std::atomic<bool> failed = false;
 
-            newSettings.type = ASCII;
-            auto asciiResults = searchStrings(task, provider, searchRegion, newSettings);
-            std::copy(asciiResults.begin(), asciiResults.end(), std::back_inserter(results));
+        // The subsystem reads get counted towards is per thread, so the workers have to take it over from the one starting the search
+        const auto subsystem = hex::prv::IOStatistics::getCurrentSubsystem();
 
-            if (settings.type == ASCII_UTF16BE) {
-                newSettings.type = UTF16BE;
-                auto utf16Results = searchStrings(task, provider, searchRegion, newSettings);
-                std::copy(utf16Results.begin(), utf16Results.end(), std::back_inserter(results));
-            } else if (settings.type == ASCII_UTF16LE) {
-                newSettings.type = UTF16LE;
-                auto utf16Results = searchStrings(task, provider, searchRegion, newSettings);
-                std::copy(utf16Results.begin(), utf16Results.end(), std::back_inserter(results));
+        auto worker = [&] {
+            hex::prv::IOStatistics::ScopedSubsystem ioSubsystem(subsystem);
+
+            try {
+                for (size_t i = nextChunk++; i < chunks.size() && !failed; i = nextChunk++) {
+                    const auto &[region, chunk] = chunks[i];
+
+                    auto results = searchChunk(region, chunk);
+                    std::erase_if(results, [&chunk](const auto &occurrence) {
+                        return occurrence.region.getStartAddress() < chunk.getStartAddress() || occurrence.region.getStartAddress() > chunk.getEndAddress();
+                    });
+                    chunkResults[i] = std::move(results);
+
+                    task.increment(chunk.getSize());
+                }
+            } catch (...) {
+                failed = true;
+                throw;
+            }
+        };
+
+        if (chunks.size() <= 1) {
+            worker();
+        } else {
+            std::vector<std::future<void>> futures;
+            for (u32 thread = 0; thread < std::min<u64>(threadCount, chunks.size()); thread++)
+                futures.push_back(std::async(std::launch::async, worker));
+
+            // Interrupting the task makes all workers throw. Wait for every one of them before passing that on
+            std::exception_ptr exception;
+            for (auto &future : futures) {
+                try {
+                    future.get();
+                } catch (...) {
+                    if (exception == nullptr)
+                        exception = std::current_exception();
+                }
             }
 
-            return results;
+            if (exception != nullptr)
+                std::rethrow_exception(exception);
         }
 
-        auto reader = prv::BufferedReader(provider);
-        reader.seek(searchRegion.getStartAddress());
-        reader.setEndAddress(searchRegion.getEndAddress());
-
-        const auto [decodeType, endian] = [&] -> std::pair<Occurrence::DecodeType, std::endian> {
-            if (settings.type == ASCII)
-                return { Occurrence::DecodeType::ASCII, std::endian::native };
-            else if (settings.type == SearchSettings::Strings::Type::UTF16BE)
-                return { Occurrence::DecodeType::UTF16, std::endian::big };
-            else if (settings.type == SearchSettings::Strings::Type::UTF16LE)
-                return { Occurrence::DecodeType::UTF16, std::endian::little };
-            else
-                return { Occurrence::DecodeType::Binary, std::endian::native };
-        }();
+        Results results;
+        for (auto &chunk : chunkResults)
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(results));
 
-        size_t countedCharacters = 0;
-        u64 startAddress = reader.begin().getAddress();
-        for (u8 byte : reader) {
-            bool validChar =
+        return results;
+    }
+
+    std::vector<ViewFind::Occurrence> ViewFind::searchStrings(Task &task, const prv::ProviderSnapshot &snapshot, hex::Region searchRegion, const SearchSettings::Strings &settings, const std::function<bool(const Occurrence &)> &filter) {
+        using enum SearchSettings::Strings::Type;
+
+        // Valid characters are looked up in a table so whole blocks of bytes can be classified at once
+        std::array<bool, 256> characterTable = { };
+        for (u32 byte = 0; byte < characterTable.size(); byte++) {
+            characterTable[byte] =
                 (settings.m_lowerCaseLetters    && std::islower(byte))  ||
                 (settings.m_upperCaseLetters    && std::isupper(byte))  ||
                 (settings.m_numbers             && std::isdigit(byte))  ||
@@ -250,64 +343,166 @@ namespace hex::plugin::builtin {
                 (settings.m_underscores         && byte == '_')             ||
                 (settings.m_symbols             && std::ispunct(byte))  ||
                 (settings.m_lineFeeds           && byte == '\n');
+        }
+        const ByteClass characterClass(characterTable);
+
+        // Bytes that start a multibyte UTF-8 sequence
+        std::array<bool, 256> leadTable = { };
+        std::fill(leadTable.begin() + 0xC2, leadTable.begin() + 0xF5, true);
+        const ByteClass leadClass(leadTable);
+
+        struct UnitEncoding {
+            size_t width;
+            std::endian endian;
+            Occurrence::DecodeType decodeType;
+        };
+
+        const auto type = settings.type;
+        std::vector<UnitEncoding> unitEncodings;
+        if (type == ASCII || type == ASCII_UTF16LE || type == ASCII_UTF16BE)
+            unitEncodings.push_back({ 1, std::endian::little, Occurrence::DecodeType::ASCII });
+        if (type == UTF16LE || type == ASCII_UTF16LE || type == All)
+            unitEncodings.push_back({ 2, std::endian::little, Occurrence::DecodeType::UTF16 });
+        if (type == UTF16BE || type == ASCII_UTF16BE || type == All)
+            unitEncodings.push_back({ 2, std::endian::big, Occurrence::DecodeType::UTF16 });
+        if (type == UTF32LE || type == All)
+            unitEncodings.push_back({ 4, std::endian::little, Occurrence::DecodeType::UTF32 });
+        if (type == UTF32BE || type == All)
+            unitEncodings.push_back({ 4, std::endian::big, Occurrence::DecodeType::UTF32 });
+
+        const bool searchUTF8 = type == UTF8 || type == All;
+        const size_t minLength = settings.minLength;
+
+        // Strings never contain a zero byte apart from the ones in UTF-16 and UTF-32 units, so four bytes of padding are enough
+        return searchChunked(task, getDataSearchRegions(snapshot, searchRegion, 4), [&](Region region, Region chunk) {
+            std::vector<Occurrence> results;
+            auto addResult = [&](Region stringRegion, Occurrence::DecodeType decodeType, std::endian endian) {
+                results.push_back(Occurrence { stringRegion, decodeType, endian });
+            };
+
+            // Every selected encoding gets its own scanner. All of them are fed from the same pass over the data
+            std::vector<UnitStringScanner> unitScanners;
+            for (const auto &encoding : unitEncodings)
+                unitScanners.emplace_back(encoding.width, encoding.endian == std::endian::little ? 0 : encoding.width - 1, minLength, settings.nullTermination);
+
+            UTF8StringScanner utf8Scanner(minLength, settings.nullTermination);
+            auto addUTF8Result = [&](Region stringRegion, bool multibyte) {
+                addResult(stringRegion, multibyte ? Occurrence::DecodeType::UTF8 : Occurrence::DecodeType::ASCII, std::endian::native);
+            };
+
+            auto hasOpenString = [&] {
+                return std::any_of(unitScanners.begin(), unitScanners.end(), [&](const auto &scanner) { return scanner.hasOpenString(chunk); }) ||
+                       (searchUTF8 && utf8Scanner.hasOpenString(chunk));
+            };
+
+            // Starting a few bytes early makes strings that cross into the chunk start before it, so they're left to the previous chunk.
+            // After the end of the chunk, reading only goes on in small steps until the strings that started inside of it have ended.
+            // Every step ends on a block boundary since the scanners take a partial block as the end of the data
+            const u64 startAddress = chunk.getStartAddress() - std::min<u64>(chunk.getStartAddress() - region.getStartAddress(), 4);
+            auto blockAlignedEnd = [&](u64 address) {
+                return std::min<u64>(startAddress + hex::alignTo<u64>(address - startAddress + 1, ByteClass::BlockSize) - 1, region.getEndAddress());
+            };
+
+            u64 readAddress = startAddress, readEndAddress = blockAlignedEnd(chunk.getEndAddress()), lookaheadSize = 4_KiB;
+            auto reader = prv::BufferedReader(snapshot, readEndAddress - startAddress + 1);
+            while (true) {
+                reader.seek(readAddress);
+                reader.setEndAddress(readEndAddress);
+
+                for (const auto &buffer : reader.chunks()) {
+                    for (size_t blockOffset = 0; blockOffset < buffer.data.size(); blockOffset += ByteClass::BlockSize) {
+                        const u8 *block = buffer.data.data() + blockOffset;
+                        const size_t blockSize = std::min<size_t>(ByteClass::BlockSize, buffer.data.size() - blockOffset);
+                        const u64 blockAddress = buffer.address + blockOffset;
+
+                        u64 members, zeros;
+                        characterClass.classify(block, blockSize, members, zeros);
+
+                        for (size_t i = 0; i < unitScanners.size(); i++) {
+                            unitScanners[i].feed(blockAddress, blockSize, members, zeros, [&, &encoding = unitEncodings[i]](Region stringRegion) {
+                                addResult(stringRegion, encoding.decodeType, encoding.endian);
+                            });
+                        }
 
-            if (settings.type == UTF16LE) {
-                // Check if second byte of UTF-16 encoded string is 0x00
-                if (countedCharacters % 2 == 1)
-                    validChar =  byte == 0x00;
-            } else if (settings.type == UTF16BE) {
-                // Check if first byte of UTF-16 encoded string is 0x00
-                if (countedCharacters % 2 == 0)
-                    validChar =  byte == 0x00;
-            }
+                        if (searchUTF8) {
+                            u64 leads, unused;
+                            leadClass.classify(block, blockSize, leads, unused);
 
-            if (validChar)
-                countedCharacters++;
-            else {
-                if (countedCharacters >= size_t(settings.minLength)) {
-                    if (!(settings.nullTermination && byte != 0x00)) {
-                        results.push_back(Occurrence { Region { startAddress, countedCharacters }, decodeType, endian });
+                            utf8Scanner.feed(block, blockAddress, blockSize, members, zeros, leads, addUTF8Result);
+                        }
                     }
                 }
 
-                startAddress += countedCharacters + 1;
-                countedCharacters = 0;
-                task.update(startAddress - searchRegion.getStartAddress());
+                if (readEndAddress >= region.getEndAddress() || !hasOpenString())
+                    break;
+
+                readAddress    = readEndAddress + 1;
+                readEndAddress = std::min<u64>(readEndAddress + lookaheadSize, region.getEndAddress());
+                lookaheadSize  = std::min<u64>(lookaheadSize * 2, 1_MiB);
             }
-        }
 
-        return results;
-    }
+            // Strings that run up to the end of the region have nothing after them that could end them
+            for (size_t i = 0; i < unitScanners.size(); i++) {
+                unitScanners[i].flush([&, &encoding = unitEncodings[i]](Region stringRegion) {
+                    addResult(stringRegion, encoding.decodeType, encoding.endian);
+                });
+            }
+
+            if (searchUTF8)
+                utf8Scanner.flush(addUTF8Result);
+
+            // Strings that start outside of the chunk get dropped anyway, so only the remaining ones are worth filtering
+            std::erase_if(results, [&](const auto &occurrence) {
+                return occurrence.region.getStartAddress() < chunk.getStartAddress() || occurrence.region.getStartAddress() > chunk.getEndAddress() ||
+                       (filter && !filter(occurrence));
+            });
 
-    std::vector<ViewFind::Occurrence> ViewFind::searchSequence(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Sequence &settings) {
-        std::vector<Occurrence> results;
+            std::stable_sort(results.begin(), results.end(), [](const auto &a, const auto &b) {
+                return a.region.getStartAddress() < b.region.getStartAddress();
+            });
 
-        auto reader = prv::BufferedReader(provider);
-        reader.seek(searchRegion.getStartAddress());
-        reader.setEndAddress(searchRegion.getEndAddress());
+            return results;
+        });
+    }
 
+    std::vector<ViewFind::Occurrence> ViewFind::searchSequence(Task &task, const prv::ProviderSnapshot &snapshot, hex::Region searchRegion, const SearchSettings::Sequence &settings) {
         auto bytes = hex::decodeByteString(settings.sequence);
 
         if (bytes.empty())
             return { };
 
-        auto occurrence = reader.begin();
-        while (true) {
-            occurrence = std::search(reader.begin(), reader.end(), std::boyer_moore_horspool_searcher(bytes.begin(), bytes.end()));
-            if (occurrence == reader.end())
-                break;
+        std::vector<Region> regions = { searchRegion };
+        if (std::any_of(bytes.begin(), bytes.end(), [](u8 byte) { return byte != 0x00; }))
+            regions = getDataSearchRegions(snapshot, searchRegion, bytes.size() - 1);
 
-            auto address = occurrence.getAddress();
-            reader.seek(address + 1);
-            results.push_back(Occurrence{ Region { address, bytes.size() }, Occurrence::DecodeType::Binary, std::endian::native });
-            task.update(address - searchRegion.getStartAddress());
-        }
+        // Chunks overlap by the length of the sequence minus one so matches across their ends are found
+        return searchChunked(task, regions, [&](Region region, Region chunk) {
+            std::vector<Occurrence> results;
 
-        return results;
+            auto reader = prv::BufferedReader(snapshot);
+            reader.seek(chunk.getStartAddress());
+            reader.setEndAddress(std::min<u64>(chunk.getEndAddress() + (bytes.size() - 1), region.getEndAddress()));
+
+            auto occurrence = reader.begin();
+            while (true) {
+                occurrence = std::search(reader.begin(), reader.end(), std::boyer_moore_horspool_searcher(bytes.begin(), bytes.end()));
+                if (occurrence == reader.end())
+                    break;
+
+                auto address = occurrence.getAddress();
+                reader.seek(address + 1);
+                results.push_back(Occurrence{ Region { address, bytes.size() }, Occurrence::DecodeType::Binary, std::endian::native });
+            }
+
+            return results;
+        });
     }
 
-    std::vector<ViewFind::Occurrence> ViewFind::searchRegex(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Regex &settings) {
-        auto stringOccurrences = searchStrings(task, provider, searchRegion, SearchSettings::Strings {
+    std::vector<ViewFind::Occurrence> ViewFind::searchRegex(Task &task, const prv::ProviderSnapshot &snapshot, hex::Region searchRegion, const SearchSettings::Regex &settings) {
+        const std::regex regex(settings.pattern);
+
+        // Strings are matched against the pattern right in the chunk they were found in, so that work is spread over all cores as well
+        return searchStrings(task, snapshot, searchRegion, SearchSettings::Strings {
             .minLength          = 1,
             .type               = SearchSettings::Strings::Type::ASCII,
             .m_lowerCaseLetters = true,
@@ -317,66 +512,58 @@ namespace hex::plugin::builtin {
             .m_symbols          = true,
             .m_spaces           = true,
             .m_lineFeeds        = true
+        }, [&](const Occurrence &occurrence) {
+            std::string string(occurrence.region.getSize(), '\x00');
+            snapshot.read(occurrence.region.getStartAddress(), string.data(), occurrence.region.getSize());
+
+            if (settings.fullMatch)
+                return std::regex_match(string, regex);
+            else
+                return std::regex_search(string, regex);
         });
+    }
 
-        std::vector<Occurrence> result;
-        std::regex regex(settings.pattern);
-        for (const auto &occurrence : stringOccurrences) {
-            std::string string(occurrence.region.getSize(), '\x00');
-            provider->read(occurrence.region.getStartAddress(), string.data(), occurrence.region.getSize());
+    std::vector<ViewFind::Occurrence> ViewFind::searchBinaryPattern(Task &task, const prv::ProviderSnapshot &snapshot, hex::Region searchRegion, const SearchSettings::BinaryPattern &settings) {
+        const MaskedPattern pattern(settings.pattern);
+        const size_t patternSize = pattern.getSize();
 
-            if (settings.fullMatch) {
-                if (std::regex_match(string, regex))
-                    result.push_back(occurrence);
-            } else {
-                if (std::regex_search(string, regex))
-                    result.push_back(occurrence);
-            }
-        }
+        if (patternSize == 0)
+            return { };
 
-        return result;
-    }
+        std::vector<Region> regions = { searchRegion };
+        if (std::any_of(settings.pattern.begin(), settings.pattern.end(), [](const auto &pattern) { return pattern.value != 0x00; }))
+            regions = getDataSearchRegions(snapshot, searchRegion, patternSize - 1);
 
-    std::vector<ViewFind::Occurrence> ViewFind::searchBinaryPattern(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::BinaryPattern &settings) {
-        std::vector<Occurrence> results;
+        // Chunks overlap by the length of the pattern minus one so matches across their ends are found
+        return searchChunked(task, regions, [&](Region region, Region chunk) {
+            std::vector<Occurrence> results;
 
-        auto reader = prv::BufferedReader(provider);
-        reader.seek(searchRegion.getStartAddress());
-        reader.setEndAddress(searchRegion.getEndAddress());
+            auto reader = prv::BufferedReader(snapshot);
+            reader.setEndAddress(region.getEndAddress());
 
-        u32 matchedBytes = 0;
-        const size_t patternSize = settings.pattern.size();
+            // Buffers overlap by the length of the pattern minus one as well
+            const auto endAddress = std::min<u64>(chunk.getEndAddress() + (patternSize - 1), region.getEndAddress());
+            u64 address = chunk.getStartAddress();
+            while (true) {
+                const auto data = reader.readChunk(address, endAddress - address + 1);
+                if (data.size() < patternSize)
+                    break;
 
-        for (auto it = reader.begin(); it != reader.end(); ++it) {
-            auto byte = *it;
+                pattern.search(data.data(), data.size(), [&](size_t offset) {
+                    results.push_back(Occurrence { Region { address + offset, patternSize }, Occurrence::DecodeType::Binary, std::endian::native });
+                });
 
-            if ((byte & settings.pattern[matchedBytes].mask) == settings.pattern[matchedBytes].value) {
-                matchedBytes++;
-                if (matchedBytes == settings.pattern.size()) {
-                    auto occurrenceAddress = it.getAddress() - (patternSize - 1);
+                if (address + data.size() > endAddress)
+                    break;
 
-                    results.push_back(Occurrence { Region { occurrenceAddress, patternSize }, Occurrence::DecodeType::Binary, std::endian::native });
-                    task.update(occurrenceAddress);
-                    it.setAddress(occurrenceAddress);
-                    matchedBytes = 0;
-                }
-            } else {
-                if (matchedBytes > 0)
-                    it -= matchedBytes;
-                matchedBytes = 0;
+                address += data.size() - (patternSize - 1);
             }
-        }
 
-        return results;
+            return results;
+        });
     }
 
-    std::vector<ViewFind::Occurrence> ViewFind::searchValue(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Value &settings) {
-        std::vector<Occurrence> results;
-
-        auto reader = prv::BufferedReader(provider);
-        reader.seek(searchRegion.getStartAddress());
-        reader.setEndAddress(searchRegion.getEndAddress());
-
+    std::vector<ViewFind::Occurrence> ViewFind::searchValue(Task &task, const prv::ProviderSnapshot &snapshot, Region searchRegion, const SearchSettings::Value &settings) {
         const auto [validMin, min, sizeMin] = parseNumericValueInput(settings.inputMin, settings.type);
         const auto [validMax, max, sizeMax] = parseNumericValueInput(settings.inputMax, settings.type);
 
@@ -385,56 +572,116 @@ namespace hex::plugin::builtin {
 
         const auto size = sizeMin;
 
-        u64 bytes = 0x00;
-        u64 address = searchRegion.getStartAddress();
-        size_t validBytes = 0;
-        for (u8 byte : reader) {
-            bytes <<= 8;
-            bytes |= byte;
-
-            if (validBytes == size) {
-                bytes &= hex::bitmask(size * 8);
-
-                auto result = std::visit([&](auto tag) {
-                    using T = std::remove_cvref_t<std::decay_t<decltype(tag)>>;
-
-                    auto minValue = std::get<T>(min);
-                    auto maxValue = std::get<T>(max);
-
-                    T value = 0;
-                    std::memcpy(&value, &bytes, size);
-                    value = hex::changeEndianess(value, size, std::endian::big);
-                    value = hex::changeEndianess(value, size, settings.endian);
-
-                    return value >= minValue && value <= maxValue;
-                }, min);
-
-                if (result) {
-                    Occurrence::DecodeType decodeType = [&]{
-                        switch (settings.type) {
-                            using enum SearchSettings::Value::Type;
-                            using enum Occurrence::DecodeType;
-
-                            case U8 ... U64:    return Unsigned;
-                            case I8 ... I64:    return Signed;
-                            case F32:           return Float;
-                            case F64:           return Double;
-                            default:            return Binary;
-                        }
-                    }();
+        auto isInRange = [&](u64 bytes) {
+            return std::visit([&](auto tag) {
+                using T = std::remove_cvref_t<std::decay_t<decltype(tag)>>;
+
+                auto minValue = std::get<T>(min);
+                auto maxValue = std::get<T>(max);
+
+                T value = 0;
+                std::memcpy(&value, &bytes, size);
+                value = hex::changeEndianess(value, size, std::endian::big);
+                value = hex::changeEndianess(value, size, settings.endian);
+
+                return value >= minValue && value <= maxValue;
+            }, min);
+        };
+
+        std::vector<Region> regions = { searchRegion };
+        if (!isInRange(0x00))
+            regions = getDataSearchRegions(snapshot, searchRegion, size - 1);
+
+        // Chunks overlap by the size of the value minus one so values across their ends are found
+        return searchChunked(task, regions, [&](Region region, Region chunk) {
+            std::vector<Occurrence> results;
+
+            auto reader = prv::BufferedReader(snapshot);
+            reader.seek(chunk.getStartAddress());
+            reader.setEndAddress(std::min<u64>(chunk.getEndAddress() + (size - 1), region.getEndAddress()));
+
+            u64 bytes = 0x00;
+            u64 address = chunk.getStartAddress();
+            size_t validBytes = 0;
+            for (const auto &buffer : reader.chunks()) {
+                for (u8 byte : buffer.data) {
+                    bytes <<= 8;
+                    bytes |= byte;
+
+                    if (validBytes < size)
+                        validBytes++;
+
+                    if (validBytes == size) {
+                        bytes &= hex::bitmask(size * 8);
+
+                        if (isInRange(bytes)) {
+                            Occurrence::DecodeType decodeType = [&]{
+                                switch (settings.type) {
+                                    using enum SearchSettings::Value::Type;
+                                    using enum Occurrence::DecodeType;
+
+                                    case U8 ... U64:    return Unsigned;
+                                    case I8 ... I64:    return Signed;
+                                    case F32:           return Float;
+                                    case F64:           return Double;
+                                    default:            return Binary;
+                                }
+                            }();
+
 
+                            results.push_back(Occurrence { Region { address - (size - 1), size }, decodeType, settings.endian });
+                        }
+                    }
 
-                    results.push_back(Occurrence { Region { address - (size - 1), size }, decodeType, settings.endian });
+                    address++;
                 }
-            } else {
-                validBytes++;
             }
 
-            address++;
-            task.update(address);
-        }
+            return results;
+        });
+    }
 
-        return results;
+    std::vector<ViewFind::Occurrence> ViewFind::searchSequenceList(Task &task, const prv::ProviderSnapshot &snapshot, Region searchRegion, const SearchSettings::SequenceList &settings) {
+        std::vector<std::vector<u8>> sequences;
+        for (const auto &sequence : settings.sequences)
+            sequences.push_back(hex::decodeByteString(sequence));
+
+        // All sequences are looked for at once in a single pass over the data
+        const AhoCorasick automaton(sequences);
+        const size_t maxLength = automaton.getMaxNeedleLength();
+        if (maxLength == 0)
+            return { };
+
+        std::vector<Region> regions = { searchRegion };
+        const bool canMatchZeros = std::any_of(sequences.begin(), sequences.end(), [](const auto &sequence) {
+            return !sequence.empty() && std::all_of(sequence.begin(), sequence.end(), [](u8 byte) { return byte == 0x00; });
+        });
+        if (!canMatchZeros)
+            regions = getDataSearchRegions(snapshot, searchRegion, maxLength - 1);
+
+        // Chunks overlap by the length of the longest sequence minus one so matches across their ends are found
+        return searchChunked(task, regions, [&](Region region, Region chunk) {
+            std::vector<Occurrence> results;
+
+            auto reader = prv::BufferedReader(snapshot);
+            reader.seek(chunk.getStartAddress());
+            reader.setEndAddress(std::min<u64>(chunk.getEndAddress() + (maxLength - 1), region.getEndAddress()));
+
+            auto state = AhoCorasick::Root;
+            for (const auto &buffer : reader.chunks()) {
+                state = automaton.search(state, buffer.data.data(), buffer.data.size(), [&](u32 sequence, size_t offset) {
+                    const size_t length = automaton.getNeedleLength(sequence);
+                    results.push_back(Occurrence { Region { buffer.address + offset + 1 - length, length }, Occurrence::DecodeType::Binary, std::endian::native, sequence });
+                });
+            }
+
+            // Matches are reported in the order they end in
+            std::stable_sort(results.begin(), results.end(), [](const auto &a, const auto &b) {
+                return a.region.getStartAddress() < b.region.getStartAddress();
+            });
+
+            return results;
+        });
     }
 
     void ViewFind::runSearch() {
@@ -447,28 +694,33 @@ namespace hex::plugin::builtin {
             }
         }();
 
-        this->m_searchTask = TaskManager::createTask("hex.builtin.view.find.searching", searchRegion.getSize(), [this, settings = this->m_searchSettings, searchRegion](auto &task) {
-            auto provider = ImHexApi::Provider::get();
+        this->m_searchTask = TaskManager::createTask("hex.builtin.view.find.searching", searchRegion.getSize(), [this, settings = this->m_searchSettings, searchRegion, snapshot = ImHexApi::Provider::get()->snapshot()](auto &task) {
+            hex::prv::IOStatistics::ScopedSubsystem ioSubsystem(hex::prv::IOSubsystem::Find);
+            auto provider = snapshot.getProvider();
 
             switch (settings.mode) {
                 using enum SearchSettings::Mode;
                 case Strings:
-                    this->m_foundOccurrences[provider] = searchStrings(task, provider, searchRegion, settings.strings);
+                    this->m_foundOccurrences[provider] = searchStrings(task, snapshot, searchRegion, settings.strings);
                     break;
                 case Sequence:
-                    this->m_foundOccurrences[provider] = searchSequence(task, provider, searchRegion, settings.bytes);
+                    this->m_foundOccurrences[provider] = searchSequence(task, snapshot, searchRegion, settings.bytes);
                     break;
                 case Regex:
-                    this->m_foundOccurrences[provider] = searchRegex(task, provider, searchRegion, settings.regex);
+                    this->m_foundOccurrences[provider] = searchRegex(task, snapshot, searchRegion, settings.regex);
                     break;
                 case BinaryPattern:
-                    this->m_foundOccurrences[provider] = searchBinaryPattern(task, provider, searchRegion, settings.binaryPattern);
+                    this->m_foundOccurrences[provider] = searchBinaryPattern(task, snapshot, searchRegion, settings.binaryPattern);
                     break;
                 case Value:
-                    this->m_foundOccurrences[provider] = searchValue(task, provider, searchRegion, settings.value);
+                    this->m_foundOccurrences[provider] = searchValue(task, snapshot, searchRegion, settings.value);
+                    break;
+                case SequenceList:
+                    this->m_foundOccurrences[provider] = searchSequenceList(task, snapshot, searchRegion, settings.sequenceList);
                     break;
             }
 
+            this->m_decodeSettings[provider] = settings;
             this->m_sortedOccurrences[provider] = this->m_foundOccurrences[provider];
 
             OccurrenceTree::interval_vector intervals;
@@ -479,14 +731,42 @@ namespace hex::plugin::builtin {
     }
 
     std::string ViewFind::decodeValue(prv::Provider *provider, Occurrence occurrence) const {
-        std::vector<u8> bytes(std::min<size_t>(occurrence.region.getSize(), 128));
-        provider->read(occurrence.region.getStartAddress(), bytes.data(), bytes.size());
+        return this->decodeValues(provider, std::span(&occurrence, 1)).front();
+    }
+
+    std::vector<std::string> ViewFind::decodeValues(prv::Provider *provider, std::span<const Occurrence> occurrences) const {
+        // The bytes of all occurrences are read with a single batched request so slow providers only pay the latency once
+        std::vector<std::vector<u8>> bytes(occurrences.size());
+        std::vector<prv::ReadRequest> requests;
+        for (size_t i = 0; i < occurrences.size(); i++) {
+            bytes[i].resize(std::min<size_t>(occurrences[i].region.getSize(), 128));
+            requests.push_back({ occurrences[i].region.getStartAddress(), bytes[i].data(), bytes[i].size() });
+        }
+
+        provider->readMany(requests);
+
+        const auto settings = this->m_decodeSettings.find(provider);
 
-        if (occurrence.endian != std::endian::native)
+        std::vector<std::string> result;
+        for (size_t i = 0; i < occurrences.size(); i++) {
+            if (settings != this->m_decodeSettings.end())
+                result.push_back(decodeBytes(settings->second, occurrences[i], std::move(bytes[i])));
+            else
+                result.push_back(hex::encodeByteString(bytes[i]));
+        }
+
+        return result;
+    }
+
+    std::string ViewFind::decodeBytes(const SearchSettings &settings, const Occurrence &occurrence, std::vector<u8> bytes) {
+        // Strings keep the order of their characters, only the bytes within a unit depend on the endianness
+        const bool isString = occurrence.decodeType == Occurrence::DecodeType::ASCII || occurrence.decodeType == Occurrence::DecodeType::UTF8 ||
+                              occurrence.decodeType == Occurrence::DecodeType::UTF16 || occurrence.decodeType == Occurrence::DecodeType::UTF32;
+        if (occurrence.endian != std::endian::native && !isString)
             std::reverse(bytes.begin(), bytes.end());
 
         std::string result;
-        switch (this->m_decodeSettings.mode) {
+        switch (settings.mode) {
             using enum SearchSettings::Mode;
 
             case Value:
@@ -498,9 +778,22 @@ namespace hex::plugin::builtin {
                     case ASCII:
                         result = hex::encodeByteString(bytes);
                         break;
+                    case UTF8:
+                        for (u8 byte : bytes) {
+                            if (byte < 0x80)
+                                result += hex::encodeByteString({ byte });
+                            else
+                                result += char(byte);
+                        }
+                        break;
                     case UTF16:
-                        for (size_t i = 0; i < bytes.size(); i += 2)
+                    case UTF32:
+                    {
+                        const size_t width = occurrence.decodeType == UTF16 ? 2 : 4;
+                        const size_t characterByte = occurrence.endian == std::endian::little ? 0 : width - 1;
+                        for (size_t i = characterByte; i < bytes.size(); i += width)
                             result += hex::encodeByteString({ bytes[i] });
+                    }
                         break;
                     case Unsigned:
                         result += formatBytes<u64>(bytes);
@@ -522,6 +815,12 @@ namespace hex::plugin::builtin {
             case BinaryPattern:
                 result = hex::encodeByteString(bytes);
                 break;
+            case SequenceList:
+                if (occurrence.sequenceIndex < settings.sequenceList.sequences.size())
+                    result = settings.sequenceList.sequences[occurrence.sequenceIndex];
+                else
+                    result = hex::encodeByteString(bytes);
+                break;
         }
 
         return result;
@@ -562,12 +861,16 @@ namespace hex::plugin::builtin {
                         if (settings.minLength < 1)
                             settings.minLength = 1;
 
-                        const std::array<std::string, 5> StringTypes = {
+                        const std::array<std::string, 9> StringTypes = {
                             "hex.builtin.common.encoding.ascii"_lang,
                             "hex.builtin.common.encoding.utf16le"_lang,
                             "hex.builtin.common.encoding.utf16be"_lang,
                             hex::format("{} + {}", "hex.builtin.common.encoding.ascii"_lang, "hex.builtin.common.encoding.utf16le"_lang),
-                            hex::format("{} + {}", "hex.builtin.common.encoding.ascii"_lang, "hex.builtin.common.encoding.utf16be"_lang)
+                            hex::format("{} + {}", "hex.builtin.common.encoding.ascii"_lang, "hex.builtin.common.encoding.utf16be"_lang),
+                            "hex.builtin.common.encoding.utf8"_lang,
+                            "hex.builtin.common.encoding.utf32le"_lang,
+                            "hex.builtin.common.encoding.utf32be"_lang,
+                            "hex.builtin.view.find.strings.all_encodings"_lang
                         };
 
                         if (ImGui::BeginCombo("hex.builtin.common.type"_lang, StringTypes[std::to_underlying(settings.type)].c_str())) {
@@ -705,6 +1008,29 @@ namespace hex::plugin::builtin {
 
                         ImGui::EndTabItem();
                     }
+                    if (ImGui::BeginTabItem("hex.builtin.view.find.sequence_list"_lang)) {
+                        auto &settings = this->m_searchSettings.sequenceList;
+
+                        mode = SearchSettings::Mode::SequenceList;
+
+                        bool edited = ImGui::InputTextMultiline("hex.builtin.view.find.sequence_list.sequences"_lang, settings.input, ImVec2(0, ImGui::GetTextLineHeight() * 8));
+
+                        if (ImGui::Button("hex.builtin.view.find.sequence_list.load"_lang)) {
+                            fs::openFileBrowser(fs::DialogMode::Open, { }, [&settings](const std::fs::path &path) {
+                                settings.input = fs::File(path, fs::File::Mode::Read).readString();
+                                updateSequenceList(settings);
+                            });
+                        }
+
+                        if (edited)
+                            updateSequenceList(settings);
+
+                        this->m_settingsValid = settings.valid;
+
+                        ImGui::TextFormatted("hex.builtin.view.find.sequence_list.count"_lang, settings.sequences.size());
+
+                        ImGui::EndTabItem();
+                    }
 
                     ImGui::EndTabBar();
                 }
@@ -715,8 +1041,6 @@ namespace hex::plugin::builtin {
                 {
                     if (ImGui::Button("hex.builtin.view.find.search"_lang)) {
                         this->runSearch();
-
-                        this->m_decodeSettings = this->m_searchSettings;
                     }
                 }
                 ImGui::EndDisabled();
@@ -746,9 +1070,14 @@ namespace hex::plugin::builtin {
             if (ImGui::InputTextWithHint("##filter", "hex.builtin.common.filter"_lang, this->m_currFilter[provider])) {
                 this->m_sortedOccurrences[provider] = this->m_foundOccurrences[provider];
 
-                currOccurrences.erase(std::remove_if(currOccurrences.begin(), currOccurrences.end(), [this, provider](const auto &region) {
-                    return !this->decodeValue(provider, region).contains(this->m_currFilter[provider]);
-                }), currOccurrences.end());
+                const auto values = this->decodeValues(provider, currOccurrences);
+
+                std::vector<Occurrence> filtered;
+                for (size_t i = 0; i < currOccurrences.size(); i++) {
+                    if (values[i].contains(this->m_currFilter[provider]))
+                        filtered.push_back(currOccurrences[i]);
+                }
+                currOccurrences = std::move(filtered);
             }
             ImGui::PopItemWidth();
 
@@ -760,8 +1089,29 @@ namespace hex::plugin::builtin {
 
                 auto sortSpecs = ImGui::TableGetSortSpecs();
 
+                if (sortSpecs->SpecsDirty && sortSpecs->Specs->ColumnUserID == ImGui::GetID("value")) {
+                    // Decode all values up front instead of reading them again for every comparison
+                    const auto values = this->decodeValues(provider, currOccurrences);
+
+                    std::vector<size_t> order(currOccurrences.size());
+                    std::iota(order.begin(), order.end(), 0);
+                    std::stable_sort(order.begin(), order.end(), [&](size_t left, size_t right) {
+                        if (sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending)
+                            return values[left] > values[right];
+                        else
+                            return values[left] < values[right];
+                    });
+
+                    std::vector<Occurrence> sorted;
+                    for (auto index : order)
+                        sorted.push_back(currOccurrences[index]);
+                    currOccurrences = std::move(sorted);
+
+                    sortSpecs->SpecsDirty = false;
+                }
+
                 if (sortSpecs->SpecsDirty) {
-                    std::sort(currOccurrences.begin(), currOccurrences.end(), [this, &sortSpecs, provider](Occurrence &left, Occurrence &right) -> bool {
+                    std::sort(currOccurrences.begin(), currOccurrences.end(), [&sortSpecs](Occurrence &left, Occurrence &right) -> bool {
                         if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("offset")) {
                             if (sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending)
                                 return left.region.getStartAddress() > right.region.getStartAddress();
@@ -772,11 +1122,6 @@ namespace hex::plugin::builtin {
                                 return left.region.getSize() > right.region.getSize();
                             else
                                 return left.region.getSize() < right.region.getSize();
-                        } else if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("value")) {
-                            if (sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending)
-                                return this->decodeValue(provider, left) > this->decodeValue(provider, right);
-                            else
-                                return this->decodeValue(provider, left) < this->decodeValue(provider, right);
                         }
 
                         return false;
@@ -791,7 +1136,10 @@ namespace hex::plugin::builtin {
                 clipper.Begin(currOccurrences.size(), ImGui::GetTextLineHeightWithSpacing());
 
                 while (clipper.Step()) {
-                    for (size_t i = clipper.DisplayStart; i < std::min<size_t>(clipper.DisplayEnd, currOccurrences.size()); i++) {
+                    const size_t displayEnd = std::min<size_t>(clipper.DisplayEnd, currOccurrences.size());
+                    const auto values = this->decodeValues(provider, std::span(currOccurrences).subspan(clipper.DisplayStart, displayEnd - clipper.DisplayStart));
+
+                    for (size_t i = clipper.DisplayStart; i < displayEnd; i++) {
                         auto &foundItem = currOccurrences[i];
 
                         ImGui::TableNextRow();
@@ -804,7 +1152,7 @@ namespace hex::plugin::builtin {
 
                         ImGui::PushID(i);
 
-                        auto value = this->decodeValue(provider, foundItem);
+                        const auto &value = values[i - clipper.DisplayStart];
                         ImGui::TextFormatted("{}", value);
                         ImGui::SameLine();
                         if (ImGui::Selectable("##line", false, ImGuiSelectableFlags_SpanAllColumns))
@@ -63,6 +63,7 @@ namespace hex::plugin::builtin {
 
 
     void ViewHashes::drawContent() {
+        hex::prv::IOStatistics::ScopedSubsystem ioSubsystem(hex::prv::IOSubsystem::Hashes);
         const auto &hashes = ContentRegistry::Hashes::impl::getHashes();
 
         if (this->m_selectedHash == nullptr && !hashes.empty()) {
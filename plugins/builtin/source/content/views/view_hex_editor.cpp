@@ -878,10 +878,19 @@ namespace hex::plugin::builtin {
 
                 ImGuiListClipper clipper;
 
+                std::vector<u8> visibleBytes;
+
                 clipper.Begin(std::ceil(provider->getSize() / (long double)(this->m_bytesPerRow)), CharacterSize.y);
                 while (clipper.Step()) {
                     this->m_visibleRowCount = clipper.DisplayEnd - clipper.DisplayStart;
 
+                    // Read all visible rows at once instead of issuing one read per row
+                    const u64 visibleStart = u64(clipper.DisplayStart) * this->m_bytesPerRow;
+                    const u64 visibleSize  = std::min<u64>(u64(clipper.DisplayEnd) * this->m_bytesPerRow, provider->getSize()) - std::min<u64>(visibleStart, provider->getSize());
+                    visibleBytes.resize(visibleSize);
+                    if (visibleSize > 0)
+                        provider->read(visibleStart + provider->getBaseAddress() + provider->getCurrentPageAddress(), visibleBytes.data(), visibleBytes.size());
+
                     // Loop over rows
                     for (u64 y = u64(clipper.DisplayStart); y < u64(clipper.DisplayEnd); y++) {
 
@@ -894,7 +903,7 @@ namespace hex::plugin::builtin {
                         const u8 validBytes = std::min<u64>(this->m_bytesPerRow, provider->getSize() - y * this->m_bytesPerRow);
 
                         std::vector<u8> bytes(this->m_bytesPerRow, 0x00);
-                        provider->read(y * this->m_bytesPerRow + provider->getBaseAddress() + provider->getCurrentPageAddress(), bytes.data(), validBytes);
+                        std::copy_n(visibleBytes.begin() + (y * this->m_bytesPerRow - visibleStart), validBytes, bytes.begin());
 
                         std::vector<std::tuple<std::optional<color_t>, std::optional<color_t>>> cellColors;
                         {
@@ -1277,6 +1286,7 @@ namespace hex::plugin::builtin {
     }
 
     void ViewHexEditor::drawContent() {
+        hex::prv::IOStatistics::ScopedSubsystem ioSubsystem(hex::prv::IOSubsystem::HexEditor);
 
         if (ImGui::Begin(View::toWindowName(this->getUnlocalizedName()).c_str(), &this->getWindowOpenState(), ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse)) {
             const auto FooterSize = ImVec2(ImGui::GetContentRegionAvail().x, ImGui::GetTextLineHeightWithSpacing() * 2.3);
@@ -1313,8 +1323,10 @@ namespace hex::plugin::builtin {
         std::string result;
         result.reserve(fmt::format(Format, 0x00).size() * selection.getSize());
 
-        for (const auto &byte : reader)
-            result += fmt::format(Format, byte);
+        for (const auto &chunk : reader.chunks()) {
+            for (const auto &byte : chunk.data)
+                result += fmt::format(Format, byte);
+        }
         result.pop_back();
 
         ImGui::SetClipboardText(result.c_str());
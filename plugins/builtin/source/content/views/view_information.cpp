@@ -21,7 +21,7 @@ namespace hex::plugin::builtin {
     using namespace hex::literals;
 
     ViewInformation::ViewInformation() : View("hex.builtin.view.information.name") {
-        EventManager::subscribe<EventDataChanged>(this, [this]() {
+        auto invalidateAnalysis = [this] {
             this->m_dataValid = false;
             this->m_highestBlockEntropy = 0;
             this->m_blockEntropy.clear();
@@ -31,6 +31,14 @@ namespace hex::plugin::builtin {
             this->m_dataMimeType.clear();
             this->m_dataDescription.clear();
             this->m_analyzedRegion  = { 0, 0 };
+        };
+
+        EventManager::subscribe<EventDataChanged>(this, invalidateAnalysis);
+
+        // Data that only got appended behind the analyzed region, e.g. by a followed file, doesn't affect the results
+        EventManager::subscribe<EventDataRangeChanged>(this, [this, invalidateAnalysis](prv::Provider *provider, Region region) {
+            if (provider == ImHexApi::Provider::get() && this->m_analyzedRegion.getSize() > 0 && region.overlaps(this->m_analyzedRegion))
+                invalidateAnalysis();
         });
 
         EventManager::subscribe<EventRegionSelected>(this, [this](Region region) {
@@ -56,6 +64,7 @@ namespace hex::plugin::builtin {
 
     ViewInformation::~ViewInformation() {
         EventManager::unsubscribe<EventDataChanged>(this);
+        EventManager::unsubscribe<EventDataRangeChanged>(this);
         EventManager::unsubscribe<EventRegionSelected>(this);
         EventManager::unsubscribe<EventProviderDeleted>(this);
     }
@@ -75,12 +84,13 @@ namespace hex::plugin::builtin {
     }
 
     void ViewInformation::analyze() {
-        this->m_analyzerTask = TaskManager::createTask("hex.builtin.view.information.analyzing", 0, [this](auto &task) {
-            auto provider = ImHexApi::Provider::get();
+        this->m_analyzerTask = TaskManager::createTask("hex.builtin.view.information.analyzing", 0, [this, snapshot = ImHexApi::Provider::get()->snapshot()](auto &task) {
+            hex::prv::IOStatistics::ScopedSubsystem ioSubsystem(hex::prv::IOSubsystem::Information);
+            auto provider = snapshot.getProvider();
 
-            task.setMaxValue(provider->getActualSize());
+            task.setMaxValue(snapshot.getActualSize());
 
-            this->m_analyzedRegion = { provider->getBaseAddress(), provider->getBaseAddress() + provider->getSize() };
+            this->m_analyzedRegion = { snapshot.getBaseAddress(), snapshot.getActualSize() };
 
             {
                 magic::compile();
@@ -92,29 +102,60 @@ namespace hex::plugin::builtin {
             this->m_dataValid = true;
 
             {
-                this->m_blockSize = std::max<u32>(std::ceil(provider->getActualSize() / 2048.0F), 256);
+                this->m_blockSize = std::max<u32>(std::ceil(snapshot.getActualSize() / 2048.0F), 256);
 
                 std::array<ImU64, 256> blockValueCounts = { 0 };
 
                 this->m_blockEntropy.clear();
                 this->m_valueCounts.fill(0);
 
-                auto reader = prv::BufferedReader(provider);
+                auto reader = prv::BufferedReader(snapshot);
 
                 u64 count = 0;
-                for (u8 byte : reader) {
-                    this->m_valueCounts[byte]++;
-                    blockValueCounts[byte]++;
-
-                    count++;
-                    if ((count % this->m_blockSize) == 0) [[unlikely]] {
-                        this->m_blockEntropy.push_back(calculateEntropy(blockValueCounts, this->m_blockSize));
-                        blockValueCounts = { 0 };
-                        task.update(count);
+
+                // Holes in sparse data are accounted for without reading them
+                auto addZeros = [&](u64 zeroCount) {
+                    while (zeroCount > 0) {
+                        const auto size = std::min<u64>(zeroCount, this->m_blockSize - (count % this->m_blockSize));
+
+                        this->m_valueCounts[0] += size;
+                        blockValueCounts[0] += size;
+
+                        count     += size;
+                        zeroCount -= size;
+                        if ((count % this->m_blockSize) == 0) {
+                            this->m_blockEntropy.push_back(calculateEntropy(blockValueCounts, this->m_blockSize));
+                            blockValueCounts = { 0 };
+                            task.update(count);
+                        }
                     }
+                };
+
+                u64 address = snapshot.getBaseAddress();
+                for (const auto &region : snapshot.getDataRegions(snapshot.getBaseAddress(), snapshot.getActualSize())) {
+                    addZeros(region.getStartAddress() - address);
+
+                    reader.seek(region.getStartAddress());
+                    reader.setEndAddress(region.getEndAddress());
+                    for (const auto &chunk : reader.chunks()) {
+                        for (u8 byte : chunk.data) {
+                            this->m_valueCounts[byte]++;
+                            blockValueCounts[byte]++;
+
+                            count++;
+                            if ((count % this->m_blockSize) == 0) [[unlikely]] {
+                                this->m_blockEntropy.push_back(calculateEntropy(blockValueCounts, this->m_blockSize));
+                                blockValueCounts = { 0 };
+                                task.update(count);
+                            }
+                        }
+                    }
+
+                    address = region.getStartAddress() + region.getSize();
                 }
+                addZeros(snapshot.getBaseAddress() + snapshot.getActualSize() - address);
 
-                this->m_averageEntropy = calculateEntropy(this->m_valueCounts, provider->getSize());
+                this->m_averageEntropy = calculateEntropy(this->m_valueCounts, snapshot.getActualSize());
                 if (!this->m_blockEntropy.empty())
                     this->m_highestBlockEntropy = *std::max_element(this->m_blockEntropy.begin(), this->m_blockEntropy.end());
                 else
@@ -0,0 +1,118 @@
+#include "content/views/view_io_diagnostics.hpp"
+
+#include <hex/providers/provider.hpp>
+#include <hex/helpers/utils.hpp>
+
+#include <array>
+#include <cfloat>
+
+namespace hex::plugin::builtin {
+
+    namespace {
+
+        constexpr std::array SubsystemNames = {
+            "hex.builtin.view.io_diagnostics.subsystem.other",
+            "hex.builtin.view.io_diagnostics.subsystem.hex_editor",
+            "hex.builtin.view.io_diagnostics.subsystem.data_inspector",
+            "hex.builtin.view.io_diagnostics.subsystem.find",
+            "hex.builtin.view.io_diagnostics.subsystem.hashes",
+            "hex.builtin.view.io_diagnostics.subsystem.information",
+            "hex.builtin.view.io_diagnostics.subsystem.pattern_language",
+            "hex.builtin.view.io_diagnostics.subsystem.yara"
+        };
+
+        static_assert(SubsystemNames.size() == size_t(hex::prv::IOSubsystem::Count), "Subsystem names don't match the IOSubsystem enum");
+
+        std::string formatLatency(std::chrono::nanoseconds totalTime, u64 calls) {
+            if (calls == 0)
+                return "-";
+
+            return hex::format("{:.2f} us", (double(totalTime.count()) / calls) / 1000.0);
+        }
+
+        void drawCountersRow(const char *name, const hex::prv::IOStatistics::Counters &counters) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name);
+            ImGui::TableNextColumn();
+            ImGui::TextFormatted("{}", counters.readCalls);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(hex::toByteString(counters.bytesRead).c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(formatLatency(counters.readTime, counters.readCalls).c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextFormatted("{}", counters.writeCalls);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(hex::toByteString(counters.bytesWritten).c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(formatLatency(counters.writeTime, counters.writeCalls).c_str());
+        }
+
+    }
+
+    ViewIODiagnostics::ViewIODiagnostics() : View("hex.builtin.view.io_diagnostics.name") {
+
+    }
+
+    void ViewIODiagnostics::drawContent() {
+        if (ImGui::Begin(View::toWindowName("hex.builtin.view.io_diagnostics.name").c_str(), &this->getWindowOpenState(), ImGuiWindowFlags_NoCollapse)) {
+            if (ImHexApi::Provider::isValid()) {
+                auto &statistics = ImHexApi::Provider::get()->getIOStatistics();
+
+                if (ImGui::Button("hex.builtin.view.io_diagnostics.reset"_lang))
+                    statistics.reset();
+
+                ImGui::SameLine();
+                {
+                    const auto hits   = statistics.getCacheHits();
+                    const auto misses = statistics.getCacheMisses();
+
+                    if (hits + misses == 0)
+                        ImGui::TextFormatted("{}: -", static_cast<const char *>("hex.builtin.view.io_diagnostics.cache"_lang));
+                    else
+                        ImGui::TextFormatted("{}: {} / {} ({:.1f}%)", static_cast<const char *>("hex.builtin.view.io_diagnostics.cache"_lang), hits, misses, (100.0 * hits) / (hits + misses));
+                }
+
+                ImGui::NewLine();
+
+                if (ImGui::BeginTable("##io_counters", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp)) {
+                    ImGui::TableSetupColumn("hex.builtin.view.io_diagnostics.subsystem"_lang);
+                    ImGui::TableSetupColumn("hex.builtin.view.io_diagnostics.reads"_lang);
+                    ImGui::TableSetupColumn("hex.builtin.view.io_diagnostics.bytes_read"_lang);
+                    ImGui::TableSetupColumn("hex.builtin.view.io_diagnostics.read_latency"_lang);
+                    ImGui::TableSetupColumn("hex.builtin.view.io_diagnostics.writes"_lang);
+                    ImGui::TableSetupColumn("hex.builtin.view.io_diagnostics.bytes_written"_lang);
+                    ImGui::TableSetupColumn("hex.builtin.view.io_diagnostics.write_latency"_lang);
+                    ImGui::TableHeadersRow();
+
+                    for (size_t i = 0; i < SubsystemNames.size(); i++) {
+                        auto counters = statistics.getCounters(hex::prv::IOSubsystem(i));
+                        if (counters.readCalls == 0 && counters.writeCalls == 0)
+                            continue;
+
+                        drawCountersRow(LangEntry(SubsystemNames[i]), counters);
+                    }
+
+                    drawCountersRow("hex.builtin.view.io_diagnostics.total"_lang, statistics.getTotalCounters());
+
+                    ImGui::EndTable();
+                }
+
+                ImGui::NewLine();
+                ImGui::TextUnformatted("hex.builtin.view.io_diagnostics.latency_histogram"_lang);
+
+                {
+                    auto histogram = statistics.getLatencyHistogram();
+
+                    std::array<float, hex::prv::IOStatistics::LatencyBucketCount> values = { };
+                    for (size_t i = 0; i < histogram.size(); i++)
+                        values[i] = float(histogram[i]);
+
+                    ImGui::PlotHistogram("##latency_histogram", values.data(), values.size(), 0, "< 1 us ... > 4 s", 0.0F, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 100_scaled));
+                }
+            }
+        }
+        ImGui::End();
+    }
+
+}
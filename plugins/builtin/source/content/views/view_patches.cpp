@@ -6,11 +6,14 @@
 #include <nlohmann/json.hpp>
 
 #include <string>
+#include <vector>
 
 using namespace std::literals::string_literals;
 
 namespace hex::plugin::builtin {
 
+    constexpr static auto MaxDisplayedBytes = 8;
+
     ViewPatches::ViewPatches() : View("hex.builtin.view.patches.name") {
 
         ProjectFile::registerPerProviderHandler({
@@ -18,12 +21,28 @@ namespace hex::plugin::builtin {
             .required = false,
             .load = [](prv::Provider *provider, const std::fs::path &basePath, Tar &tar) {
                 auto json = nlohmann::json::parse(tar.read(basePath));
-                provider->getPatches() = json["patches"].get<std::map<u64, u8>>();
+
+                auto &patches = provider->getPatches();
+                patches.clear();
+
+                // Older project files store a single byte per patch instead of a run of bytes
+                for (const auto &patch : json["patches"]) {
+                    auto address = patch[0].get<u64>();
+
+                    if (patch[1].is_array()) {
+                        auto bytes = patch[1].get<std::vector<u8>>();
+                        patches.write(address, bytes.data(), bytes.size());
+                    } else {
+                        auto value = patch[1].get<u8>();
+                        patches.write(address, &value, sizeof(value));
+                    }
+                }
+
                 return true;
             },
             .store = [](prv::Provider *provider, const std::fs::path &basePath, Tar &tar) {
                 nlohmann::json json;
-                json["patches"] = provider->getPatches();
+                json["patches"] = provider->getPatches().getRuns();
                 tar.write(basePath, json.dump(4));
 
                 return true;
@@ -41,8 +60,8 @@ namespace hex::plugin::builtin {
             u8 byte = 0x00;
             provider->readRaw(offset, &byte, sizeof(u8));
 
-            const auto &patches = provider->getPatches();
-            if (patches.contains(offset) && patches.at(offset) != byte)
+            auto patch = provider->getPatches().get(offset);
+            if (patch.has_value() && *patch != byte)
                 return ImGui::GetCustomColorU32(ImGuiCustomCol_ToolbarRed);
             else
                 return std::nullopt;
@@ -64,13 +83,14 @@ namespace hex::plugin::builtin {
                     ImGui::TableHeadersRow();
 
                     auto &patches = provider->getPatches();
+                    const auto &runs = patches.getRuns();
                     u32 index     = 0;
 
                     ImGuiListClipper clipper;
 
-                    clipper.Begin(patches.size());
+                    clipper.Begin(runs.size());
                     while (clipper.Step()) {
-                        auto iter = patches.begin();
+                        auto iter = runs.begin();
                         for (auto i = 0; i < clipper.DisplayStart; i++)
                             iter++;
 
@@ -81,22 +101,24 @@ namespace hex::plugin::builtin {
                             ImGui::TableNextColumn();
 
                             if (ImGui::Selectable(("##patchLine" + std::to_string(index)).c_str(), false, ImGuiSelectableFlags_SpanAllColumns)) {
-                                ImHexApi::HexEditor::setSelection(address, 1);
+                                ImHexApi::HexEditor::setSelection(address, patch.size());
                             }
                             if (ImGui::IsMouseReleased(1) && ImGui::IsItemHovered()) {
                                 ImGui::OpenPopup("PatchContextMenu");
-                                this->m_selectedPatch = address;
+                                this->m_selectedPatch = { address, patch.size() };
                             }
                             ImGui::SameLine();
                             ImGui::TextFormatted("0x{0:08X}", address);
 
+                            const auto displayedSize = std::min<size_t>(patch.size(), MaxDisplayedBytes);
+
                             ImGui::TableNextColumn();
-                            u8 previousValue = 0x00;
-                            provider->readRaw(address, &previousValue, sizeof(u8));
-                            ImGui::TextFormatted("0x{0:02X}", previousValue);
+                            std::vector<u8> previousValue(displayedSize);
+                            provider->readRaw(address, previousValue.data(), previousValue.size());
+                            ImGui::TextFormatted("{}{}", hex::encodeByteString(previousValue), patch.size() > displayedSize ? " ..." : "");
 
                             ImGui::TableNextColumn();
-                            ImGui::TextFormatted("0x{0:02X}", patch);
+                            ImGui::TextFormatted("{}{}", hex::encodeByteString({ patch.begin(), patch.begin() + displayedSize }), patch.size() > displayedSize ? " ..." : "");
                             index += 1;
 
                             iter++;
@@ -105,7 +127,7 @@ namespace hex::plugin::builtin {
 
                     if (ImGui::BeginPopup("PatchContextMenu")) {
                         if (ImGui::MenuItem("hex.builtin.view.patches.remove"_lang)) {
-                            patches.erase(this->m_selectedPatch);
+                            patches.erase(this->m_selectedPatch.getStartAddress(), this->m_selectedPatch.getSize());
                         }
                         ImGui::EndPopup();
                     }
@@ -831,6 +831,7 @@ namespace hex::plugin::builtin {
         EventManager::post<EventHighlightingChanged>();
 
         TaskManager::createTask("hex.builtin.view.pattern_editor.evaluating", TaskManager::NoProgress, [this, &patternLanguage, code](auto &task) {
+            hex::prv::IOStatistics::ScopedSubsystem ioSubsystem(hex::prv::IOSubsystem::PatternLanguage);
             std::scoped_lock lock(patternLanguage.runtimeMutex);
             auto &runtime = patternLanguage.runtime;
 
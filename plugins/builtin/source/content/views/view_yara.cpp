@@ -173,8 +173,10 @@ namespace hex::plugin::builtin {
     void ViewYara::applyRules() {
         this->clearResult();
 
-        this->m_matcherTask = TaskManager::createTask("hex.builtin.view.yara.matching", 0, [this](auto &task) {
-            if (!ImHexApi::Provider::isValid()) return;
+        if (!ImHexApi::Provider::isValid()) return;
+
+        this->m_matcherTask = TaskManager::createTask("hex.builtin.view.yara.matching", 0, [this, snapshot = ImHexApi::Provider::get()->snapshot()](auto &task) {
+            hex::prv::IOStatistics::ScopedSubsystem ioSubsystem(hex::prv::IOSubsystem::Yara);
 
             YR_COMPILER *compiler = nullptr;
             yr_compiler_create(&compiler);
@@ -231,31 +233,45 @@ namespace hex::plugin::builtin {
 
             struct ScanContext {
                 Task *task = nullptr;
+                const hex::prv::ProviderSnapshot *snapshot = nullptr;
                 std::vector<u8> buffer;
                 YR_MEMORY_BLOCK currBlock = {};
             };
 
             ScanContext context;
             context.task                 = &task;
+            context.snapshot             = &snapshot;
             context.currBlock.base       = 0;
+
+            // Holes in sparse data are never read, they're left as zeros in the buffer. Everything is still passed to YARA as a
+            // single block so rules see exactly the same bytes and offsets as without holes
             context.currBlock.fetch_data = [](auto *block) -> const u8 * {
                 auto &context = *static_cast<ScanContext *>(block->context);
-                auto provider = ImHexApi::Provider::get();
+                const auto &snapshot = *context.snapshot;
 
-                context.buffer.resize(context.currBlock.size);
+                context.buffer.assign(context.currBlock.size, 0x00);
 
                 if (context.buffer.empty())
                     return nullptr;
 
                 block->size = context.currBlock.size;
-                provider->read(context.currBlock.base + provider->getBaseAddress(), context.buffer.data(), context.buffer.size());
+
+                const u64 blockAddress = context.currBlock.base + snapshot.getBaseAddress();
+                for (const auto &region : snapshot.getDataRegions(blockAddress, context.currBlock.size)) {
+                    const u64 start = std::max(region.getStartAddress(), blockAddress);
+                    const u64 end   = std::min(region.getEndAddress() + 1, blockAddress + context.currBlock.size);
+                    if (start >= end)
+                        continue;
+
+                    snapshot.readSequential(start, context.buffer.data() + (start - blockAddress), end - start);
+                }
 
                 return context.buffer.data();
             };
             iterator.file_size = [](auto *iterator) -> u64 {
-                hex::unused(iterator);
+                auto &context = *static_cast<ScanContext *>(iterator->context);
 
-                return ImHexApi::Provider::get()->getActualSize();
+                return context.snapshot->getActualSize();
             };
 
             iterator.context = &context;
@@ -276,7 +292,7 @@ namespace hex::plugin::builtin {
 
                 iterator->last_error      = ERROR_SUCCESS;
                 context.currBlock.base    = address;
-                context.currBlock.size    = ImHexApi::Provider::get()->getActualSize() - address;
+                context.currBlock.size    = context.snapshot->getActualSize() - address;
                 context.currBlock.context = &context;
                 context.task->update(address);
 
@@ -109,6 +109,8 @@ namespace hex::plugin::builtin {
                 { "hex.builtin.common.encoding.utf16le", "UTF-16LE" },
                 { "hex.builtin.common.encoding.utf16be", "UTF-16BE" },
                 { "hex.builtin.common.encoding.utf8", "UTF-8" },
+                { "hex.builtin.common.encoding.utf32le", "UTF-32LE" },
+                { "hex.builtin.common.encoding.utf32be", "UTF-32BE" },
 
                 { "hex.builtin.popup.exit_application.title", "Applikation verlassen?" },
                 { "hex.builtin.popup.exit_application.desc", "Es wurden ungespeicherte Änderungen an diesem Projekt vorgenommen.\nBist du sicher, dass du ImHex schliessen willst?" },
@@ -143,6 +145,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.menu.file.open_other", "Provider öffnen..." },
                     { "hex.builtin.menu.file.close", "Schliessen" },
                     { "hex.builtin.menu.file.reload_file", "Datei neu laden" },
+                    { "hex.builtin.menu.file.follow_file", "Dateiänderungen folgen" },
                     { "hex.builtin.menu.file.quit", "ImHex Beenden" },
                     { "hex.builtin.menu.file.open_project", "Projekt öffnen..." },
                     { "hex.builtin.menu.file.save_project", "Projekt speichern..." },
@@ -454,7 +457,12 @@ namespace hex::plugin::builtin {
                         { "hex.builtin.view.find.strings.symbols", "Symbole" },
                         { "hex.builtin.view.find.strings.spaces", "Leerzeichen" },
                         { "hex.builtin.view.find.strings.line_feeds", "Line Feeds" },
+                        { "hex.builtin.view.find.strings.all_encodings", "Alle Kodierungen" },
                     { "hex.builtin.view.find.sequences", "Sequenzen" },
+                    { "hex.builtin.view.find.sequence_list", "Sequenzliste" },
+                        { "hex.builtin.view.find.sequence_list.sequences", "Sequenzen, eine pro Zeile" },
+                        { "hex.builtin.view.find.sequence_list.load", "Aus Datei laden" },
+                        { "hex.builtin.view.find.sequence_list.count", "{} Sequenzen" },
                     { "hex.builtin.view.find.regex", "Regex" },
                         { "hex.builtin.view.find.regex.pattern", "Pattern" },
                         { "hex.builtin.view.find.regex.full_match", "Benötige volle übereinstimmung" },
@@ -468,6 +476,27 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.find.search.entries", "{} Einträge gefunden" },
                     { "hex.builtin.view.find.search.reset", "Zurücksetzen" },
 
+                //{ "hex.builtin.view.io_diagnostics.name", "I/O Diagnostics" },
+                    //{ "hex.builtin.view.io_diagnostics.reset", "Reset" },
+                    //{ "hex.builtin.view.io_diagnostics.cache", "Cache hits / misses" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem", "Subsystem" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.other", "Other" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.hex_editor", "Hex Editor" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.data_inspector", "Data Inspector" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.find", "Find" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.hashes", "Hashes" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.information", "Information" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.pattern_language", "Pattern Language" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.yara", "YARA" },
+                    //{ "hex.builtin.view.io_diagnostics.reads", "Reads" },
+                    //{ "hex.builtin.view.io_diagnostics.bytes_read", "Bytes read" },
+                    //{ "hex.builtin.view.io_diagnostics.read_latency", "Avg. read latency" },
+                    //{ "hex.builtin.view.io_diagnostics.writes", "Writes" },
+                    //{ "hex.builtin.view.io_diagnostics.bytes_written", "Bytes written" },
+                    //{ "hex.builtin.view.io_diagnostics.write_latency", "Avg. write latency" },
+                    //{ "hex.builtin.view.io_diagnostics.total", "Total" },
+                    //{ "hex.builtin.view.io_diagnostics.latency_histogram", "Latency histogram" },
+
                 { "hex.builtin.command.calc.desc", "Rechner" },
                 { "hex.builtin.command.cmd.desc", "Command" },
                 { "hex.builtin.command.cmd.result", "Command '{0}' ausführen" },
@@ -791,6 +820,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.setting.hex_editor.sync_scrolling", "Editorposition synchronisieren" },
                     { "hex.builtin.setting.hex_editor.byte_padding", "Extra Byte-Zellenabstand" },
                     { "hex.builtin.setting.hex_editor.char_padding", "Extra Character-Zellenabstand" },
+                    { "hex.builtin.setting.hex_editor.undo_history_limit", "Speicherlimit für Rückgängig-Verlauf" },
                 { "hex.builtin.setting.folders", "Ordner" },
                     { "hex.builtin.setting.folders.description", "Gib zusätzliche Orderpfade an in welchen Pattern, Scripts, Yara Rules und anderes gesucht wird" },
                     { "hex.builtin.setting.folders.add_folder", "Neuer Ordner hinzufügen" },
@@ -815,15 +845,34 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.provider.gdb.server", "Server" },
                     { "hex.builtin.provider.gdb.ip", "IP Adresse" },
                     { "hex.builtin.provider.gdb.port", "Port" },
+                    { "hex.builtin.provider.gdb.cache_size", "Cachegrösse" },
+                    { "hex.builtin.provider.gdb.auto_refresh", "Gecachten Speicher periodisch aktualisieren" },
+                    { "hex.builtin.provider.gdb.invalidate_cache", "Cache leeren" },
                 { "hex.builtin.provider.disk", "Datenträger Provider" },
                     { "hex.builtin.provider.disk.selected_disk", "Datenträger" },
                     { "hex.builtin.provider.disk.disk_size", "Datenträgergrösse" },
                     { "hex.builtin.provider.disk.sector_size", "Sektorgrösse" },
                     { "hex.builtin.provider.disk.reload", "Neu laden" },
+                    { "hex.builtin.provider.disk.direct_io", "Systemcache umgehen (Direct I/O)" },
                 { "hex.builtin.provider.intel_hex", "Intel Hex Provider" },
                     { "hex.builtin.provider.intel_hex.name", "Intel Hex {0}" },
                 { "hex.builtin.provider.motorola_srec", "Motorola SREC Provider" },
                     { "hex.builtin.provider.motorola_srec.name", "Motorola SREC {0}" },
+                { "hex.builtin.provider.compressed_file", "Komprimierte Datei Provider" },
+                    { "hex.builtin.provider.compressed_file.name", "Komprimierte Datei {0}" },
+                    { "hex.builtin.provider.compressed_file.format", "Kompressionsformat" },
+                    { "hex.builtin.provider.compressed_file.compressed_size", "Komprimierte Grösse" },
+                    { "hex.builtin.provider.compressed_file.checkpoints", "Checkpoints" },
+                { "hex.builtin.provider.process_memory", "Prozessspeicher Provider" },
+                    { "hex.builtin.provider.process_memory.name", "Prozess {0} <{1}>" },
+                    { "hex.builtin.provider.process_memory.process", "Prozess" },
+                    { "hex.builtin.provider.process_memory.pid", "Prozess ID" },
+                    { "hex.builtin.provider.process_memory.process_name", "Prozessname" },
+                    { "hex.builtin.provider.process_memory.reload", "Neu laden" },
+                    { "hex.builtin.provider.process_memory.snapshot", "Speicher beim Öffnen kopieren" },
+                    { "hex.builtin.provider.process_memory.reload_mappings", "Speicherbelegung neu laden" },
+                    { "hex.builtin.provider.process_memory.mappings", "Mappings" },
+                    { "hex.builtin.provider.process_memory.mapped_size", "Gemappte Grösse" },
 
                 { "hex.builtin.layouts.default", "Standard" },
 
@@ -110,6 +110,8 @@ namespace hex::plugin::builtin {
                 { "hex.builtin.common.encoding.utf16le", "UTF-16LE" },
                 { "hex.builtin.common.encoding.utf16be", "UTF-16BE" },
                 { "hex.builtin.common.encoding.utf8", "UTF-8" },
+                { "hex.builtin.common.encoding.utf32le", "UTF-32LE" },
+                { "hex.builtin.common.encoding.utf32be", "UTF-32BE" },
 
                 { "hex.builtin.popup.exit_application.title", "Exit Application?" },
                 { "hex.builtin.popup.exit_application.desc", "You have unsaved changes made to your Project.\nAre you sure you want to exit?" },
@@ -145,6 +147,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.menu.file.open_other", "Open Other..." },
                     { "hex.builtin.menu.file.close", "Close" },
                     { "hex.builtin.menu.file.reload_file", "Reload File" },
+                    { "hex.builtin.menu.file.follow_file", "Follow File Changes" },
                     { "hex.builtin.menu.file.quit", "Quit ImHex" },
                     { "hex.builtin.menu.file.open_project", "Open Project..." },
                     { "hex.builtin.menu.file.save_project", "Save Project..." },
@@ -458,7 +461,12 @@ namespace hex::plugin::builtin {
                         { "hex.builtin.view.find.strings.symbols", "Symbols" },
                         { "hex.builtin.view.find.strings.spaces", "Spaces" },
                         { "hex.builtin.view.find.strings.line_feeds", "Line Feeds" },
+                        { "hex.builtin.view.find.strings.all_encodings", "All encodings" },
                     { "hex.builtin.view.find.sequences", "Sequences" },
+                    { "hex.builtin.view.find.sequence_list", "Sequence list" },
+                        { "hex.builtin.view.find.sequence_list.sequences", "Sequences, one per line" },
+                        { "hex.builtin.view.find.sequence_list.load", "Load from file" },
+                        { "hex.builtin.view.find.sequence_list.count", "{} sequences" },
                     { "hex.builtin.view.find.regex", "Regex" },
                         { "hex.builtin.view.find.regex.pattern", "Pattern" },
                         { "hex.builtin.view.find.regex.full_match", "Require full match" },
@@ -472,6 +480,27 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.find.search.entries", "{} entries found" },
                     { "hex.builtin.view.find.search.reset", "Reset" },
 
+                { "hex.builtin.view.io_diagnostics.name", "I/O Diagnostics" },
+                    { "hex.builtin.view.io_diagnostics.reset", "Reset" },
+                    { "hex.builtin.view.io_diagnostics.cache", "Cache hits / misses" },
+                    { "hex.builtin.view.io_diagnostics.subsystem", "Subsystem" },
+                    { "hex.builtin.view.io_diagnostics.subsystem.other", "Other" },
+                    { "hex.builtin.view.io_diagnostics.subsystem.hex_editor", "Hex Editor" },
+                    { "hex.builtin.view.io_diagnostics.subsystem.data_inspector", "Data Inspector" },
+                    { "hex.builtin.view.io_diagnostics.subsystem.find", "Find" },
+                    { "hex.builtin.view.io_diagnostics.subsystem.hashes", "Hashes" },
+                    { "hex.builtin.view.io_diagnostics.subsystem.information", "Information" },
+                    { "hex.builtin.view.io_diagnostics.subsystem.pattern_language", "Pattern Language" },
+                    { "hex.builtin.view.io_diagnostics.subsystem.yara", "YARA" },
+                    { "hex.builtin.view.io_diagnostics.reads", "Reads" },
+                    { "hex.builtin.view.io_diagnostics.bytes_read", "Bytes read" },
+                    { "hex.builtin.view.io_diagnostics.read_latency", "Avg. read latency" },
+                    { "hex.builtin.view.io_diagnostics.writes", "Writes" },
+                    { "hex.builtin.view.io_diagnostics.bytes_written", "Bytes written" },
+                    { "hex.builtin.view.io_diagnostics.write_latency", "Avg. write latency" },
+                    { "hex.builtin.view.io_diagnostics.total", "Total" },
+                    { "hex.builtin.view.io_diagnostics.latency_histogram", "Latency histogram" },
+
 
                 { "hex.builtin.command.calc.desc", "Calculator" },
                 { "hex.builtin.command.cmd.desc", "Command" },
@@ -795,6 +824,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.setting.hex_editor.sync_scrolling", "Synchronize editor position" },
                     { "hex.builtin.setting.hex_editor.byte_padding", "Extra byte cell padding" },
                     { "hex.builtin.setting.hex_editor.char_padding", "Extra character cell padding" },
+                    { "hex.builtin.setting.hex_editor.undo_history_limit", "Undo history memory limit" },
                 { "hex.builtin.setting.folders", "Folders" },
                     { "hex.builtin.setting.folders.description", "Specify additional search paths for patterns, scripts, Yara rules and more" },
                     { "hex.builtin.setting.folders.add_folder", "Add new folder" },
@@ -819,15 +849,34 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.provider.gdb.server", "Server" },
                     { "hex.builtin.provider.gdb.ip", "IP Address" },
                     { "hex.builtin.provider.gdb.port", "Port" },
+                    { "hex.builtin.provider.gdb.cache_size", "Cache size" },
+                    { "hex.builtin.provider.gdb.auto_refresh", "Refresh cached memory periodically" },
+                    { "hex.builtin.provider.gdb.invalidate_cache", "Invalidate cache" },
                 { "hex.builtin.provider.disk", "Raw Disk Provider" },
                     { "hex.builtin.provider.disk.selected_disk", "Disk" },
                     { "hex.builtin.provider.disk.disk_size", "Disk Size" },
                     { "hex.builtin.provider.disk.sector_size", "Sector Size" },
                     { "hex.builtin.provider.disk.reload", "Reload" },
+                    { "hex.builtin.provider.disk.direct_io", "Bypass the system cache (direct I/O)" },
                 { "hex.builtin.provider.intel_hex", "Intel Hex Provider" },
                     { "hex.builtin.provider.intel_hex.name", "Intel Hex {0}" },
                 { "hex.builtin.provider.motorola_srec", "Motorola SREC Provider" },
                     { "hex.builtin.provider.motorola_srec.name", "Motorola SREC {0}" },
+                { "hex.builtin.provider.compressed_file", "Compressed File Provider" },
+                    { "hex.builtin.provider.compressed_file.name", "Compressed File {0}" },
+                    { "hex.builtin.provider.compressed_file.format", "Compression format" },
+                    { "hex.builtin.provider.compressed_file.compressed_size", "Compressed size" },
+                    { "hex.builtin.provider.compressed_file.checkpoints", "Checkpoints" },
+                { "hex.builtin.provider.process_memory", "Process Memory Provider" },
+                    { "hex.builtin.provider.process_memory.name", "Process {0} <{1}>" },
+                    { "hex.builtin.provider.process_memory.process", "Process" },
+                    { "hex.builtin.provider.process_memory.pid", "Process ID" },
+                    { "hex.builtin.provider.process_memory.process_name", "Process name" },
+                    { "hex.builtin.provider.process_memory.reload", "Reload" },
+                    { "hex.builtin.provider.process_memory.snapshot", "Snapshot memory when opening" },
+                    { "hex.builtin.provider.process_memory.reload_mappings", "Reload memory map" },
+                    { "hex.builtin.provider.process_memory.mappings", "Mappings" },
+                    { "hex.builtin.provider.process_memory.mapped_size", "Mapped size" },
 
                 { "hex.builtin.layouts.default", "Default" },
 
@@ -109,6 +109,8 @@ namespace hex::plugin::builtin {
                 { "hex.builtin.common.encoding.utf16le", "UTF-16LE" },
                 { "hex.builtin.common.encoding.utf16be", "UTF-16BE" },
                 { "hex.builtin.common.encoding.utf8", "UTF-8" },
+                { "hex.builtin.common.encoding.utf32le", "UTF-32LE" },
+                { "hex.builtin.common.encoding.utf32be", "UTF-32BE" },
 
                 { "hex.builtin.popup.exit_application.title", "프로그램을 종료하시겠습니까?" },
                 { "hex.builtin.popup.exit_application.desc", "프로젝트에 저장하지 않은 내용이 있습니다.\n정말로 종료하시겠습니까?" },
@@ -144,6 +146,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.menu.file.open_other", "다른 공급자 열기..." },
                     { "hex.builtin.menu.file.close", "닫기" },
                     //{ "hex.builtin.menu.file.reload_file", "Reload File" },
+                    //{ "hex.builtin.menu.file.follow_file", "Follow File Changes" },
                     { "hex.builtin.menu.file.quit", "ImHex 종료하기" },
                     { "hex.builtin.menu.file.open_project", "프로젝트 열기..." },
                     { "hex.builtin.menu.file.save_project", "프로젝트 저장..." },
@@ -457,7 +460,12 @@ namespace hex::plugin::builtin {
                         { "hex.builtin.view.find.strings.symbols", "특수 문자" },
                         { "hex.builtin.view.find.strings.spaces", "공백 문자" },
                         { "hex.builtin.view.find.strings.line_feeds", "라인 피드" },
+                //        { "hex.builtin.view.find.strings.all_encodings", "All encodings" },
                     { "hex.builtin.view.find.sequences", "텍스트 시퀸스" },
+                //    { "hex.builtin.view.find.sequence_list", "Sequence list" },
+                //        { "hex.builtin.view.find.sequence_list.sequences", "Sequences, one per line" },
+                //        { "hex.builtin.view.find.sequence_list.load", "Load from file" },
+                //        { "hex.builtin.view.find.sequence_list.count", "{} sequences" },
                     { "hex.builtin.view.find.regex", "정규식" },
                         // { "hex.builtin.view.find.regex.pattern", "Pattern" },
                         // { "hex.builtin.view.find.regex.full_match", "Require full match" },
@@ -471,6 +479,27 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.find.search.entries", "{} 개 검색됨" },
                     // { "hex.builtin.view.find.search.reset", "Reset" },
 
+                //{ "hex.builtin.view.io_diagnostics.name", "I/O Diagnostics" },
+                    //{ "hex.builtin.view.io_diagnostics.reset", "Reset" },
+                    //{ "hex.builtin.view.io_diagnostics.cache", "Cache hits / misses" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem", "Subsystem" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.other", "Other" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.hex_editor", "Hex Editor" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.data_inspector", "Data Inspector" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.find", "Find" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.hashes", "Hashes" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.information", "Information" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.pattern_language", "Pattern Language" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.yara", "YARA" },
+                    //{ "hex.builtin.view.io_diagnostics.reads", "Reads" },
+                    //{ "hex.builtin.view.io_diagnostics.bytes_read", "Bytes read" },
+                    //{ "hex.builtin.view.io_diagnostics.read_latency", "Avg. read latency" },
+                    //{ "hex.builtin.view.io_diagnostics.writes", "Writes" },
+                    //{ "hex.builtin.view.io_diagnostics.bytes_written", "Bytes written" },
+                    //{ "hex.builtin.view.io_diagnostics.write_latency", "Avg. write latency" },
+                    //{ "hex.builtin.view.io_diagnostics.total", "Total" },
+                    //{ "hex.builtin.view.io_diagnostics.latency_histogram", "Latency histogram" },
+
 
                 { "hex.builtin.command.calc.desc", "계산기" },
                 { "hex.builtin.command.cmd.desc", "명령" },
@@ -794,6 +823,7 @@ namespace hex::plugin::builtin {
                     //{ "hex.builtin.setting.hex_editor.sync_scrolling", "Synchronize editor position" },
                     //{ "hex.builtin.setting.hex_editor.byte_padding", "Extra byte cell padding" },
                     //{ "hex.builtin.setting.hex_editor.char_padding", "Extra character cell padding" },
+                    //{ "hex.builtin.setting.hex_editor.undo_history_limit", "Undo history memory limit" },
                 { "hex.builtin.setting.folders", "폴더" },
                     { "hex.builtin.setting.folders.description", "패턴, 스크립트, YARA 규칙 등을 찾아볼 추가적인 폴더 경로를 지정하세요" },
                     { "hex.builtin.setting.folders.add_folder", "새 폴더 추가" },
@@ -818,15 +848,34 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.provider.gdb.server", "서버" },
                     { "hex.builtin.provider.gdb.ip", "IP 주소" },
                     { "hex.builtin.provider.gdb.port", "포트" },
+                    //{ "hex.builtin.provider.gdb.cache_size", "Cache size" },
+                    //{ "hex.builtin.provider.gdb.auto_refresh", "Refresh cached memory periodically" },
+                    //{ "hex.builtin.provider.gdb.invalidate_cache", "Invalidate cache" },
                 { "hex.builtin.provider.disk", "Raw 디스크 공급자" },
                     { "hex.builtin.provider.disk.selected_disk", "디스크" },
                     { "hex.builtin.provider.disk.disk_size", "디스크 크기" },
                     { "hex.builtin.provider.disk.sector_size", "섹터 크기" },
                     { "hex.builtin.provider.disk.reload", "새로 고침" },
+                    //{ "hex.builtin.provider.disk.direct_io", "Bypass the system cache (direct I/O)" },
                 { "hex.builtin.provider.intel_hex", "Intel Hex 공급자" },
                     { "hex.builtin.provider.intel_hex.name", "Intel Hex {0}" },
                 { "hex.builtin.provider.motorola_srec", "Motorola SREC 공급자" },
                     { "hex.builtin.provider.motorola_srec.name", "Motorola SREC {0}" },
+                //{ "hex.builtin.provider.compressed_file", "Compressed File Provider" },
+                //    { "hex.builtin.provider.compressed_file.name", "Compressed File {0}" },
+                //    { "hex.builtin.provider.compressed_file.format", "Compression format" },
+                //    { "hex.builtin.provider.compressed_file.compressed_size", "Compressed size" },
+                //    { "hex.builtin.provider.compressed_file.checkpoints", "Checkpoints" },
+                //{ "hex.builtin.provider.process_memory", "Process Memory Provider" },
+                //    { "hex.builtin.provider.process_memory.name", "Process {0} <{1}>" },
+                //    { "hex.builtin.provider.process_memory.process", "Process" },
+                //    { "hex.builtin.provider.process_memory.pid", "Process ID" },
+                //    { "hex.builtin.provider.process_memory.process_name", "Process name" },
+                //    { "hex.builtin.provider.process_memory.reload", "Reload" },
+                //    { "hex.builtin.provider.process_memory.snapshot", "Snapshot memory when opening" },
+                //    { "hex.builtin.provider.process_memory.reload_mappings", "Reload memory map" },
+                //    { "hex.builtin.provider.process_memory.mappings", "Mappings" },
+                //    { "hex.builtin.provider.process_memory.mapped_size", "Mapped size" },
 
                 { "hex.builtin.layouts.default", "기본 값" },
 
@@ -109,6 +109,8 @@ namespace hex::plugin::builtin {
                 { "hex.builtin.common.encoding.utf16le", "UTF-16LE" },
                 { "hex.builtin.common.encoding.utf16be", "UTF-16BE" },
                 { "hex.builtin.common.encoding.utf8", "UTF-8" },
+                { "hex.builtin.common.encoding.utf32le", "UTF-32LE" },
+                { "hex.builtin.common.encoding.utf32be", "UTF-32BE" },
 
                 { "hex.builtin.popup.exit_application.title", "退出？" },
                 { "hex.builtin.popup.exit_application.desc", "工程还有未保存的更改。\n确定要退出吗？" },
@@ -144,6 +146,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.menu.file.open_other", "打开其他..." },
                     { "hex.builtin.menu.file.close", "关闭" },
                     { "hex.builtin.menu.file.reload_file", "重新加载文件" },
+                    //{ "hex.builtin.menu.file.follow_file", "Follow File Changes" },
                     { "hex.builtin.menu.file.quit", "退出 ImHex" },
                     { "hex.builtin.menu.file.open_project", "打开项目..." },
                     { "hex.builtin.menu.file.save_project", "保存项目..." },
@@ -459,7 +462,12 @@ namespace hex::plugin::builtin {
                         { "hex.builtin.view.find.strings.symbols", "符号" },
                         { "hex.builtin.view.find.strings.spaces", "空格" },
                         { "hex.builtin.view.find.strings.line_feeds", "换行" },
+                //        { "hex.builtin.view.find.strings.all_encodings", "All encodings" },
                     { "hex.builtin.view.find.sequences", "序列" },
+                //    { "hex.builtin.view.find.sequence_list", "Sequence list" },
+                //        { "hex.builtin.view.find.sequence_list.sequences", "Sequences, one per line" },
+                //        { "hex.builtin.view.find.sequence_list.load", "Load from file" },
+                //        { "hex.builtin.view.find.sequence_list.count", "{} sequences" },
                     { "hex.builtin.view.find.regex", "正则表达式" },
                          { "hex.builtin.view.find.regex.pattern", "模式" },
                          { "hex.builtin.view.find.regex.full_match", "要求完整匹配" },
@@ -473,6 +481,27 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.find.search.entries", "{} 个结果" },
                     { "hex.builtin.view.find.search.reset", "重置" },
 
+                //{ "hex.builtin.view.io_diagnostics.name", "I/O Diagnostics" },
+                    //{ "hex.builtin.view.io_diagnostics.reset", "Reset" },
+                    //{ "hex.builtin.view.io_diagnostics.cache", "Cache hits / misses" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem", "Subsystem" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.other", "Other" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.hex_editor", "Hex Editor" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.data_inspector", "Data Inspector" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.find", "Find" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.hashes", "Hashes" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.information", "Information" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.pattern_language", "Pattern Language" },
+                    //{ "hex.builtin.view.io_diagnostics.subsystem.yara", "YARA" },
+                    //{ "hex.builtin.view.io_diagnostics.reads", "Reads" },
+                    //{ "hex.builtin.view.io_diagnostics.bytes_read", "Bytes read" },
+                    //{ "hex.builtin.view.io_diagnostics.read_latency", "Avg. read latency" },
+                    //{ "hex.builtin.view.io_diagnostics.writes", "Writes" },
+                    //{ "hex.builtin.view.io_diagnostics.bytes_written", "Bytes written" },
+                    //{ "hex.builtin.view.io_diagnostics.write_latency", "Avg. write latency" },
+                    //{ "hex.builtin.view.io_diagnostics.total", "Total" },
+                    //{ "hex.builtin.view.io_diagnostics.latency_histogram", "Latency histogram" },
+
                 { "hex.builtin.command.calc.desc", "计算器" },
                 { "hex.builtin.command.cmd.desc", "指令" },
                 { "hex.builtin.command.cmd.result", "运行指令 '{0}'" },
@@ -796,6 +825,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.setting.hex_editor.sync_scrolling", "同步编辑器位置" },
                     //{ "hex.builtin.setting.hex_editor.byte_padding", "Extra byte cell padding" },
                     //{ "hex.builtin.setting.hex_editor.char_padding", "Extra character cell padding" },
+                    //{ "hex.builtin.setting.hex_editor.undo_history_limit", "Undo history memory limit" },
                 { "hex.builtin.setting.folders", "扩展搜索路径" },
                     { "hex.builtin.setting.folders.description", "为模式、脚本和规则等指定额外的搜索路径" },
                     { "hex.builtin.setting.folders.add_folder", "添加新的目录" },
@@ -820,15 +850,34 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.provider.gdb.server", "服务器" },
                     { "hex.builtin.provider.gdb.ip", "IP 地址" },
                     { "hex.builtin.provider.gdb.port", "端口" },
+                    //{ "hex.builtin.provider.gdb.cache_size", "Cache size" },
+                    //{ "hex.builtin.provider.gdb.auto_refresh", "Refresh cached memory periodically" },
+                    //{ "hex.builtin.provider.gdb.invalidate_cache", "Invalidate cache" },
                 { "hex.builtin.provider.disk", "原始磁盘" },
                     { "hex.builtin.provider.disk.selected_disk", "磁盘" },
                     { "hex.builtin.provider.disk.disk_size", "磁盘大小" },
                     { "hex.builtin.provider.disk.sector_size", "扇区大小" },
                     { "hex.builtin.provider.disk.reload", "刷新" },
+                    //{ "hex.builtin.provider.disk.direct_io", "Bypass the system cache (direct I/O)" },
                 { "hex.builtin.provider.intel_hex", "Intel Hex" },
                     { "hex.builtin.provider.intel_hex.name", "Intel Hex {0}" },
                 { "hex.builtin.provider.motorola_srec", "Motorola SREC" },
                     { "hex.builtin.provider.motorola_srec.name", "Motorola SREC {0}" },
+                //{ "hex.builtin.provider.compressed_file", "Compressed File Provider" },
+                //    { "hex.builtin.provider.compressed_file.name", "Compressed File {0}" },
+                //    { "hex.builtin.provider.compressed_file.format", "Compression format" },
+                //    { "hex.builtin.provider.compressed_file.compressed_size", "Compressed size" },
+                //    { "hex.builtin.provider.compressed_file.checkpoints", "Checkpoints" },
+                //{ "hex.builtin.provider.process_memory", "Process Memory Provider" },
+                //    { "hex.builtin.provider.process_memory.name", "Process {0} <{1}>" },
+                //    { "hex.builtin.provider.process_memory.process", "Process" },
+                //    { "hex.builtin.provider.process_memory.pid", "Process ID" },
+                //    { "hex.builtin.provider.process_memory.process_name", "Process name" },
+                //    { "hex.builtin.provider.process_memory.reload", "Reload" },
+                //    { "hex.builtin.provider.process_memory.snapshot", "Snapshot memory when opening" },
+                //    { "hex.builtin.provider.process_memory.reload_mappings", "Reload memory map" },
+                //    { "hex.builtin.provider.process_memory.mappings", "Mappings" },
+                //    { "hex.builtin.provider.process_memory.mapped_size", "Mapped size" },
 
                 { "hex.builtin.layouts.default", "默认" },
 
@@ -2,10 +2,30 @@
 #include <hex/test/test_provider.hpp>
 
 #include <hex/helpers/crypto.hpp>
+#include <hex/helpers/process_memory.hpp>
+#include <hex/helpers/utils.hpp>
+#include <hex/providers/buffered_reader.hpp>
+#include <hex/providers/block_cache.hpp>
+#include <hex/providers/piece_table.hpp>
+#include <hex/providers/piece_layout.hpp>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <thread>
 #include <vector>
 
+#if defined(OS_LINUX)
+    #include <sys/mman.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
 TEST_SEQUENCE("TestSucceeding") {
     TEST_SUCCESS();
 };
@@ -81,3 +101,847 @@ TEST_SEQUENCE("TestProvider_write") {
 
     TEST_SUCCESS();
 };
+
+TEST_SEQUENCE("TestBufferedReader_chunks") {
+    std::vector<u8> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = i & 0xFF;
+
+    hex::test::TestProvider provider(&data);
+
+    auto reader = hex::prv::BufferedReader(&provider, 64);
+    reader.seek(10);
+    reader.setEndAddress(899);
+
+    u64 expectedAddress = 10;
+    for (const auto &chunk : reader.chunks(100)) {
+        TEST_ASSERT(chunk.address == expectedAddress);
+        TEST_ASSERT(chunk.data.size() <= 64);
+
+        for (u8 byte : chunk.data) {
+            TEST_ASSERT(byte == (expectedAddress & 0xFF));
+            expectedAddress++;
+        }
+    }
+    TEST_ASSERT(expectedAddress == 900, "{}", expectedAddress);
+
+    expectedAddress = 10;
+    for (u8 byte : reader) {
+        TEST_ASSERT(byte == (expectedAddress & 0xFF));
+        expectedAddress++;
+    }
+    TEST_ASSERT(expectedAddress == 900);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestPatchStore_writeErase") {
+    hex::prv::PatchStore patches;
+
+    const u8 data[] = { 0x11, 0x22, 0x33, 0x44 };
+
+    patches.write(10, data, 4);
+    patches.write(14, data, 2);
+    TEST_ASSERT(patches.getRuns().size() == 1);
+    TEST_ASSERT(patches.getPatchedByteCount() == 6);
+
+    patches.write(5, data, 2);
+    patches.write(8, data, 4);
+    TEST_ASSERT(patches.getRuns().size() == 2);
+    TEST_ASSERT(patches.getPatchedByteCount() == 10);
+    TEST_ASSERT(patches.get(9) == 0x22);
+    TEST_ASSERT(patches.get(10) == 0x33);
+    TEST_ASSERT(patches.get(13) == 0x44);
+    TEST_ASSERT(!patches.contains(7));
+
+    patches.erase(9, 3);
+    TEST_ASSERT(patches.getRuns().size() == 3);
+    TEST_ASSERT(patches.getPatchedByteCount() == 7);
+    TEST_ASSERT(!patches.contains(10));
+    TEST_ASSERT(patches.get(12) == 0x33);
+
+    std::vector<u8> buffer(20, 0x00);
+    patches.apply(0, buffer.data(), buffer.size());
+    TEST_ASSERT(buffer[5] == 0x11 && buffer[6] == 0x22 && buffer[7] == 0x00);
+    TEST_ASSERT(buffer[8] == 0x11 && buffer[9] == 0x00);
+    TEST_ASSERT(buffer[12] == 0x33 && buffer[15] == 0x22 && buffer[16] == 0x00);
+
+    TEST_ASSERT(patches.getNextPatchAddress(10) == 12);
+    TEST_ASSERT(!patches.getNextPatchAddress(16).has_value());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestPatchStore_insertRemove") {
+    hex::prv::PatchStore patches;
+
+    const u8 data[] = { 0x11, 0x22, 0x33, 0x44 };
+    patches.write(10, data, 4);
+
+    patches.insert(12, 2);
+    TEST_ASSERT(patches.get(11) == 0x22);
+    TEST_ASSERT(!patches.contains(12));
+    TEST_ASSERT(patches.get(14) == 0x33);
+    TEST_ASSERT(patches.get(15) == 0x44);
+
+    patches.remove(12, 2);
+    TEST_ASSERT(patches.getRuns().size() == 1);
+    TEST_ASSERT(patches.get(12) == 0x33);
+
+    patches.remove(0, 11);
+    TEST_ASSERT(patches.getPatchedByteCount() == 3);
+    TEST_ASSERT(patches.get(0) == 0x22);
+    TEST_ASSERT(patches.get(2) == 0x44);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProvider_undoRedo") {
+    std::vector<u8> data(16, 0x00);
+    hex::test::TestProvider provider(&data);
+    auto &patches = provider.getPatches();
+
+    u8 first[] = { 0x11, 0x11, 0x11, 0x11 };
+    u8 second[] = { 0x22, 0x22 };
+    u8 third[] = { 0x33 };
+
+    TEST_ASSERT(!provider.canUndo());
+
+    provider.addPatch(0, first, sizeof(first), true);
+    provider.addPatch(2, second, sizeof(second), true);
+    provider.addPatch(8, third, sizeof(third));    // same undo step as the previous patch
+    TEST_ASSERT(patches.get(2) == 0x22);
+    TEST_ASSERT(patches.get(8) == 0x33);
+
+    provider.undo();
+    TEST_ASSERT(patches.get(2) == 0x11);
+    TEST_ASSERT(!patches.contains(8));
+    TEST_ASSERT(patches.getPatchedByteCount() == 4);
+
+    provider.undo();
+    TEST_ASSERT(patches.empty());
+    TEST_ASSERT(!provider.canUndo());
+    TEST_ASSERT(provider.canRedo());
+
+    provider.redo();
+    provider.redo();
+    TEST_ASSERT(patches.get(0) == 0x11);
+    TEST_ASSERT(patches.get(3) == 0x22);
+    TEST_ASSERT(patches.get(8) == 0x33);
+    TEST_ASSERT(!provider.canRedo());
+
+    // A new edit after undoing discards the redo history
+    provider.undo();
+    provider.addPatch(4, third, sizeof(third), true);
+    TEST_ASSERT(!provider.canRedo());
+    TEST_ASSERT(patches.get(2) == 0x11);
+    TEST_ASSERT(patches.get(4) == 0x33);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProvider_overlays") {
+    std::vector<u8> data(64, 0x00);
+    hex::test::TestProvider provider(&data);
+
+    auto first = provider.newOverlay();
+    first->setAddress(4);
+    first->setData({ 0x11, 0x11, 0x11, 0x11 });
+
+    auto second = provider.newOverlay();
+    second->setAddress(6);
+    second->setData({ 0x22, 0x22 });
+
+    auto third = provider.newOverlay();
+    third->setAddress(32);
+    third->setData({ 0x33 });
+
+    u8 buff[16] = { };
+    provider.applyOverlays(0, buff, sizeof(buff));
+    TEST_ASSERT(buff[3] == 0x00);
+    TEST_ASSERT(buff[4] == 0x11);
+    TEST_ASSERT(buff[5] == 0x11);
+    TEST_ASSERT(buff[6] == 0x22);    // later overlays take precedence
+    TEST_ASSERT(buff[7] == 0x22);
+    TEST_ASSERT(buff[8] == 0x00);
+
+    auto [region, valid] = provider.getRegionValidity(10);
+    TEST_ASSERT(!valid);
+    TEST_ASSERT(region.getStartAddress() == 10 && region.getSize() == 22);
+    TEST_ASSERT(provider.getRegionValidity(32).second);
+
+    // Moving and deleting overlays has to be reflected by the next read
+    second->setAddress(0);
+    provider.deleteOverlay(first);
+
+    std::fill(std::begin(buff), std::end(buff), 0x00);
+    provider.applyOverlays(0, buff, sizeof(buff));
+    TEST_ASSERT(buff[0] == 0x22);
+    TEST_ASSERT(buff[1] == 0x22);
+    TEST_ASSERT(buff[4] == 0x00);
+    TEST_ASSERT(buff[6] == 0x00);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProvider_snapshot") {
+    std::vector<u8> data(64, 0x00);
+    hex::test::TestProvider provider(&data);
+
+    u8 first[] = { 0x11, 0x11, 0x11, 0x11 };
+    provider.addPatch(0, first, sizeof(first));
+
+    auto overlay = provider.newOverlay();
+    overlay->setAddress(32);
+    overlay->setData({ 0x22, 0x22 });
+
+    auto snapshot = provider.snapshot();
+    TEST_ASSERT(snapshot.isCurrent());
+    TEST_ASSERT(snapshot.getGeneration() == provider.getGeneration());
+
+    // Edits made after the snapshot was taken only show up in the live state
+    u8 second[] = { 0x33, 0x33 };
+    provider.addPatch(2, second, sizeof(second));
+    provider.addPatch(16, second, sizeof(second));
+    overlay->setData({ 0x44 });
+    TEST_ASSERT(!snapshot.isCurrent());
+    TEST_ASSERT(provider.getPatches().get(2) == 0x33);
+
+    u8 buff[64] = { };
+    snapshot.read(0, buff, sizeof(buff));
+    TEST_ASSERT(buff[1] == 0x11);
+    TEST_ASSERT(buff[2] == 0x11);
+    TEST_ASSERT(buff[16] == 0x00);
+    TEST_ASSERT(buff[32] == 0x22);
+    TEST_ASSERT(buff[33] == 0x22);
+
+    snapshot.read(0, buff, sizeof(buff), false);
+    TEST_ASSERT(buff[32] == 0x00);
+
+    auto regions = snapshot.getDataRegions(0, data.size());
+    TEST_ASSERT(regions.size() == 1 && regions[0].getStartAddress() == 0 && regions[0].getSize() == data.size());
+
+    // Snapshots taken without any edits in between share the frozen state
+    auto current = provider.snapshot();
+    auto again = provider.snapshot();
+    TEST_ASSERT(&current.getPatches().getRuns() == &again.getPatches().getRuns());
+    current.read(0, buff, sizeof(buff));
+    TEST_ASSERT(buff[2] == 0x33);
+    TEST_ASSERT(buff[16] == 0x33);
+    TEST_ASSERT(buff[32] == 0x44);
+    TEST_ASSERT(buff[33] == 0x00);
+
+    provider.undo();
+    TEST_ASSERT(current.getPatches().get(16) == 0x33);
+
+    // Reads through a buffered reader use the frozen state as well
+    auto reader = hex::prv::BufferedReader(snapshot, 16);
+    TEST_ASSERT(reader.read(0, 4) == std::vector<u8>(4, 0x11));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProvider_dataRegions") {
+    class SparseProvider : public hex::test::TestProvider {
+    public:
+        using TestProvider::TestProvider;
+
+    protected:
+        [[nodiscard]] std::vector<hex::Region> getRawDataRegions(u64 offset, size_t size) const override {
+            std::vector<hex::Region> regions;
+            for (hex::Region region : { hex::Region { 16, 16 }, hex::Region { 96, 16 } }) {
+                const u64 start = std::max<u64>(region.getStartAddress(), offset);
+                const u64 end   = std::min<u64>(region.getStartAddress() + region.getSize(), offset + size);
+                if (start < end)
+                    regions.push_back({ start, end - start });
+            }
+
+            return regions;
+        }
+    };
+
+    std::vector<u8> data(128, 0x00);
+
+    hex::test::TestProvider denseProvider(&data);
+    auto denseRegions = denseProvider.getDataRegions(0, data.size());
+    TEST_ASSERT(denseRegions.size() == 1);
+    TEST_ASSERT(denseRegions[0].getStartAddress() == 0 && denseRegions[0].getSize() == data.size());
+
+    SparseProvider provider(&data);
+
+    auto regions = provider.getDataRegions(0, data.size());
+    TEST_ASSERT(regions.size() == 2);
+    TEST_ASSERT(regions[0].getStartAddress() == 16 && regions[0].getSize() == 16);
+    TEST_ASSERT(regions[1].getStartAddress() == 96 && regions[1].getSize() == 16);
+
+    // Requests are clamped to the data
+    regions = provider.getDataRegions(100, 1000);
+    TEST_ASSERT(regions.size() == 1);
+    TEST_ASSERT(regions[0].getStartAddress() == 100 && regions[0].getSize() == 12);
+    TEST_ASSERT(provider.getDataRegions(128, 16).empty());
+
+    // Patches and overlays on top of holes count as data and get merged with adjacent regions
+    provider.addPatch(32, "\x11\x11\x11\x11", 4);
+    provider.addPatch(64, "\x22", 1);
+
+    auto overlay = provider.newOverlay();
+    overlay->setAddress(92);
+    overlay->setData({ 0x33, 0x33, 0x33, 0x33 });
+
+    regions = provider.getDataRegions(0, data.size());
+    TEST_ASSERT(regions.size() == 3);
+    TEST_ASSERT(regions[0].getStartAddress() == 16 && regions[0].getSize() == 20);
+    TEST_ASSERT(regions[1].getStartAddress() == 64 && regions[1].getSize() == 1);
+    TEST_ASSERT(regions[2].getStartAddress() == 92 && regions[2].getSize() == 20);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestBlockCache") {
+    std::vector<u8> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = u8(i * 7);
+
+    u32 backingReads = 0;
+    std::optional<hex::Region> failing;
+    hex::prv::BlockCache cache([&](u64 offset, void *buffer, size_t size) -> std::vector<hex::Region> {
+        backingReads++;
+        std::memcpy(buffer, data.data() + offset, size);
+
+        if (failing.has_value())
+            return { *failing };
+        else
+            return { };
+    }, 64, 256, 2);
+    cache.setDataSize(data.size());
+    cache.setMaxReadAhead(0);
+
+    std::vector<u8> buff(90);
+    cache.read(30, buff.data(), buff.size());
+    TEST_ASSERT(std::equal(buff.begin(), buff.end(), data.begin() + 30));
+    TEST_ASSERT(backingReads == 1);    // both missing blocks are fetched at once
+    TEST_ASSERT(cache.getMissCount() == 2 && cache.getHitCount() == 0);
+
+    cache.read(64, buff.data(), 10);
+    TEST_ASSERT(std::equal(buff.begin(), buff.begin() + 10, data.begin() + 64));
+    TEST_ASSERT(backingReads == 1);
+    TEST_ASSERT(cache.getHitCount() == 1);
+
+    // Reads past the end of the data are clamped and the last block is partial
+    std::fill(buff.begin(), buff.end(), 0xAA);
+    cache.read(990, buff.data(), 20);
+    TEST_ASSERT(std::equal(buff.begin(), buff.begin() + 10, data.begin() + 990));
+    TEST_ASSERT(buff[10] == 0xAA);
+
+    // Only four blocks fit into the cache, older ones get evicted
+    for (u64 offset = 0; offset < data.size(); offset += 64)
+        cache.read(offset, buff.data(), 1);
+    backingReads = 0;
+    cache.read(0, buff.data(), 1);
+    TEST_ASSERT(backingReads == 1);
+
+    data[0] = 0x42;
+    cache.read(0, buff.data(), 1);
+    TEST_ASSERT(buff[0] != 0x42);
+    cache.invalidate(0, 1);
+    cache.read(0, buff.data(), 1);
+    TEST_ASSERT(buff[0] == 0x42);
+
+    // Sequential reads fetch the following blocks ahead of time
+    cache.clear();
+    cache.setMaxReadAhead(2);
+    backingReads = 0;
+    for (u64 offset = 0; offset < 256; offset += 16) {
+        cache.read(offset, buff.data(), 16);
+        TEST_ASSERT(std::equal(buff.begin(), buff.begin() + 16, data.begin() + offset));
+    }
+    TEST_ASSERT(backingReads < 4);
+    TEST_ASSERT(cache.getReadAheadCount() > 0);
+
+    // Byte-wise reads inside blocks keep the read-ahead going and it gets topped up before the scan runs out of it
+    cache.clear();
+    cache.setCapacity(1024);
+    cache.setMaxReadAhead(4);
+    backingReads = 0;
+    const auto misses = cache.getMissCount();
+    for (u64 offset = 0; offset < data.size(); offset++) {
+        cache.read(offset, buff.data(), 1);
+        TEST_ASSERT(buff[0] == data[offset]);
+    }
+    TEST_ASSERT(backingReads <= 6);
+    TEST_ASSERT(cache.getMissCount() == misses + 1);    // only the very first block wasn't read ahead
+    cache.setCapacity(256);
+
+    // Sequential reads that stay inside the block a seek landed in don't read ahead yet
+    cache.clear();
+    cache.read(0, buff.data(), 1);
+    cache.read(600, buff.data(), 4);
+    const auto readAheads = cache.getReadAheadCount();
+    for (u64 offset = 604; offset < 636; offset += 4) {
+        cache.read(offset, buff.data(), 4);
+        TEST_ASSERT(std::equal(buff.begin(), buff.begin() + 4, data.begin() + offset));
+    }
+    TEST_ASSERT(cache.getReadAheadCount() == readAheads);
+
+    // Growing the data keeps complete blocks but refetches the previously partial last one
+    cache.setMaxReadAhead(0);
+    cache.setDataSize(100);
+    cache.read(0, buff.data(), 1);
+    cache.read(64, buff.data(), 36);
+    cache.setDataSize(data.size());
+    backingReads = 0;
+    cache.read(0, buff.data(), 1);
+    TEST_ASSERT(backingReads == 0);
+    cache.read(64, buff.data(), 64);
+    TEST_ASSERT(backingReads == 1);
+    TEST_ASSERT(std::equal(buff.begin(), buff.begin() + 64, data.begin() + 64));
+
+    // Most recently used blocks are listed first
+    cache.clear();
+    cache.read(128, buff.data(), 1);
+    cache.read(0, buff.data(), 1);
+    auto cachedBlocks = cache.getCachedBlocks(4);
+    TEST_ASSERT(cachedBlocks.size() == 2 && cachedBlocks[0] == 0);
+    TEST_ASSERT(cache.getCachedBlocks(1).size() == 1);
+
+    // Refreshed data only ends up in the cache if nothing got invalidated in the meantime
+    std::vector<u8> refreshed(64, 0x55);
+    auto generation = cache.getGeneration();
+    TEST_ASSERT(cache.refreshBlock(0, refreshed.data(), refreshed.size(), generation));
+    TEST_ASSERT(!cache.refreshBlock(1, refreshed.data(), refreshed.size(), generation));
+    cache.read(0, buff.data(), 64);
+    TEST_ASSERT(std::equal(buff.begin(), buff.begin() + 64, refreshed.begin()));
+
+    cache.invalidate(128, 1);
+    refreshed.assign(64, 0x66);
+    TEST_ASSERT(!cache.refreshBlock(0, refreshed.data(), refreshed.size(), generation));
+    cache.read(0, buff.data(), 1);
+    TEST_ASSERT(buff[0] == 0x55);
+
+    // Failed ranges read as zeros and only the blocks overlapping them get fetched again
+    cache.clear();
+    failing = hex::Region { 70, 10 };
+    cache.read(0, buff.data(), 90);
+    TEST_ASSERT(std::equal(buff.begin(), buff.begin() + 70, data.begin()));
+    TEST_ASSERT(std::all_of(buff.begin() + 70, buff.begin() + 80, [](u8 byte) { return byte == 0x00; }));
+    TEST_ASSERT(std::equal(buff.begin() + 80, buff.begin() + 90, data.begin() + 80));
+
+    failing.reset();
+    backingReads = 0;
+    cache.read(0, buff.data(), 90);
+    TEST_ASSERT(backingReads == 1);
+    TEST_ASSERT(std::equal(buff.begin(), buff.begin() + 90, data.begin()));
+    cache.read(0, buff.data(), 90);
+    TEST_ASSERT(backingReads == 1);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProvider_readMany") {
+    std::vector<u8> data(0x10000);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = u8(i ^ (i >> 8));
+    hex::test::TestProvider provider(&data);
+
+    u8 first[16], second[32], third[8], fourth[4];
+    std::array<hex::prv::ReadRequest, 5> requests = {{
+        { 0x8000, third, sizeof(third) },
+        { 0x10, first, sizeof(first) },
+        { 0x18, second, sizeof(second) },    // overlaps with the previous request
+        { 0x10, nullptr, 16 },               // ignored
+        { 0xFFF0, fourth, sizeof(fourth) }
+    }};
+    provider.readMany(requests);
+
+    TEST_ASSERT(std::equal(std::begin(first), std::end(first), data.begin() + 0x10));
+    TEST_ASSERT(std::equal(std::begin(second), std::end(second), data.begin() + 0x18));
+    TEST_ASSERT(std::equal(std::begin(third), std::end(third), data.begin() + 0x8000));
+    TEST_ASSERT(std::equal(std::begin(fourth), std::end(fourth), data.begin() + 0xFFF0));
+
+    auto future = provider.readAsync(0x1234, 0x100);
+    auto bytes  = future.get();
+    TEST_ASSERT(bytes.size() == 0x100);
+    TEST_ASSERT(std::equal(bytes.begin(), bytes.end(), data.begin() + 0x1234));
+
+    // Closing the provider waits for reads that are still running
+    std::vector<std::future<std::vector<u8>>> futures;
+    for (u32 i = 0; i < 8; i++)
+        futures.push_back(provider.readAsync(i * 0x1000, 0x1000));
+    provider.waitForAsyncReads();
+    for (auto &pending : futures)
+        TEST_ASSERT(pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProvider_ioStatistics") {
+    std::vector<u8> data(0x100);
+    hex::test::TestProvider provider(&data);
+    auto &statistics = provider.getIOStatistics();
+
+    u8 buff[0x10];
+    provider.read(0x00, buff, sizeof(buff));
+    {
+        hex::prv::IOStatistics::ScopedSubsystem subsystem(hex::prv::IOSubsystem::Find);
+        provider.read(0x10, buff, sizeof(buff));
+        provider.read(0x20, buff, 4);
+    }
+    provider.write(0x00, buff, 2);
+
+    auto other = statistics.getCounters(hex::prv::IOSubsystem::Other);
+    TEST_ASSERT(other.readCalls == 1 && other.bytesRead == 0x10);
+    TEST_ASSERT(other.writeCalls == 1 && other.bytesWritten == 2);
+
+    auto find = statistics.getCounters(hex::prv::IOSubsystem::Find);
+    TEST_ASSERT(find.readCalls == 2 && find.bytesRead == 0x14);
+    TEST_ASSERT(find.writeCalls == 0);
+
+    auto total = statistics.getTotalCounters();
+    TEST_ASSERT(total.readCalls == 3 && total.writeCalls == 1);
+
+    auto histogram = statistics.getLatencyHistogram();
+    TEST_ASSERT(std::accumulate(histogram.begin(), histogram.end(), u64(0)) == 4);
+
+    statistics.reset();
+    TEST_ASSERT(statistics.getTotalCounters().readCalls == 0);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestBufferedReader_sequential") {
+    class SequentialTestProvider : public hex::test::TestProvider {
+    public:
+        using TestProvider::TestProvider;
+
+        void readSequential(u64 offset, void *buffer, size_t size, bool overlays) override {
+            this->sequentialReads++;
+            TestProvider::readSequential(offset, buffer, size, overlays);
+        }
+
+        u32 sequentialReads = 0;
+    };
+
+    std::vector<u8> data(0x1000, 0x55);
+    SequentialTestProvider provider(&data);
+
+    hex::prv::BufferedReader reader(&provider, 0x100);
+
+    size_t bytes = 0;
+    for (const auto &chunk : reader.chunks())
+        bytes += chunk.data.size();
+    TEST_ASSERT(bytes == data.size());
+    TEST_ASSERT(provider.sequentialReads == 0x10);
+
+    // Random access through read() keeps using the regular read path
+    provider.sequentialReads = 0;
+    auto bytesRead = reader.read(0x800, 0x10);
+    TEST_ASSERT(bytesRead.size() == 0x10);
+    TEST_ASSERT(provider.sequentialReads == 0);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestPieceTable") {
+    using Source = hex::prv::PieceTable::Source;
+
+    std::vector<u8> original(100);
+    std::iota(original.begin(), original.end(), 0);
+    std::vector<u8> added;
+    std::vector<u8> expected = original;
+
+    hex::prv::PieceTable pieces;
+    pieces.reset(original.size());
+    TEST_ASSERT(pieces.isIdentity());
+
+    auto resolve = [&] {
+        std::vector<u8> result;
+        pieces.forEachPiece(0, pieces.getSize(), [&](u64, const auto &piece) {
+            const auto &source = piece.source == Source::Original ? original : added;
+            result.insert(result.end(), source.begin() + piece.offset, source.begin() + piece.offset + piece.size);
+        });
+
+        return result;
+    };
+
+    std::mt19937 random(1234);
+    for (u32 i = 0; i < 500; i++) {
+        const auto offset = random() % (expected.size() + 1);
+        const auto size   = random() % 8 + 1;
+
+        if (random() % 2 == 0 || expected.size() < 10) {
+            const auto addedOffset = added.size();
+            for (u32 j = 0; j < size; j++)
+                added.push_back(u8(random()));
+
+            pieces.insert(offset, Source::Added, addedOffset, size);
+            expected.insert(expected.begin() + offset, added.begin() + addedOffset, added.end());
+        } else {
+            const auto removedSize = std::min<u64>(size, expected.size() - offset);
+
+            pieces.remove(offset, size);
+            expected.erase(expected.begin() + offset, expected.begin() + offset + removedSize);
+        }
+
+        TEST_ASSERT(pieces.getSize() == expected.size());
+    }
+
+    TEST_ASSERT(resolve() == expected);
+    TEST_ASSERT(!pieces.isIdentity());
+
+    // Copies share their nodes but edits of one of them don't show up in the other
+    const auto copy = pieces;
+    pieces.remove(0, 10);
+    pieces.insert(3, Source::Original, 0, 5);
+    TEST_ASSERT(pieces.getSize() == expected.size() - 5);
+    pieces = copy;
+    TEST_ASSERT(resolve() == expected);
+
+    // Lookups of a sub-range only report the clipped part of the pieces overlapping it
+    u64 visited = 0;
+    bool contiguous = true;
+    pieces.forEachPiece(5, 10, [&](u64 offset, const auto &piece) {
+        contiguous = contiguous && offset == 5 + visited;
+        visited += piece.size;
+    });
+    TEST_ASSERT(contiguous && visited == 10);
+
+    pieces.remove(0, pieces.getSize());
+    TEST_ASSERT(pieces.getSize() == 0 && pieces.getPieceCount() == 0);
+
+    // Data appended to the original keeps an unmodified table an identity mapping
+    pieces.reset(10);
+    pieces.appendOriginal(5);
+    TEST_ASSERT(pieces.isIdentity() && pieces.getSize() == 15 && pieces.getPieceCount() == 1);
+
+    // Removing inserted data joins the original pieces around it again
+    pieces.insert(7, Source::Added, 0, 3);
+    pieces.remove(2, 2);
+    pieces.insert(2, Source::Original, 2, 2);
+    TEST_ASSERT(!pieces.isIdentity() && pieces.getPieceCount() == 3);
+    pieces.remove(7, 3);
+    TEST_ASSERT(pieces.isIdentity() && pieces.getPieceCount() == 1);
+
+    pieces.remove(0, 1);
+    pieces.appendOriginal(5);
+    original.resize(20);
+    std::iota(original.begin(), original.end(), 0);
+    expected.assign(original.begin() + 1, original.end());
+    TEST_ASSERT(resolve() == expected);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProvider_snapshotLayout") {
+    class VectorData : public hex::prv::OriginalData {
+    public:
+        explicit VectorData(std::vector<u8> data) : m_data(std::move(data)) { }
+
+        void read(u64 offset, void *buffer, size_t size, bool) const override {
+            std::memcpy(buffer, this->m_data.data() + offset, size);
+        }
+
+    private:
+        std::vector<u8> m_data;
+    };
+
+    // Stores its data the same way the file provider does
+    class LayoutProvider : public hex::test::TestProvider {
+    public:
+        explicit LayoutProvider(const std::vector<u8> &data) : TestProvider(nullptr), m_layout(std::make_shared<hex::prv::PieceLayout>(std::make_shared<VectorData>(data), data.size())) { }
+
+        void readRaw(u64 offset, void *buffer, size_t size) override { this->getLayout()->read(offset, buffer, size, false); }
+        [[nodiscard]] size_t getActualSize() const override { return this->getLayout()->getSize(); }
+
+        void insert(u64 offset, size_t size) override {
+            this->setLayout(this->getLayout()->insert(offset, size));
+            Provider::insert(offset, size);
+        }
+
+        void remove(u64 offset, size_t size) override {
+            this->setLayout(this->getLayout()->remove(offset, size));
+            Provider::remove(offset, size);
+        }
+
+    protected:
+        [[nodiscard]] std::shared_ptr<const hex::prv::RawDataState> getRawDataState() const override { return this->getLayout(); }
+
+    private:
+        [[nodiscard]] std::shared_ptr<const hex::prv::PieceLayout> getLayout() const {
+            std::scoped_lock lock(this->m_mutex);
+            return this->m_layout;
+        }
+
+        void setLayout(std::shared_ptr<const hex::prv::PieceLayout> layout) {
+            std::scoped_lock lock(this->m_mutex);
+            this->m_layout = std::move(layout);
+        }
+
+        mutable std::mutex m_mutex;
+        std::shared_ptr<const hex::prv::PieceLayout> m_layout;
+    };
+
+    std::vector<u8> data(256);
+    std::iota(data.begin(), data.end(), 0);
+
+    LayoutProvider provider(data);
+    auto snapshot = provider.snapshot();
+
+    // Reads of the snapshot keep seeing the original data while bytes get inserted and removed on another thread
+    std::atomic<bool> done = false, consistent = true;
+    std::thread reader([&] {
+        std::vector<u8> buffer(data.size());
+        while (!done) {
+            snapshot.read(0, buffer.data(), buffer.size());
+            if (buffer != data)
+                consistent = false;
+        }
+    });
+
+    for (u32 i = 0; i < 200; i++) {
+        provider.insert(i % 64, 16);
+        provider.remove(128, 8);
+    }
+
+    done = true;
+    reader.join();
+
+    TEST_ASSERT(consistent.load());
+    TEST_ASSERT(snapshot.getActualSize() == data.size());
+    TEST_ASSERT(provider.getActualSize() == data.size() + 200 * 8);
+
+    std::vector<u8> buffer(data.size());
+    snapshot.read(0, buffer.data(), buffer.size());
+    TEST_ASSERT(buffer == data);
+
+    auto regions = snapshot.getDataRegions(0, data.size());
+    TEST_ASSERT(regions.size() == 1 && regions[0].getSize() == data.size());
+
+    // The live data has the inserted bytes as zeros
+    provider.read(0, buffer.data(), buffer.size());
+    TEST_ASSERT(buffer[0] == 0x00);
+    TEST_ASSERT(provider.snapshot().getActualSize() == provider.getActualSize());
+
+    // Writes into inserted bytes only show up in layouts created afterwards
+    auto layout = std::make_shared<hex::prv::PieceLayout>(std::make_shared<VectorData>(data), data.size())->insert(4, 8);
+    auto written = layout->writeAdded(2, "\xAA\xBB", 2);
+
+    u8 bytes[16] = { };
+    layout->read(0, bytes, sizeof(bytes), false);
+    TEST_ASSERT(bytes[3] == 0x03 && bytes[6] == 0x00 && bytes[7] == 0x00 && bytes[12] == 0x04);
+    written->read(0, bytes, sizeof(bytes), false);
+    TEST_ASSERT(bytes[3] == 0x03 && bytes[6] == 0xAA && bytes[7] == 0xBB && bytes[12] == 0x04);
+
+    // Large inserts are written in chunks. Writes across chunk boundaries only change the written bytes in the new layout
+    const u64 insertedSize = 300 * 1024;
+    auto large = written->insert(16, insertedSize);
+    std::vector<u8> pattern(10000);
+    for (size_t i = 0; i < pattern.size(); i++)
+        pattern[i] = u8(i * 13 + 1);
+
+    const u64 addedStart = 8;    // the first insert added 8 bytes before
+    auto largeWritten = large->writeAdded(addedStart + 250 * 1024, pattern.data(), pattern.size());
+
+    std::vector<u8> largeBuffer(pattern.size() + 2);
+    largeWritten->read(16 + 250 * 1024 - 1, largeBuffer.data(), largeBuffer.size(), false);
+    TEST_ASSERT(largeBuffer.front() == 0x00 && largeBuffer.back() == 0x00);
+    TEST_ASSERT(std::equal(pattern.begin(), pattern.end(), largeBuffer.begin() + 1));
+
+    large->read(16 + 250 * 1024 - 1, largeBuffer.data(), largeBuffer.size(), false);
+    TEST_ASSERT(std::all_of(largeBuffer.begin(), largeBuffer.end(), [](u8 byte) { return byte == 0x00; }));
+
+    largeWritten->read(0, bytes, sizeof(bytes), false);
+    TEST_ASSERT(bytes[6] == 0xAA && bytes[7] == 0xBB && bytes[12] == 0x04);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProcessMemory") {
+    #if defined(OS_LINUX)
+
+        const size_t pageSize = sysconf(_SC_PAGESIZE);
+        auto pattern = [](size_t index) { return u8(index * 7 + 1); };
+
+        // Four pages of which the second one becomes unreadable, and a buffer on the heap. Only the child fills them with data
+        auto pages = static_cast<u8 *>(mmap(nullptr, pageSize * 4, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        TEST_ASSERT(pages != MAP_FAILED);
+        ON_SCOPE_EXIT { munmap(pages, pageSize * 4); };
+
+        std::vector<u8> heap(1000, 0x00);
+
+        int ready[2], done[2];
+        TEST_ASSERT(pipe(ready) == 0 && pipe(done) == 0);
+
+        const pid_t child = fork();
+        TEST_ASSERT(child >= 0);
+        if (child == 0) {
+            close(ready[0]);
+            close(done[1]);
+
+            for (size_t i = 0; i < pageSize * 4; i++)
+                pages[i] = pattern(i);
+            for (size_t i = 0; i < heap.size(); i++)
+                heap[i] = pattern(i + 3);
+            mprotect(pages + pageSize, pageSize, PROT_NONE);
+
+            // Stay around until the parent is done reading
+            char byte = 0;
+            [[maybe_unused]] auto written = write(ready[1], &byte, 1);
+            [[maybe_unused]] auto read    = ::read(done[0], &byte, 1);
+            _exit(0);
+        }
+
+        close(ready[1]);
+        close(done[0]);
+        ON_SCOPE_EXIT {
+            close(done[1]);
+            close(ready[0]);
+            waitpid(child, nullptr, 0);
+        };
+
+        char byte = 0;
+        TEST_ASSERT(read(ready[0], &byte, 1) == 1);
+
+        auto checkPages = [&](const std::vector<u8> &buffer, size_t start) {
+            for (size_t i = 0; i < start; i++) {
+                if (buffer[i] != 0xAA)
+                    return false;
+            }
+
+            for (size_t i = start; i < buffer.size(); i++) {
+                const bool unreadable = i >= pageSize && i < pageSize * 2;
+                if (buffer[i] != (unreadable ? 0xAA : pattern(i)))
+                    return false;
+            }
+
+            return true;
+        };
+
+        // Reading all at once stops at the guard page. The pages around it and the transfers after it still have to be read
+        {
+            std::vector<u8> first(100, 0xAA), second(pageSize * 4, 0xAA), third(50, 0xAA);
+            std::array transfers = {
+                hex::process::Transfer { u64(heap.data()), first.data(), first.size() },
+                hex::process::Transfer { u64(pages), second.data(), second.size() },
+                hex::process::Transfer { u64(heap.data() + 10), third.data(), third.size() }
+            };
+            hex::process::readMemory(child, transfers);
+
+            for (size_t i = 0; i < first.size(); i++)
+                TEST_ASSERT(first[i] == pattern(i + 3), "at {}", i);
+            TEST_ASSERT(checkPages(second, 0));
+            for (size_t i = 0; i < third.size(); i++)
+                TEST_ASSERT(third[i] == pattern(i + 13), "at {}", i);
+        }
+
+        // Reading page by page from the middle of the first page
+        {
+            std::vector<u8> buffer(pageSize * 4, 0xAA);
+            hex::process::readMemoryPages(child, { u64(pages), buffer.data(), buffer.size() }, pageSize / 2);
+
+            TEST_ASSERT(checkPages(buffer, pageSize / 2));
+        }
+
+    #endif
+
+    TEST_SUCCESS();
+};
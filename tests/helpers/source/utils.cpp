@@ -1,6 +1,17 @@
 #include <hex/test/tests.hpp>
 
 #include <hex/helpers/utils.hpp>
+#include <hex/helpers/aho_corasick.hpp>
+#include <hex/helpers/byte_class.hpp>
+#include <hex/helpers/gdb_protocol.hpp>
+#include <hex/helpers/masked_pattern.hpp>
+#include <hex/helpers/string_scanner.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <optional>
+#include <random>
 
 using namespace std::literals::string_literals;
 
@@ -30,3 +41,431 @@ TEST_SEQUENCE("ExtractBits") {
 
     TEST_SUCCESS();
 };
+
+TEST_SEQUENCE("ByteClassify") {
+    std::mt19937 random(1234);
+
+    std::vector<u8> data(1024);
+    for (auto &byte : data)
+        byte = random() % 4 == 0 ? 0x00 : random();
+
+    std::array<bool, 256> printable = { }, scattered = { };
+    for (u32 byte = 0; byte < 256; byte++) {
+        printable[byte] = std::isprint(byte) || byte == '\n';
+        scattered[byte] = byte % 3 == 0;    // too many ranges to be compared directly
+    }
+
+    for (const auto &table : { printable, scattered }) {
+        hex::ByteClass byteClass(table);
+
+        for (size_t offset = 0; offset < data.size(); offset += 37) {
+            const auto size = std::min<size_t>(hex::ByteClass::BlockSize, data.size() - offset);
+
+            u64 members, zeros;
+            byteClass.classify(data.data() + offset, size, members, zeros);
+
+            for (size_t i = 0; i < hex::ByteClass::BlockSize; i++) {
+                const bool inside = i < size;
+                TEST_ASSERT(((members >> i) & 1) == (inside && table[data[offset + i]]));
+                TEST_ASSERT(((zeros >> i) & 1) == (inside && data[offset + i] == 0x00));
+            }
+        }
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("AhoCorasick") {
+    std::mt19937 random(4321);
+
+    std::vector<u8> data(4096);
+    for (auto &byte : data)
+        byte = random() % 4;
+
+    // Overlapping needles, needles that are suffixes of others and a duplicate
+    std::vector<std::vector<u8>> needles = { { 0, 1 }, { 1 }, { 2, 0, 1 }, { 3, 3, 3 }, { 0, 1 }, { 1, 2, 3, 0, 1, 2 } };
+    for (u32 i = 0; i < 32; i++) {
+        std::vector<u8> needle(1 + random() % 6);
+        for (auto &byte : needle)
+            byte = random() % 4;
+        needles.push_back(needle);
+    }
+
+    hex::AhoCorasick automaton(needles);
+
+    std::vector<std::pair<size_t, u32>> expected;
+    for (size_t end = 0; end < data.size(); end++) {
+        for (u32 needle = 0; needle < needles.size(); needle++) {
+            const auto &bytes = needles[needle];
+            const auto first = std::find(needles.begin(), needles.end(), bytes) - needles.begin();
+
+            if (first == needle && bytes.size() <= end + 1 && std::equal(bytes.begin(), bytes.end(), data.begin() + (end + 1 - bytes.size())))
+                expected.emplace_back(end, needle);
+        }
+    }
+
+    // Feed the data in uneven pieces to make sure matches across the ends of buffers are found
+    std::vector<std::pair<size_t, u32>> found;
+    auto state = hex::AhoCorasick::Root;
+    for (size_t offset = 0; offset < data.size(); offset += 97) {
+        const auto size = std::min<size_t>(97, data.size() - offset);
+        state = automaton.search(state, data.data() + offset, size, [&](u32 needle, size_t end) {
+            found.emplace_back(offset + end, needle);
+        });
+    }
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    TEST_ASSERT(found == expected);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("MaskedPattern") {
+    std::mt19937 random(2468);
+
+    std::vector<u8> data(4096);
+    for (auto &byte : data)
+        byte = random() % 3 == 0 ? 0x48 : random() % 4;
+
+    // Patterns with a literal anchor, with only partially masked bytes and with nothing but wildcards
+    const std::vector<std::vector<hex::MaskedPattern::Byte>> patterns = {
+        { { 0xFF, 0x48 }, { 0xFF, 0x01 }, { 0x00, 0x00 }, { 0x00, 0x00 }, { 0xFF, 0x02 } },
+        { { 0xFF, 0x48 }, { 0x00, 0x00 }, { 0xFF, 0x48 } },
+        { { 0xF0, 0x40 }, { 0x0F, 0x03 }, { 0x00, 0x00 }, { 0xF0, 0x00 } },
+        { { 0x00, 0x00 }, { 0x00, 0x00 } },
+        { { 0xFF, 0x00 } }
+    };
+
+    for (const auto &bytes : patterns) {
+        hex::MaskedPattern pattern(bytes);
+
+        std::vector<size_t> expected;
+        for (size_t offset = 0; offset + bytes.size() <= data.size(); offset++) {
+            bool matches = true;
+            for (size_t i = 0; i < bytes.size(); i++)
+                matches = matches && (data[offset + i] & bytes[i].mask) == bytes[i].value;
+
+            if (matches)
+                expected.push_back(offset);
+        }
+
+        std::vector<size_t> found;
+        pattern.search(data.data(), data.size(), [&](size_t offset) {
+            found.push_back(offset);
+        });
+
+        TEST_ASSERT(found == expected);
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("GDBProtocol") {
+    using hex::gdb::BinaryRead;
+
+    TEST_ASSERT(hex::gdb::createPacket("OK") == "$OK#9a");
+
+    // Run-length encoding repeats the previous character, the count is the character after the '*' minus 29
+    TEST_ASSERT(hex::gdb::decodePayload("0* ") == "0000");
+    TEST_ASSERT(hex::gdb::decodePayload("a*\"b") == "aaaaaab");
+    TEST_ASSERT(hex::gdb::decodePayload("*") == "*");
+
+    // Escaped characters are xored with 0x20
+    const std::string escaped = "\x7d\x03\x7d\x04\x7d\x5d\x7d\x0a";
+    TEST_ASSERT(hex::gdb::decodePayload(escaped) == "#$\x7d*");
+
+    auto bytes = [](std::string_view string) { return std::vector<u8>(string.begin(), string.end()); };
+
+    TEST_ASSERT(hex::gdb::isErrorReply("E01") && hex::gdb::isErrorReply("Eff"));
+    TEST_ASSERT(!hex::gdb::isErrorReply("E0") && !hex::gdb::isErrorReply("EXX") && !hex::gdb::isErrorReply("E012"));
+
+    // Hex replies to 'm' packets
+    TEST_ASSERT(hex::gdb::parseReadReply(BinaryRead::Unsupported, "41424344", 4) == bytes("ABCD"));
+    TEST_ASSERT(hex::gdb::parseReadReply(BinaryRead::Unsupported, "41424344", 2) == bytes("AB"));
+    TEST_ASSERT(!hex::gdb::parseReadReply(BinaryRead::Unsupported, "E14", 2).has_value());
+    TEST_ASSERT(!hex::gdb::parseReadReply(BinaryRead::Unsupported, "", 2).has_value());
+
+    // Prefixed binary replies can't be confused with errors
+    TEST_ASSERT(hex::gdb::parseReadReply(BinaryRead::Prefixed, "bE01", 3) == bytes("E01"));
+    TEST_ASSERT(hex::gdb::parseReadReply(BinaryRead::Prefixed, "bxy", 8) == bytes("xy"));
+    TEST_ASSERT(!hex::gdb::parseReadReply(BinaryRead::Prefixed, "E01", 3).has_value());
+
+    // Raw binary replies that look like an error are always reported as one, no matter how many bytes were requested
+    TEST_ASSERT(hex::gdb::parseReadReply(BinaryRead::Raw, "xyz", 3) == bytes("xyz"));
+    TEST_ASSERT(hex::gdb::parseReadReply(BinaryRead::Raw, "E01x", 8) == bytes("E01x"));
+    TEST_ASSERT(!hex::gdb::parseReadReply(BinaryRead::Raw, "E01", 3).has_value());
+    TEST_ASSERT(!hex::gdb::parseReadReply(BinaryRead::Raw, "E01", 8).has_value());
+    TEST_ASSERT(!hex::gdb::parseReadReply(BinaryRead::Raw, "", 8).has_value());
+
+    TEST_SUCCESS();
+};
+
+namespace {
+
+    struct FoundString {
+        u64 address;
+        size_t size;
+        bool multibyte;
+
+        bool operator==(const FoundString &) const = default;
+    };
+
+    // Classifies the data in blocks and feeds all of them to the scanner, the last one might not be a full block
+    template<typename Feed>
+    void feedBlocks(const std::vector<u8> &data, const hex::ByteClass &characters, Feed &&feed) {
+        for (size_t offset = 0; offset < data.size(); offset += hex::ByteClass::BlockSize) {
+            const auto size = std::min<size_t>(hex::ByteClass::BlockSize, data.size() - offset);
+
+            u64 members, zeros;
+            characters.classify(data.data() + offset, size, members, zeros);
+            feed(offset, size, members, zeros);
+        }
+    }
+
+    // Byte by byte version of the UnitStringScanner
+    std::vector<FoundString> findUnitStrings(const std::vector<u8> &data, const std::array<bool, 256> &characters, size_t width, size_t characterByte, size_t minLength, bool nullTermination) {
+        auto isUnit = [&](size_t address, bool null) {
+            if (address + width > data.size())
+                return false;
+
+            for (size_t i = 0; i < width; i++) {
+                const u8 byte = data[address + i];
+                if (i == characterByte && !null ? !characters[byte] : byte != 0x00)
+                    return false;
+            }
+
+            return true;
+        };
+
+        std::vector<FoundString> result;
+        for (size_t address = 0; address < data.size();) {
+            if (!isUnit(address, false)) {
+                address++;
+                continue;
+            }
+
+            size_t end = address;
+            while (isUnit(end, false))
+                end += width;
+
+            const size_t length = (end - address) / width;
+            if ((!nullTermination || isUnit(end, true)) && length >= minLength)
+                result.push_back({ address, end - address, false });
+
+            address = end;
+        }
+
+        return result;
+    }
+
+    // Byte by byte version of the UTF8StringScanner
+    std::vector<FoundString> findUTF8Strings(const std::vector<u8> &data, const std::array<bool, 256> &characters, size_t minLength, bool nullTermination) {
+        // Length of the valid sequence starting at the given address, zero if it's broken and nothing if it runs past the end of the data
+        auto sequenceLength = [&](size_t address) -> std::optional<size_t> {
+            const u8 lead = data[address];
+            const size_t length = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : 2;
+
+            u8 lowerBound = 0x80, upperBound = 0xBF;
+            switch (lead) {
+                case 0xE0: lowerBound = 0xA0; break;
+                case 0xED: upperBound = 0x9F; break;
+                case 0xF0: lowerBound = 0x90; break;
+                case 0xF4: upperBound = 0x8F; break;
+                default: break;
+            }
+
+            for (size_t i = 1; i < length; i++) {
+                if (address + i >= data.size())
+                    return std::nullopt;
+
+                const u8 byte = data[address + i];
+                if (byte < (i == 1 ? lowerBound : 0x80) || byte > (i == 1 ? upperBound : 0xBF))
+                    return 0;
+            }
+
+            return length;
+        };
+
+        auto isLead = [](u8 byte) { return byte >= 0xC2 && byte <= 0xF4; };
+
+        std::vector<FoundString> result;
+        for (size_t address = 0; address < data.size();) {
+            if (!characters[data[address]] && !isLead(data[address])) {
+                address++;
+                continue;
+            }
+
+            const size_t start = address;
+            size_t characterCount = 0;
+            bool multibyte = false, terminated = !nullTermination;
+            while (address < data.size()) {
+                const u8 byte = data[address];
+                if (characters[byte]) {
+                    characterCount++;
+                    address++;
+                } else if (isLead(byte)) {
+                    const auto length = sequenceLength(address);
+                    if (length.has_value() && *length > 0) {
+                        characterCount++;
+                        multibyte = true;
+                        address += *length;
+                        continue;
+                    }
+
+                    // Broken and cut off sequences end the string right before their lead byte
+                    const size_t end = address;
+                    address = length.has_value() ? address + 1 : data.size();
+                    if (terminated && characterCount > 0 && characterCount >= minLength)
+                        result.push_back({ start, end - start, multibyte });
+                    characterCount = 0;
+                    break;
+                } else {
+                    terminated = terminated || byte == 0x00;
+                    break;
+                }
+            }
+
+            if (characterCount > 0 && terminated && characterCount >= minLength)
+                result.push_back({ start, address - start, multibyte });
+        }
+
+        return result;
+    }
+
+    // Data made up of runs of characters in all encodings, broken and overlong UTF-8 sequences, zeros and noise
+    std::vector<u8> generateStringData(std::mt19937 &random) {
+        std::vector<u8> data;
+
+        const auto size = std::uniform_int_distribution<size_t>(0, 700)(random);
+        auto letter = [&] { return u8(std::uniform_int_distribution<u32>('a', 'z')(random)); };
+        auto count  = [&] { return std::uniform_int_distribution<size_t>(0, 12)(random); };
+
+        while (data.size() < size) {
+            switch (random() % 9) {
+                case 0:
+                    for (size_t i = count(); i > 0; i--) data.push_back(letter());
+                    break;
+                case 1:
+                    for (size_t i = count(); i > 0; i--) data.insert(data.end(), { letter(), 0x00 });
+                    break;
+                case 2:
+                    for (size_t i = count(); i > 0; i--) data.insert(data.end(), { 0x00, letter() });
+                    break;
+                case 3:
+                    for (size_t i = count(); i > 0; i--) data.insert(data.end(), { letter(), 0x00, 0x00, 0x00 });
+                    break;
+                case 4:
+                    for (size_t i = count(); i > 0; i--) data.insert(data.end(), { 0x00, 0x00, 0x00, letter() });
+                    break;
+                case 5: {
+                    // Valid multibyte sequences
+                    const std::array<std::vector<u8>, 4> sequences = { std::vector<u8> { 0xC3, 0xA4 }, { 0xE2, 0x82, 0xAC }, { 0xF0, 0x9F, 0x98, 0x80 }, { 0xF4, 0x8F, 0xBF, 0xBF } };
+                    for (size_t i = count(); i > 0; i--) {
+                        const auto &sequence = sequences[random() % sequences.size()];
+                        data.insert(data.end(), sequence.begin(), sequence.end());
+                        data.push_back(letter());
+                    }
+                    break;
+                }
+                case 6: {
+                    // Overlong, surrogate, out of range and truncated sequences as well as invalid lead bytes
+                    const std::array<std::vector<u8>, 7> sequences = { std::vector<u8> { 0xC0, 0xAF }, { 0xE0, 0x80, 0xAF }, { 0xED, 0xA0, 0x80 }, { 0xF0, 0x80, 0x80, 0xAF }, { 0xF4, 0x90, 0x80, 0x80 }, { 0xE2, 0x82 }, { 0xF0, 0x9F, 0x98 } };
+                    const auto &sequence = sequences[random() % sequences.size()];
+                    data.insert(data.end(), sequence.begin(), sequence.end());
+                    break;
+                }
+                case 7:
+                    data.insert(data.end(), count() % 5, 0x00);
+                    break;
+                default:
+                    for (size_t i = count(); i > 0; i--) data.push_back(random());
+                    break;
+            }
+        }
+
+        data.resize(size);
+        return data;
+    }
+
+}
+
+TEST_SEQUENCE("UnitStringScanner") {
+    std::mt19937 random(1234);
+
+    std::array<bool, 256> table = { };
+    for (u32 byte = 0; byte < 256; byte++)
+        table[byte] = std::isalnum(byte) || byte == ' ';
+    const hex::ByteClass characters(table);
+
+    for (u32 iteration = 0; iteration < 500; iteration++) {
+        auto data = generateStringData(random);
+
+        // Strings that end right at the end of the data
+        if (iteration % 4 == 0)
+            data.insert(data.end(), { 'a', 0x00, 'b', 0x00, 'c', 0x00, 0x00, 0x00, 'd' });
+
+        for (size_t width : { 1, 2, 4 }) {
+            for (size_t characterByte : { size_t(0), width - 1 }) {
+                for (bool nullTermination : { false, true }) {
+                    for (size_t minLength : { 1, 3 }) {
+                        std::vector<FoundString> found;
+                        hex::UnitStringScanner scanner(width, characterByte, minLength, nullTermination);
+                        auto addResult = [&](hex::Region region) { found.push_back({ region.getStartAddress(), region.getSize(), false }); };
+
+                        feedBlocks(data, characters, [&](u64 address, size_t size, u64 members, u64 zeros) {
+                            scanner.feed(address, size, members, zeros, addResult);
+                        });
+                        scanner.flush(addResult);
+
+                        TEST_ASSERT(found == findUnitStrings(data, table, width, characterByte, minLength, nullTermination), "iteration {}, width {}, character byte {}", iteration, width, characterByte);
+                    }
+                }
+            }
+        }
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("UTF8StringScanner") {
+    std::mt19937 random(5678);
+
+    std::array<bool, 256> table = { }, leadTable = { };
+    for (u32 byte = 0; byte < 256; byte++)
+        table[byte] = std::isalnum(byte) || byte == ' ';
+    std::fill(leadTable.begin() + 0xC2, leadTable.begin() + 0xF5, true);
+    const hex::ByteClass characters(table), leads(leadTable);
+
+    for (u32 iteration = 0; iteration < 2000; iteration++) {
+        auto data = generateStringData(random);
+
+        // Strings that end at the end of the data, with and without a cut off sequence
+        if (iteration % 4 == 0)
+            data.insert(data.end(), { 'a', 0xC3, 0xA4, 'b' });
+        else if (iteration % 4 == 1)
+            data.insert(data.end(), { 'a', 'b', 'c', 0xF0, 0x9F });
+
+        for (bool nullTermination : { false, true }) {
+            for (size_t minLength : { 1, 3 }) {
+                std::vector<FoundString> found;
+                hex::UTF8StringScanner scanner(minLength, nullTermination);
+                auto addResult = [&](hex::Region region, bool multibyte) { found.push_back({ region.getStartAddress(), region.getSize(), multibyte }); };
+
+                for (size_t offset = 0; offset < data.size(); offset += hex::ByteClass::BlockSize) {
+                    const auto size = std::min<size_t>(hex::ByteClass::BlockSize, data.size() - offset);
+
+                    u64 members, zeros, leadBytes, unused;
+                    characters.classify(data.data() + offset, size, members, zeros);
+                    leads.classify(data.data() + offset, size, leadBytes, unused);
+                    scanner.feed(data.data() + offset, offset, size, members, zeros, leadBytes, addResult);
+                }
+                scanner.flush(addResult);
+
+                TEST_ASSERT(found == findUTF8Strings(data, table, minLength, nullTermination), "iteration {}", iteration);
+            }
+        }
+    }
+
+    TEST_SUCCESS();
+};
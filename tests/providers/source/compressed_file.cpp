@@ -0,0 +1,256 @@
+#include <hex/test/tests.hpp>
+
+#include <hex/helpers/file.hpp>
+#include <hex/helpers/fs.hpp>
+#include <hex/helpers/literals.hpp>
+#include <hex/helpers/utils.hpp>
+
+#include "content/providers/compressed_file_provider.hpp"
+
+#include <nlohmann/json.hpp>
+
+#if defined(IMHEX_ZLIB_SUPPORT)
+    #include <zlib.h>
+#endif
+
+#if defined(IMHEX_LZMA_SUPPORT)
+    #include <lzma.h>
+#endif
+
+#if defined(IMHEX_ZSTD_SUPPORT)
+    #include <zstd.h>
+#endif
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace hex::literals;
+
+namespace {
+
+    class TestCompressedFileProvider : public hex::plugin::builtin::prv::CompressedFileProvider {
+    public:
+        explicit TestCompressedFileProvider(const std::fs::path &path) {
+            this->loadSettings({ { "path", hex::toUTF8String(path) }, { "baseAddress", 0 }, { "currPage", 0 } });
+        }
+
+        void waitForIndex() const {
+            while (!this->m_indexComplete)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        [[nodiscard]] bool isIndexComplete() const { return this->m_indexComplete; }
+        [[nodiscard]] size_t getCheckpointCount() const { return this->m_checkpoints.size(); }
+        [[nodiscard]] std::fs::path getIndexFilePath() const { return this->getIndexPath(); }
+    };
+
+    // Random words so the data compresses somewhat but doesn't repeat
+    std::vector<u8> generateData(size_t size) {
+        std::mt19937 random(size);
+        std::uniform_int_distribution<u32> length(1, 12), letter('a', 'z');
+
+        std::vector<u8> data;
+        data.reserve(size);
+        while (data.size() < size) {
+            for (u32 i = length(random); i > 0 && data.size() < size; i--)
+                data.push_back(letter(random));
+            if (data.size() < size)
+                data.push_back(' ');
+        }
+
+        return data;
+    }
+
+    std::fs::path writeArchive(const std::string &name, const std::vector<u8> &compressed) {
+        auto path = std::fs::temp_directory_path() / name;
+
+        hex::fs::File file(path, hex::fs::File::Mode::Create);
+        file.write(compressed);
+
+        return path;
+    }
+
+    // Opens the archive twice, first building the index and then loading the one that was stored, and compares some reads against the original data
+    bool checkRoundTrip(const std::fs::path &path, const std::vector<u8> &data, size_t minCheckpoints) {
+        std::vector<std::pair<u64, size_t>> ranges = { { 0, 4_KiB }, { data.size() / 2 - 100, 200 }, { data.size() - 1_KiB, 1_KiB } };
+
+        std::mt19937 random(data.size());
+        for (u32 i = 0; i < 8; i++) {
+            const u64 offset = std::uniform_int_distribution<u64>(0, data.size() - 1)(random);
+            ranges.emplace_back(offset, std::min<u64>(64_KiB, data.size() - offset));
+        }
+
+        std::fs::path indexPath;
+        for (u32 pass = 0; pass < 2; pass++) {
+            TestCompressedFileProvider provider(path);
+            if (!provider.open())
+                return false;
+
+            // The second pass has to find the index stored by the first one, so it's complete right away
+            if (pass == 1 && !indexPath.empty() && !provider.isIndexComplete())
+                return false;
+
+            provider.waitForIndex();
+            if (provider.getActualSize() != data.size() || provider.getCheckpointCount() < minCheckpoints)
+                return false;
+
+            for (const auto &[offset, size] : ranges) {
+                std::vector<u8> buffer(size, 0xCC);
+                provider.readRaw(offset, buffer.data(), buffer.size());
+
+                if (!std::equal(buffer.begin(), buffer.end(), data.begin() + offset))
+                    return false;
+            }
+
+            // Reading everything front to back continues with the decoders the previous reads left behind
+            std::vector<u8> buffer(data.size(), 0xCC);
+            for (u64 offset = 0; offset < data.size(); offset += 64_KiB)
+                provider.readRaw(offset, buffer.data() + offset, std::min<u64>(64_KiB, data.size() - offset));
+            if (buffer != data)
+                return false;
+
+            indexPath = provider.getIndexFilePath();
+            provider.close();
+        }
+
+        // Indices are stored in little endian no matter which machine created them
+        if (!indexPath.empty()) {
+            hex::fs::File file(indexPath, hex::fs::File::Mode::Read);
+            const auto header = file.readBytes(12);
+            if (header.size() != 12 || std::string(header.begin(), header.begin() + 8) != "IHEXCIDX" || header[8] != 0x02 || header[9] != 0x00 || header[10] != 0x00 || header[11] != 0x00)
+                return false;
+
+            hex::fs::remove(indexPath);
+        }
+
+        return true;
+    }
+
+}
+
+#if defined(IMHEX_ZLIB_SUPPORT)
+
+    TEST_SEQUENCE("CompressedFileGZip") {
+        // Large enough for a second checkpoint. Split into two gzip members to check that the provider continues with the next one
+        const auto data = generateData(20_MiB);
+
+        std::vector<u8> compressed;
+        for (const auto &[offset, size] : { std::pair<size_t, size_t> { 0, 3_MiB }, std::pair<size_t, size_t> { 3_MiB, data.size() - 3_MiB } }) {
+            z_stream stream = { };
+            TEST_ASSERT(deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+
+            std::vector<u8> member(deflateBound(&stream, size));
+            stream.next_in   = const_cast<u8 *>(data.data() + offset);
+            stream.avail_in  = size;
+            stream.next_out  = member.data();
+            stream.avail_out = member.size();
+            TEST_ASSERT(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+
+            member.resize(stream.total_out);
+            deflateEnd(&stream);
+
+            compressed.insert(compressed.end(), member.begin(), member.end());
+        }
+
+        const auto path = writeArchive("imhex_compressed_file_test.gz", compressed);
+        ON_SCOPE_EXIT { hex::fs::remove(path); };
+
+        TEST_ASSERT(checkRoundTrip(path, data, 2));
+
+        TEST_SUCCESS();
+    };
+
+#endif
+
+#if defined(IMHEX_LZMA_SUPPORT)
+
+    TEST_SEQUENCE("CompressedFileXZ") {
+        const auto data = generateData(4_MiB);
+
+        // Two streams with multiple blocks each, followed by stream padding
+        std::vector<u8> compressed;
+        for (const auto &[offset, size] : { std::pair<size_t, size_t> { 0, 1_MiB }, std::pair<size_t, size_t> { 1_MiB, data.size() - 1_MiB } }) {
+            lzma_mt options = { };
+            options.threads    = 1;
+            options.block_size = 256_KiB;
+            options.preset     = 0;
+            options.check      = LZMA_CHECK_CRC64;
+
+            lzma_stream stream = LZMA_STREAM_INIT;
+            TEST_ASSERT(lzma_stream_encoder_mt(&stream, &options) == LZMA_OK);
+
+            std::vector<u8> output(lzma_stream_buffer_bound(size));
+            stream.next_in   = data.data() + offset;
+            stream.avail_in  = size;
+            stream.next_out  = output.data();
+            stream.avail_out = output.size();
+            TEST_ASSERT(lzma_code(&stream, LZMA_FINISH) == LZMA_STREAM_END);
+
+            output.resize(stream.total_out);
+            lzma_end(&stream);
+
+            compressed.insert(compressed.end(), output.begin(), output.end());
+        }
+        compressed.insert(compressed.end(), 4, 0x00);
+
+        const auto path = writeArchive("imhex_compressed_file_test.xz", compressed);
+        ON_SCOPE_EXIT { hex::fs::remove(path); };
+
+        TEST_ASSERT(checkRoundTrip(path, data, 16));
+
+        // Blocks that can't be decompressed read as zeros and aren't cached, so they're read again once the file is fine again
+        {
+            TestCompressedFileProvider provider(path);
+            TEST_ASSERT(provider.open());
+            ON_SCOPE_EXIT {
+                provider.close();
+                hex::fs::remove(provider.getIndexFilePath());
+            };
+
+            auto corrupted = compressed;
+            std::fill(corrupted.begin() + corrupted.size() / 2, corrupted.end(), 0x00);
+            writeArchive("imhex_compressed_file_test.xz", corrupted);
+
+            std::vector<u8> buffer(data.size(), 0xCC);
+            provider.readRaw(0, buffer.data(), buffer.size());
+            TEST_ASSERT(std::equal(buffer.begin(), buffer.begin() + 256_KiB, data.begin()));
+            TEST_ASSERT(std::all_of(buffer.end() - 256_KiB, buffer.end(), [](u8 byte) { return byte == 0x00; }));
+
+            writeArchive("imhex_compressed_file_test.xz", compressed);
+            provider.readRaw(0, buffer.data(), buffer.size());
+            TEST_ASSERT(buffer == data);
+        }
+
+        TEST_SUCCESS();
+    };
+
+#endif
+
+#if defined(IMHEX_ZSTD_SUPPORT)
+
+    TEST_SEQUENCE("CompressedFileZStd") {
+        const auto data = generateData(4_MiB);
+
+        // Independent frames that each store their decompressed size
+        std::vector<u8> compressed;
+        for (size_t offset = 0; offset < data.size(); offset += 512_KiB) {
+            const auto size = std::min<size_t>(512_KiB, data.size() - offset);
+
+            std::vector<u8> frame(ZSTD_compressBound(size));
+            const auto frameSize = ZSTD_compress(frame.data(), frame.size(), data.data() + offset, size, 1);
+            TEST_ASSERT(!ZSTD_isError(frameSize));
+
+            compressed.insert(compressed.end(), frame.begin(), frame.begin() + frameSize);
+        }
+
+        const auto path = writeArchive("imhex_compressed_file_test.zst", compressed);
+        ON_SCOPE_EXIT { hex::fs::remove(path); };
+
+        TEST_ASSERT(checkRoundTrip(path, data, 8));
+
+        TEST_SUCCESS();
+    };
+
+#endif